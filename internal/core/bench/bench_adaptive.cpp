@@ -0,0 +1,125 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+constexpr int64_t dim = 64;
+constexpr int64_t num_rows = 200000;
+constexpr int64_t num_queries = 1000;
+constexpr int64_t num_centers = 1024;
+constexpr int64_t nlist = 1024;
+constexpr int64_t topk = 10;
+
+// points around gaussian centers with zipf weights, so a few clusters hold most of the rows,
+// and queries drawn the same way
+const std::vector<float>&
+raw_data() {
+    static std::vector<float> data = [] {
+        std::mt19937 rng(42);
+        std::normal_distribution<float> dist;
+        std::vector<float> centers(num_centers * dim);
+        for (auto& x : centers) {
+            x = 4 * dist(rng);
+        }
+        std::vector<double> weights(num_centers);
+        for (int64_t i = 0; i < num_centers; ++i) {
+            weights[i] = 1.0 / (i + 1);
+        }
+        std::discrete_distribution<int64_t> zipf(weights.begin(), weights.end());
+        std::vector<float> data((num_rows + num_queries) * dim);
+        for (int64_t i = 0; i < num_rows + num_queries; ++i) {
+            auto center = centers.data() + zipf(rng) * dim;
+            for (int64_t j = 0; j < dim; ++j) {
+                data[i * dim + j] = center[j] + dist(rng);
+            }
+        }
+        return data;
+    }();
+    return data;
+}
+
+const float*
+queries() {
+    return raw_data().data() + num_rows * dim;
+}
+
+const std::vector<int64_t>&
+ground_truth() {
+    static std::vector<int64_t> labels = [] {
+        faiss::IndexFlatL2 flat(dim);
+        flat.add(num_rows, raw_data().data());
+        std::vector<float> distances(num_queries * topk);
+        std::vector<int64_t> labels(num_queries * topk);
+        flat.search(num_queries, queries(), topk, distances.data(), labels.data());
+        return labels;
+    }();
+    return labels;
+}
+
+faiss::IndexIVFFlat&
+ivf_index() {
+    static faiss::IndexFlatL2 quantizer(dim);
+    static auto index = [] {
+        auto index = std::make_unique<faiss::IndexIVFFlat>(&quantizer, dim, nlist, faiss::METRIC_L2);
+        index->train(num_rows, raw_data().data());
+        index->add(num_rows, raw_data().data());
+        index->compute_list_radii();
+        return index;
+    }();
+    return *index;
+}
+}  // namespace
+
+// range(0): nprobe cap. range(1): 0 fixed nprobe, 1 adaptive_bound, 2 adaptive_bound and adaptive_patience 8.
+// One query at a time, as the adaptive termination works per query.
+static void
+BN_IVF_Adaptive(benchmark::State& state) {
+    auto& index = ivf_index();
+    ground_truth();
+    index.nprobe = state.range(0);
+    index.adaptive_bound = state.range(1) > 0;
+    index.adaptive_patience = state.range(1) > 1 ? 8 : 0;
+
+    std::vector<float> distances(num_queries * topk);
+    std::vector<int64_t> labels(num_queries * topk);
+    for (auto _ : state) {
+        for (int64_t q = 0; q < num_queries; ++q) {
+            index.search(1, queries() + q * dim, topk, distances.data() + q * topk, labels.data() + q * topk);
+        }
+    }
+    index.adaptive_bound = false;
+    index.adaptive_patience = 0;
+
+    int64_t hits = 0;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::set<int64_t> truth(ground_truth().begin() + q * topk, ground_truth().begin() + (q + 1) * topk);
+        for (int64_t i = 0; i < topk; ++i) {
+            hits += truth.count(labels[q * topk + i]);
+        }
+    }
+    state.counters["recall"] = static_cast<double>(hits) / (num_queries * topk);
+}
+BENCHMARK(BN_IVF_Adaptive)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+        for (int64_t nprobe : {16, 64}) {
+            for (int64_t mode = 0; mode < 3; ++mode) {
+                bench->Args({nprobe, mode});
+            }
+        }
+    })
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cache/Cache.h"
+#include "cache/DataObj.h"
+
+using namespace milvus::cache;
+
+namespace {
+class BenchItem : public DataObj {
+ public:
+    int64_t
+    Size() override {
+        return 1024;
+    }
+};
+
+constexpr int64_t num_keys = 10000;
+
+const std::vector<std::string>&
+keys() {
+    static std::vector<std::string> keys = [] {
+        std::vector<std::string> keys;
+        for (int64_t i = 0; i < num_keys; ++i) {
+            keys.push_back("segment_" + std::to_string(i) + "_field_101");
+        }
+        return keys;
+    }();
+    return keys;
+}
+
+// all keys fit, the benchmark measures lookup contention only
+std::unique_ptr<Cache<DataObjPtr>>
+make_cache(CachePolicyType policy, int64_t num_shards) {
+    auto cache = std::make_unique<Cache<DataObjPtr>>(1L << 32, num_keys * 2, "[BENCH]", policy, num_shards);
+    for (auto& key : keys()) {
+        cache->insert(key, std::make_shared<BenchItem>());
+    }
+    return cache;
+}
+
+std::unique_ptr<Cache<DataObjPtr>> cache;
+}  // namespace
+
+// range(0): policy, range(1): number of shards. one shard with LRU is the old single mutex cache.
+static void
+BN_Cache_Get(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        cache = make_cache(static_cast<CachePolicyType>(state.range(0)), state.range(1));
+    }
+    std::mt19937_64 rng(state.thread_index);
+    std::uniform_int_distribution<int64_t> dist(0, num_keys - 1);
+    auto& all_keys = keys();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache->get(all_keys[dist(rng)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index == 0) {
+        cache.reset();
+    }
+}
+BENCHMARK(BN_Cache_Get)
+    ->Args({(int64_t)CachePolicyType::LRU, 1})
+    ->Args({(int64_t)CachePolicyType::LRU, DEFAULT_CACHE_SHARDS})
+    ->Args({(int64_t)CachePolicyType::CLOCK, DEFAULT_CACHE_SHARDS})
+    ->Args({(int64_t)CachePolicyType::TINY_LFU, DEFAULT_CACHE_SHARDS})
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
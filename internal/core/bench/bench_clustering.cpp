@@ -0,0 +1,131 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <faiss/Clustering.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+constexpr int64_t dim = 64;
+constexpr int64_t num_rows = 200000;
+constexpr int64_t num_queries = 100;
+constexpr int64_t num_centers = 4096;
+constexpr int64_t topk = 10;
+constexpr int64_t nprobe = 16;
+
+// points around num_centers gaussian centers, and queries are noisy rows
+const std::vector<float>&
+raw_data() {
+    static std::vector<float> data = [] {
+        std::mt19937 rng(42);
+        std::normal_distribution<float> dist;
+        std::vector<float> centers(num_centers * dim);
+        for (auto& x : centers) {
+            x = 2 * dist(rng);
+        }
+        std::vector<float> data((num_rows + num_queries) * dim);
+        for (int64_t i = 0; i < num_rows + num_queries; ++i) {
+            auto center = centers.data() + (rng() % num_centers) * dim;
+            for (int64_t j = 0; j < dim; ++j) {
+                data[i * dim + j] = center[j] + dist(rng);
+            }
+        }
+        return data;
+    }();
+    return data;
+}
+
+const float*
+queries() {
+    return raw_data().data() + num_rows * dim;
+}
+
+const std::vector<int64_t>&
+ground_truth() {
+    static std::vector<int64_t> labels = [] {
+        faiss::IndexFlatL2 flat(dim);
+        flat.add(num_rows, raw_data().data());
+        std::vector<float> distances(num_queries * topk);
+        std::vector<int64_t> labels(num_queries * topk);
+        flat.search(num_queries, queries(), topk, distances.data(), labels.data());
+        return labels;
+    }();
+    return labels;
+}
+
+double
+recall(const faiss::IndexIVFFlat& index) {
+    std::vector<float> distances(num_queries * topk);
+    std::vector<int64_t> labels(num_queries * topk);
+    index.search(num_queries, queries(), topk, distances.data(), labels.data());
+    int64_t hits = 0;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::set<int64_t> truth(ground_truth().begin() + q * topk, ground_truth().begin() + (q + 1) * topk);
+        for (int64_t i = 0; i < topk; ++i) {
+            hits += truth.count(labels[q * topk + i]);
+        }
+    }
+    return static_cast<double>(hits) / (num_queries * topk);
+}
+}  // namespace
+
+// range(0): nlist. range(1): 0 Lloyd with IndexFlat assignment, 1 Lloyd with the pruned sgemm assignment,
+// 2 k-means|| seeding and mini-batches of 16 * nlist points. The training time is the IVF train time,
+// recall is recall@10 of the IVF_FLAT index at nprobe 16.
+static void
+BN_IVF_Train(benchmark::State& state) {
+    auto nlist = state.range(0);
+    auto mode = state.range(1);
+    ground_truth();
+
+    double obj = 0, rec = 0;
+    for (auto _ : state) {
+        faiss::IndexFlatL2 quantizer(dim);
+        faiss::IndexIVFFlat index(&quantizer, dim, nlist, faiss::METRIC_L2);
+        index.cp.prune_assign = mode > 0;
+        if (mode == 2) {
+            faiss::clustering_type = faiss::ClusteringType::K_MEANS_PARALLEL;
+            faiss::kmeans_mini_batch_size = 16 * nlist;
+        }
+        index.train(num_rows, raw_data().data());
+        faiss::clustering_type = faiss::ClusteringType::K_MEANS;
+        faiss::kmeans_mini_batch_size = 0;
+
+        state.PauseTiming();
+        index.add(num_rows, raw_data().data());
+        index.nprobe = nprobe;
+        rec = recall(index);
+        std::vector<float> distances(num_rows);
+        std::vector<int64_t> labels(num_rows);
+        quantizer.search(num_rows, raw_data().data(), 1, distances.data(), labels.data());
+        obj = 0;
+        for (auto d : distances) {
+            obj += d;
+        }
+        state.ResumeTiming();
+    }
+    state.counters["recall"] = rec;
+    state.counters["objective"] = obj / num_rows;
+}
+BENCHMARK(BN_IVF_Train)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+        for (int64_t nlist : {1024, 4096}) {
+            for (int64_t mode = 0; mode < 3; ++mode) {
+                bench->Args({nlist, mode});
+            }
+        }
+    })
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,149 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <faiss/IndexFlat.h>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+using namespace milvus;
+
+namespace {
+constexpr int64_t dim = 128;
+constexpr int64_t num_rows = 200000;
+constexpr int64_t num_queries = 64;
+constexpr int64_t topk = 10;
+
+const std::vector<float>&
+raw_data() {
+    static std::vector<float> data = [] {
+        std::vector<float> data(dim * num_rows);
+        std::mt19937 rng(42);
+        std::normal_distribution<float> dist;
+        for (auto& x : data) {
+            x = dist(rng);
+        }
+        return data;
+    }();
+    return data;
+}
+
+// queries are rows with some noise, so the true neighbours are not just the row itself
+const std::vector<float>&
+queries() {
+    static std::vector<float> data = [] {
+        std::vector<float> data(raw_data().begin(), raw_data().begin() + dim * num_queries);
+        std::mt19937 rng(7);
+        std::normal_distribution<float> dist(0, 0.5);
+        for (auto& x : data) {
+            x += dist(rng);
+        }
+        return data;
+    }();
+    return data;
+}
+
+const std::vector<int64_t>&
+ground_truth() {
+    static std::vector<int64_t> labels = [] {
+        faiss::IndexFlatL2 flat(dim);
+        flat.add(num_rows, raw_data().data());
+        std::vector<float> distances(num_queries * topk);
+        std::vector<int64_t> labels(num_queries * topk);
+        flat.search(num_queries, queries().data(), topk, distances.data(), labels.data());
+        return labels;
+    }();
+    return labels;
+}
+
+// both layouts take 16 bytes per vector
+struct Setup {
+    const char* index_type;
+    int64_t m;
+    int64_t nbits;
+};
+
+const Setup setups[] = {{knowhere::IndexEnum::INDEX_FAISS_IVFPQ, 16, 8},
+                        {knowhere::IndexEnum::INDEX_FAISS_IVFPQ, 32, 4},
+                        {knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, 32, 4}};
+
+knowhere::Config
+make_config(const Setup& setup, int64_t nprobe) {
+    return knowhere::Config{{knowhere::meta::DIM, dim},
+                            {knowhere::meta::TOPK, topk},
+                            {knowhere::IndexParams::nlist, 1024},
+                            {knowhere::IndexParams::nprobe, nprobe},
+                            {knowhere::IndexParams::m, setup.m},
+                            {knowhere::IndexParams::nbits, setup.nbits},
+                            {knowhere::Metric::TYPE, knowhere::Metric::L2}};
+}
+
+knowhere::VecIndexPtr
+built_index(int64_t setup_id) {
+    static std::map<int64_t, knowhere::VecIndexPtr> indexes;
+    auto iter = indexes.find(setup_id);
+    if (iter != indexes.end()) {
+        return iter->second;
+    }
+    auto& setup = setups[setup_id];
+    auto index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(setup.index_type);
+    auto conf = make_config(setup, 1);
+    auto dataset = knowhere::GenDataset(num_rows, dim, raw_data().data());
+    index->Train(dataset, conf);
+    index->AddWithoutIds(dataset, conf);
+    return indexes[setup_id] = index;
+}
+}  // namespace
+
+// range(0): IVF_PQ m16 x 8 bits, IVF_PQ m32 x 4 bits, IVF_PQ_FASTSCAN m32 x 4 bits. range(1): nprobe.
+// recall is recall@10 against brute force, the fast scan recall equals the 4-bit IVF_PQ one.
+static void
+BN_IVFPQ_FastScan_Search(benchmark::State& state) {
+    auto& setup = setups[state.range(0)];
+    auto index = built_index(state.range(0));
+    auto conf = make_config(setup, state.range(1));
+    auto query = knowhere::GenDataset(num_queries, dim, queries().data());
+
+    double recall = 0;
+    for (auto _ : state) {
+        auto result = index->Query(query, conf, nullptr);
+        auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        state.PauseTiming();
+        int64_t hits = 0;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            std::set<int64_t> truth(ground_truth().begin() + q * topk, ground_truth().begin() + (q + 1) * topk);
+            for (int64_t i = 0; i < topk; ++i) {
+                hits += truth.count(ids[q * topk + i]);
+            }
+        }
+        recall = static_cast<double>(hits) / (num_queries * topk);
+        free(ids);
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+    state.counters["recall"] = recall;
+}
+BENCHMARK(BN_IVFPQ_FastScan_Search)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+        for (int64_t setup = 0; setup < 3; ++setup) {
+            bench->Args({setup, 16});
+            bench->Args({setup, 64});
+        }
+    })
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,128 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <faiss/IndexIVF.h>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "knowhere/index/vector_index/IndexIVF.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
+
+using namespace milvus;
+
+namespace {
+constexpr int64_t dim = 128;
+constexpr int64_t num_rows = 200000;
+
+const std::vector<float>&
+raw_data() {
+    static std::vector<float> data = [] {
+        std::vector<float> data(dim * num_rows);
+        std::mt19937 rng(42);
+        std::normal_distribution<float> dist;
+        for (auto& x : data) {
+            x = dist(rng);
+        }
+        return data;
+    }();
+    return data;
+}
+
+knowhere::Config
+make_config() {
+    return knowhere::Config{{knowhere::meta::DIM, dim},
+                            {knowhere::meta::TOPK, 10},
+                            {knowhere::IndexParams::nlist, 1024},
+                            {knowhere::IndexParams::nprobe, 16},
+                            {knowhere::Metric::TYPE, knowhere::Metric::L2}};
+}
+
+// IVF_FLAT with the vectors in the lists, IVF_SQ8, and IVF_NM (what the factory builds for IVF_FLAT)
+knowhere::VecIndexPtr
+create_index(int64_t type) {
+    auto& factory = knowhere::VecIndexFactory::GetInstance();
+    switch (type) {
+        case 0:
+            return std::make_shared<knowhere::IVF>();
+        case 1:
+            return factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFSQ8);
+        default:
+            return factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFFLAT);
+    }
+}
+
+knowhere::VecIndexPtr
+built_index(int64_t type) {
+    static std::map<int64_t, knowhere::VecIndexPtr> indexes;
+    auto iter = indexes.find(type);
+    if (iter != indexes.end()) {
+        return iter->second;
+    }
+    auto index = create_index(type);
+    auto conf = make_config();
+    auto dataset = knowhere::GenDataset(num_rows, dim, raw_data().data());
+    index->Train(dataset, conf);
+    index->AddWithoutIds(dataset, conf);
+    if (type == 2) {
+        auto binary = index->Serialize(conf);
+        auto data = reinterpret_cast<uint8_t*>(const_cast<float*>(raw_data().data()));
+        binary.Append(RAW_DATA, std::shared_ptr<uint8_t[]>(data, [](uint8_t*) {}), dim * num_rows * sizeof(float));
+        index->Load(binary);
+    }
+    return indexes[type] = index;
+}
+
+faiss::IndexIVF*
+faiss_index(const knowhere::VecIndexPtr& index, int64_t type) {
+    if (type == 2) {
+        return dynamic_cast<faiss::IndexIVF*>(std::dynamic_pointer_cast<knowhere::IVF_NM>(index)->index_.get());
+    }
+    return dynamic_cast<faiss::IndexIVF*>(std::dynamic_pointer_cast<knowhere::IVF>(index)->index_.get());
+}
+}  // namespace
+
+// range(0): IVF_FLAT, IVF_SQ8, IVF_NM. range(1): nq. range(2): 0 query-major, 1 list-major.
+// with nlist 1024 and nprobe 16, the lists are probed by nq / 64 queries on average.
+static void
+BN_IVF_ListMajor_Search(benchmark::State& state) {
+    auto type = state.range(0);
+    auto nq = state.range(1);
+    auto index = built_index(type);
+    auto ivf_index = faiss_index(index, type);
+    auto default_ratio = ivf_index->list_major_ratio;
+    ivf_index->list_major_ratio = state.range(2) ? 0.01 : 0;
+    auto conf = make_config();
+    auto query = knowhere::GenDataset(nq, dim, raw_data().data());
+
+    for (auto _ : state) {
+        auto result = index->Query(query, conf, nullptr);
+        benchmark::DoNotOptimize(result);
+        free(result->Get<int64_t*>(knowhere::meta::IDS));
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+    }
+    ivf_index->list_major_ratio = default_ratio;
+    state.SetItemsProcessed(state.iterations() * nq);
+}
+BENCHMARK(BN_IVF_ListMajor_Search)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+        for (int64_t type = 0; type < 3; ++type) {
+            for (int64_t nq : {64, 256, 1000}) {
+                bench->Args({type, nq, 0});
+                bench->Args({type, nq, 1});
+            }
+        }
+    })
+    ->Unit(benchmark::kMillisecond);
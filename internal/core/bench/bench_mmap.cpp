@@ -0,0 +1,128 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+using namespace milvus;
+
+namespace {
+constexpr int64_t dim = 128;
+constexpr int64_t num_rows = 200000;
+constexpr int64_t num_queries = 16;
+
+const std::vector<float>&
+raw_data() {
+    static std::vector<float> data = [] {
+        std::vector<float> data(dim * num_rows);
+        std::mt19937 rng(42);
+        std::normal_distribution<float> dist;
+        for (auto& x : data) {
+            x = dist(rng);
+        }
+        return data;
+    }();
+    return data;
+}
+
+knowhere::Config
+make_config(const std::string& index_type) {
+    knowhere::Config conf{{knowhere::meta::DIM, dim},
+                          {knowhere::meta::TOPK, 10},
+                          {knowhere::IndexParams::nlist, 1024},
+                          {knowhere::IndexParams::nprobe, 16},
+                          {knowhere::Metric::TYPE, knowhere::Metric::L2}};
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFPQ) {
+        conf[knowhere::IndexParams::m] = 16;
+        conf[knowhere::IndexParams::nbits] = 8;
+    }
+    return conf;
+}
+
+// built once per index type, every run loads it again in the mode under test
+const knowhere::BinarySet&
+binary_set(const std::string& index_type) {
+    static std::map<std::string, knowhere::BinarySet> binary_sets;
+    auto iter = binary_sets.find(index_type);
+    if (iter != binary_sets.end()) {
+        return iter->second;
+    }
+    auto index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(index_type, knowhere::IndexMode::MODE_CPU);
+    auto conf = make_config(index_type);
+    auto dataset = knowhere::GenDataset(num_rows, dim, raw_data().data());
+    index->Train(dataset, conf);
+    index->AddWithoutIds(dataset, conf);
+    auto binary = index->Serialize(conf);
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFFLAT) {
+        auto data = reinterpret_cast<uint8_t*>(const_cast<float*>(raw_data().data()));
+        binary.Append(RAW_DATA, std::shared_ptr<uint8_t[]>(data, [](uint8_t*) {}), dim * num_rows * sizeof(float));
+    }
+    return binary_sets[index_type] = binary;
+}
+
+// kB of the given RssAnon or RssFile line of /proc/self/status
+double
+resident_mb(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            return std::stod(line.substr(key.size() + 1)) / 1024;
+        }
+    }
+    return 0;
+}
+
+const char* index_types[] = {knowhere::IndexEnum::INDEX_FAISS_IVFFLAT, knowhere::IndexEnum::INDEX_FAISS_IVFSQ8,
+                             knowhere::IndexEnum::INDEX_FAISS_IVFPQ};
+}  // namespace
+
+// range(0): index type, range(1): index mode, CPU or MMAP. rss is sampled after the searches, mmap moves the
+// lists from anonymous memory to file pages, which the kernel can drop and read back under memory pressure.
+static void
+BN_IVF_Search(benchmark::State& state) {
+    std::string index_type = index_types[state.range(0)];
+    auto mode = static_cast<knowhere::IndexMode>(state.range(1));
+    auto& binary = binary_set(index_type);
+    auto conf = make_config(index_type);
+    auto index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(index_type, mode);
+    index->Load(binary);
+
+    std::mt19937 rng(state.range(0));
+    std::uniform_int_distribution<int64_t> dist(0, num_rows - num_queries);
+    for (auto _ : state) {
+        auto offset = dist(rng);
+        auto query = knowhere::GenDataset(num_queries, dim, raw_data().data() + offset * dim);
+        auto result = index->Query(query, conf, nullptr);
+        benchmark::DoNotOptimize(result);
+        free(result->Get<int64_t*>(knowhere::meta::IDS));
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+    state.counters["rss_anon_mb"] = resident_mb("RssAnon:");
+    state.counters["rss_file_mb"] = resident_mb("RssFile:");
+}
+BENCHMARK(BN_IVF_Search)
+    ->Apply([](benchmark::internal::Benchmark* bench) {
+        for (int64_t type = 0; type < 3; ++type) {
+            bench->Args({type, (int64_t)knowhere::IndexMode::MODE_CPU});
+            bench->Args({type, (int64_t)knowhere::IndexMode::MODE_MMAP});
+        }
+    })
+    ->Unit(benchmark::kMicrosecond);
@@ -11,33 +11,52 @@
 
 #pragma once
 
-#include "LRU.h"
+#include "CachePolicy.h"
 #include "utils/Log.h"
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace milvus {
 namespace cache {
 
+constexpr int64_t DEFAULT_CACHE_SHARDS = 32;
+
+struct CacheStatistics {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+};
+
+// items are spread over shards by key, each shard has its own lock and eviction policy,
+// and all shards share one byte budget. lookups only take the shard lock shared when
+// the policy records accesses concurrently (CLOCK, W-TinyLFU), LRU lookups take it exclusive.
 template <typename ItemObj>
 class Cache {
  public:
     // mem_capacity, units:GB
-    Cache(int64_t capacity_gb, int64_t cache_max_count, const std::string& header = "");
+    Cache(int64_t capacity_gb,
+          int64_t cache_max_count,
+          const std::string& header = "",
+          CachePolicyType policy = CachePolicyType::LRU,
+          int64_t num_shards = DEFAULT_CACHE_SHARDS);
     ~Cache() = default;
 
     int64_t
     usage() const {
-        return usage_;
+        return usage_.load(std::memory_order_relaxed);
     }
 
     // unit: BYTE
     int64_t
     capacity() const {
-        return capacity_;
+        return capacity_.load(std::memory_order_relaxed);
     }
 
     // unit: BYTE
@@ -54,6 +73,11 @@ class Cache {
         freemem_percent_ = percent;
     }
 
+    CachePolicyType
+    policy() const {
+        return policy_type_;
+    }
+
     size_t
     size() const;
 
@@ -72,6 +96,9 @@ class Cache {
     bool
     reserve(const int64_t size);
 
+    CacheStatistics
+    statistics() const;
+
     void
     print();
 
@@ -79,23 +106,46 @@ class Cache {
     clear();
 
  private:
-    void
-    insert_internal(const std::string& key, const ItemObj& item);
+    struct Shard {
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::string, std::pair<ItemObj, int64_t>> items_;
+        std::unique_ptr<CachePolicy<std::string>> policy_;
+        std::atomic<int64_t> hits_{0};
+        std::atomic<int64_t> misses_{0};
+        std::atomic<int64_t> evictions_{0};
+    };
+
+    Shard&
+    shard_of(const std::string& key) const;
+
+    ItemObj
+    get_internal(Shard& shard, const std::string& key);
 
     void
-    erase_internal(const std::string& key);
+    erase_internal(Shard& shard, const std::string& key);
+
+    // evict the policy's victim of a locked shard, false if the shard is empty
+    bool
+    evict_internal(Shard& shard);
 
     void
-    free_memory_internal(const int64_t target_size);
+    free_memory(const int64_t target_size);
+
+    std::unique_ptr<CachePolicy<std::string>>
+    create_policy() const;
 
  private:
     std::string header_;
-    int64_t usage_;
-    int64_t capacity_;
+    std::atomic<int64_t> usage_;
+    std::atomic<int64_t> capacity_;
     double freemem_percent_;
+    CachePolicyType policy_type_;
+    int64_t num_shards_;
+    bool concurrent_access_;
+    size_t shard_max_count_;
+    std::atomic<size_t> evict_cursor_{0};
 
-    LRU<std::string, ItemObj> lru_;
-    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 }  // namespace cache
@@ -9,182 +9,268 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include "cache/Clock.h"
+#include "cache/TinyLFU.h"
+
+#include <algorithm>
+#include <functional>
+
 namespace milvus {
 namespace cache {
 
 constexpr double DEFAULT_THRESHOLD_PERCENT = 0.7;
 
 template <typename ItemObj>
-Cache<ItemObj>::Cache(int64_t capacity, int64_t cache_max_count, const std::string& header)
+Cache<ItemObj>::Cache(int64_t capacity,
+                      int64_t cache_max_count,
+                      const std::string& header,
+                      CachePolicyType policy,
+                      int64_t num_shards)
     : header_(header),
       usage_(0),
       capacity_(capacity),
       freemem_percent_(DEFAULT_THRESHOLD_PERCENT),
-      lru_(cache_max_count) {
+      policy_type_(policy),
+      num_shards_(std::max<int64_t>(num_shards, 1)) {
+    shard_max_count_ = std::max<int64_t>((cache_max_count + num_shards_ - 1) / num_shards_, 1);
+    for (int64_t i = 0; i < num_shards_; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->policy_ = create_policy();
+        shards_.emplace_back(std::move(shard));
+    }
+    concurrent_access_ = shards_.front()->policy_->concurrent_access();
+}
+
+template <typename ItemObj>
+std::unique_ptr<CachePolicy<std::string>>
+Cache<ItemObj>::create_policy() const {
+    std::unique_ptr<CachePolicy<std::string>> policy;
+    switch (policy_type_) {
+        case CachePolicyType::CLOCK:
+            policy = std::make_unique<ClockPolicy<std::string>>();
+            break;
+        case CachePolicyType::TINY_LFU:
+            policy = std::make_unique<TinyLfuPolicy<std::string>>();
+            break;
+        default:
+            policy = std::make_unique<LruPolicy<std::string>>();
+            break;
+    }
+    policy->set_capacity(capacity() / num_shards_);
+    return policy;
+}
+
+template <typename ItemObj>
+typename Cache<ItemObj>::Shard&
+Cache<ItemObj>::shard_of(const std::string& key) const {
+    auto hash = std::hash<std::string>()(key);
+    // the policies hash the key too, use the high bits here
+    return *shards_[(hash * 0x9e3779b97f4a7c15ULL >> 32) % shards_.size()];
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::set_capacity(int64_t capacity) {
-    std::lock_guard<std::mutex> lock(mutex_);
     if (capacity > 0) {
         capacity_ = capacity;
-        free_memory_internal(capacity);
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard->mutex_);
+            shard->policy_->set_capacity(capacity / num_shards_);
+        }
+        if (usage() > capacity) {
+            free_memory(capacity);
+        }
     }
 }
 
 template <typename ItemObj>
 size_t
 Cache<ItemObj>::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.size();
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard->mutex_);
+        count += shard->items_.size();
+    }
+    return count;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::exists(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.exists(key);
+    auto& shard = shard_of(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+    return shard.items_.find(key) != shard.items_.end();
 }
 
 template <typename ItemObj>
 ItemObj
 Cache<ItemObj>::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    auto& shard = shard_of(key);
+    if (concurrent_access_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+        return get_internal(shard, key);
+    }
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    return get_internal(shard, key);
+}
+
+template <typename ItemObj>
+ItemObj
+Cache<ItemObj>::get_internal(Shard& shard, const std::string& key) {
+    auto it = shard.items_.find(key);
+    if (it == shard.items_.end()) {
+        shard.misses_.fetch_add(1, std::memory_order_relaxed);
         return nullptr;
     }
-    return lru_.get(key);
+    shard.policy_->access(key);
+    shard.hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second.first;
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    insert_internal(key, item);
+    if (item == nullptr) {
+        return;
+    }
+
+    int64_t item_size = item->Size();
+    auto& shard = shard_of(key);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        auto it = shard.items_.find(key);
+        // if key already exist, subtract old item size
+        if (it != shard.items_.end()) {
+            usage_ -= it->second.second;
+            it->second = std::make_pair(item, item_size);
+        } else {
+            shard.items_.emplace(key, std::make_pair(item, item_size));
+        }
+        // plus new item size
+        usage_ += item_size;
+        shard.policy_->insert(key, item_size);
+
+        while (shard.items_.size() > shard_max_count_ && evict_internal(shard)) {
+        }
+    }
+
+    // if usage exceed capacity, free some items
+    if (usage() > capacity()) {
+        LOG_SERVER_DEBUG_ << header_ << " Current usage " << (usage() >> 20) << "MB is too high for capacity "
+                          << (capacity() >> 20) << "MB, start free memory";
+        free_memory(capacity());
+    }
+    LOG_SERVER_DEBUG_ << header_ << " Insert " << key << " size: " << (item_size >> 20) << "MB into cache";
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    erase_internal(key);
+    auto& shard = shard_of(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    erase_internal(shard, key);
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::reserve(const int64_t item_size) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (item_size > capacity_) {
+    if (item_size > capacity()) {
         LOG_SERVER_ERROR_ << header_ << " item size " << (item_size >> 20) << "MB too big to insert into cache capacity"
-                         << (capacity_ >> 20) << "MB";
+                          << (capacity() >> 20) << "MB";
         return false;
     }
-    if (item_size > capacity_ - usage_) {
-        free_memory_internal(capacity_ - item_size);
+    if (item_size > capacity() - usage()) {
+        free_memory(capacity() - item_size);
     }
     return true;
 }
 
+template <typename ItemObj>
+CacheStatistics
+Cache<ItemObj>::statistics() const {
+    CacheStatistics statistics;
+    for (auto& shard : shards_) {
+        statistics.hits += shard->hits_.load(std::memory_order_relaxed);
+        statistics.misses += shard->misses_.load(std::memory_order_relaxed);
+        statistics.evictions += shard->evictions_.load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lru_.clear();
-    usage_ = 0;
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard->mutex_);
+        for (auto& item : shard->items_) {
+            usage_ -= item.second.second;
+        }
+        shard->items_.clear();
+        shard->policy_ = create_policy();
+    }
     LOG_SERVER_DEBUG_ << header_ << " Clear cache !";
 }
 
-
 template <typename ItemObj>
 void
 Cache<ItemObj>::print() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    size_t cache_count = lru_.size();
-    // for (auto it = lru_.begin(); it != lru_.end(); ++it) {
-    //     LOG_SERVER_DEBUG_ << it->first;
-    // }
-    LOG_SERVER_DEBUG_ << header_ << " [item count]: " << cache_count << ", [usage] " << (usage_ >> 20)
-                     << "MB, [capacity] " << (capacity_ >> 20) << "MB";
+    auto statistics = this->statistics();
+    LOG_SERVER_DEBUG_ << header_ << " [item count]: " << size() << ", [usage] " << (usage() >> 20)
+                      << "MB, [capacity] " << (capacity() >> 20) << "MB, [hits] " << statistics.hits << ", [misses] "
+                      << statistics.misses << ", [evictions] " << statistics.evictions;
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::insert_internal(const std::string& key, const ItemObj& item) {
-    if (item == nullptr) {
+Cache<ItemObj>::erase_internal(Shard& shard, const std::string& key) {
+    auto it = shard.items_.find(key);
+    if (it == shard.items_.end()) {
         return;
     }
 
-    size_t item_size = item->Size();
-
-    // if key already exist, subtract old item size
-    if (lru_.exists(key)) {
-        const ItemObj& old_item = lru_.get(key);
-        usage_ -= old_item->Size();
-    }
-
-    // plus new item size
-    usage_ += item_size;
+    auto item_size = it->second.second;
+    shard.items_.erase(it);
+    shard.policy_->erase(key);
 
-    // if usage exceed capacity, free some items
-    if (usage_ > capacity_) {
-        LOG_SERVER_DEBUG_ << header_ << " Current usage " << (usage_ >> 20) << "MB is too high for capacity "
-                         << (capacity_ >> 20) << "MB, start free memory";
-        free_memory_internal(capacity_);
-    }
-
-    // insert new item
-    lru_.put(key, item);
-    LOG_SERVER_DEBUG_ << header_ << " Insert " << key << " size: " << (item_size >> 20) << "MB into cache";
-    LOG_SERVER_DEBUG_ << header_ << " Count: " << lru_.size() << ", Usage: " << (usage_ >> 20) << "MB, Capacity: "
-                     << (capacity_ >> 20) << "MB";
+    usage_ -= item_size;
+    LOG_SERVER_DEBUG_ << header_ << " Erase " << key << " size: " << (item_size >> 20) << "MB from cache";
 }
 
 template <typename ItemObj>
-void
-Cache<ItemObj>::erase_internal(const std::string& key) {
-    if (!lru_.exists(key)) {
-        return;
+bool
+Cache<ItemObj>::evict_internal(Shard& shard) {
+    std::string key;
+    if (!shard.policy_->victim(key)) {
+        return false;
     }
-
-    const ItemObj& item = lru_.get(key);
-    size_t item_size = item->Size();
-
-    lru_.erase(key);
-
-    usage_ -= item_size;
-    LOG_SERVER_DEBUG_ << header_ << " Erase " << key << " size: " << (item_size >> 20) << "MB from cache";
-    LOG_SERVER_DEBUG_ << header_ << " Count: " << lru_.size() << ", Usage: " << (usage_ >> 20) << "MB, Capacity: "
-                     << (capacity_ >> 20) << "MB";
+    erase_internal(shard, key);
+    shard.evictions_.fetch_add(1, std::memory_order_relaxed);
+    return true;
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::free_memory_internal(const int64_t target_size) {
-    int64_t threshold = std::min((int64_t)(capacity_ * freemem_percent_), target_size);
-    int64_t delta_size = usage_ - threshold;
-    if (delta_size <= 0) {
-        delta_size = 1;  // ensure at least one item erased
-    }
-
-    std::set<std::string> key_array;
-    int64_t released_size = 0;
+Cache<ItemObj>::free_memory(const int64_t target_size) {
+    int64_t threshold = std::min((int64_t)(capacity() * freemem_percent_), target_size);
+    auto start_usage = usage();
 
-    auto it = lru_.rbegin();
-    while (it != lru_.rend() && released_size < delta_size) {
-        auto& key = it->first;
-        auto& obj_ptr = it->second;
-
-        key_array.emplace(key);
-        released_size += obj_ptr->Size();
-        ++it;
+    // one victim per shard per round, starting where the last eviction stopped, so no shard
+    // is emptied for the others. at least one item goes, as before sharding.
+    bool evicted_any = false;
+    bool progress = true;
+    while (progress && (usage() > threshold || !evicted_any)) {
+        progress = false;
+        for (size_t i = 0; i < shards_.size() && (usage() > threshold || !evicted_any); ++i) {
+            auto& shard = *shards_[evict_cursor_.fetch_add(1, std::memory_order_relaxed) % shards_.size()];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+            if (evict_internal(shard)) {
+                evicted_any = true;
+                progress = true;
+            }
+        }
     }
 
-    LOG_SERVER_DEBUG_ << header_ << " To be released memory size: " << (released_size >> 20) << "MB";
-
-    for (auto& key : key_array) {
-        erase_internal(key);
-    }
+    LOG_SERVER_DEBUG_ << header_ << " Released memory size: " << ((start_usage - usage()) >> 20) << "MB";
 }
 
 }  // namespace cache
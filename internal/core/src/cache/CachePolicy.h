@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "LRU.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace milvus {
+namespace cache {
+
+enum class CachePolicyType {
+    LRU = 0,
+    CLOCK = 1,
+    TINY_LFU = 2,  // W-TinyLFU: a small admission window in front of a frequency filtered main region
+};
+
+// eviction order of the items in one cache shard. the shard owns the items and holds its lock
+// around every call: exclusive for insert/erase/evict, and for access too unless concurrent_access().
+template <typename key_t>
+class CachePolicy {
+ public:
+    virtual ~CachePolicy() = default;
+
+    // whether access() may run under a shared lock, concurrently with other access() calls
+    virtual bool
+    concurrent_access() const = 0;
+
+    // byte budget of the shard, policies with regions size them from it
+    virtual void
+    set_capacity(int64_t capacity) {
+    }
+
+    virtual void
+    insert(const key_t& key, int64_t size) = 0;
+
+    virtual void
+    access(const key_t& key) = 0;
+
+    virtual void
+    erase(const key_t& key) = 0;
+
+    // the next item to evict, false if the policy tracks no item
+    virtual bool
+    victim(key_t& key) = 0;
+};
+
+// exact LRU, every access reorders the list so it needs the exclusive lock
+template <typename key_t>
+class LruPolicy : public CachePolicy<key_t> {
+ public:
+    LruPolicy() : lru_(std::numeric_limits<size_t>::max()) {
+    }
+
+    bool
+    concurrent_access() const override {
+        return false;
+    }
+
+    void
+    insert(const key_t& key, int64_t size) override {
+        lru_.put(key, size);
+    }
+
+    void
+    access(const key_t& key) override {
+        if (lru_.exists(key)) {
+            lru_.get(key);
+        }
+    }
+
+    void
+    erase(const key_t& key) override {
+        lru_.erase(key);
+    }
+
+    bool
+    victim(key_t& key) override {
+        if (lru_.size() == 0) {
+            return false;
+        }
+        key = lru_.rbegin()->first;
+        return true;
+    }
+
+ private:
+    LRU<key_t, int64_t> lru_;
+};
+
+}  // namespace cache
+}  // namespace milvus
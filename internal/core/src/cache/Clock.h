@@ -0,0 +1,184 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CachePolicy.h"
+
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+// CLOCK ring: an access only sets the referenced bit of its slot, the hand clears the bits
+// and stops at the first unreferenced slot. access() is safe under a shared lock, the rest is not.
+template <typename key_t>
+class ClockList {
+ public:
+    void
+    insert(const key_t& key, int64_t size) {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            usage_ += size - slots_[it->second].size;
+            slots_[it->second].size = size;
+            slots_[it->second].referenced.store(true, std::memory_order_relaxed);
+            return;
+        }
+        size_t slot;
+        if (free_slots_.empty()) {
+            slot = slots_.size();
+            slots_.emplace_back();
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        slots_[slot].key = key;
+        slots_[slot].size = size;
+        slots_[slot].used = true;
+        slots_[slot].referenced.store(false, std::memory_order_relaxed);
+        index_.emplace(key, slot);
+        usage_ += size;
+    }
+
+    bool
+    access(const key_t& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return false;
+        }
+        auto& referenced = slots_[it->second].referenced;
+        // skip the store when already set, keeps the cache line shared between readers
+        if (!referenced.load(std::memory_order_relaxed)) {
+            referenced.store(true, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool
+    erase(const key_t& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return false;
+        }
+        auto& slot = slots_[it->second];
+        usage_ -= slot.size;
+        slot.used = false;
+        slot.key = key_t();
+        free_slots_.push_back(it->second);
+        index_.erase(it);
+        return true;
+    }
+
+    bool
+    contains(const key_t& key) const {
+        return index_.find(key) != index_.end();
+    }
+
+    bool
+    referenced(const key_t& key) const {
+        auto it = index_.find(key);
+        return it != index_.end() && slots_[it->second].referenced.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    size_of(const key_t& key) const {
+        auto it = index_.find(key);
+        return it == index_.end() ? 0 : slots_[it->second].size;
+    }
+
+    bool
+    victim(key_t& key) {
+        if (index_.empty()) {
+            return false;
+        }
+        // two rounds at most, the first one clears every referenced bit
+        for (size_t step = 0; step < 2 * slots_.size() + 1; ++step) {
+            if (hand_ >= slots_.size()) {
+                hand_ = 0;
+            }
+            auto& slot = slots_[hand_];
+            if (slot.used) {
+                if (!slot.referenced.load(std::memory_order_relaxed)) {
+                    key = slot.key;
+                    return true;
+                }
+                slot.referenced.store(false, std::memory_order_relaxed);
+            }
+            ++hand_;
+        }
+        return false;
+    }
+
+    size_t
+    size() const {
+        return index_.size();
+    }
+
+    int64_t
+    usage() const {
+        return usage_;
+    }
+
+ private:
+    struct Slot {
+        key_t key;
+        int64_t size = 0;
+        bool used = false;
+        std::atomic<bool> referenced{false};
+    };
+
+    // deque keeps slots in place as it grows, they hold atomics
+    std::deque<Slot> slots_;
+    std::vector<size_t> free_slots_;
+    std::unordered_map<key_t, size_t> index_;
+    size_t hand_ = 0;
+    int64_t usage_ = 0;
+};
+
+template <typename key_t>
+class ClockPolicy : public CachePolicy<key_t> {
+ public:
+    bool
+    concurrent_access() const override {
+        return true;
+    }
+
+    void
+    insert(const key_t& key, int64_t size) override {
+        // a new item starts referenced so the next sweep doesn't take it right away
+        clock_.insert(key, size);
+        clock_.access(key);
+    }
+
+    void
+    access(const key_t& key) override {
+        clock_.access(key);
+    }
+
+    void
+    erase(const key_t& key) override {
+        clock_.erase(key);
+    }
+
+    bool
+    victim(key_t& key) override {
+        return clock_.victim(key);
+    }
+
+ private:
+    ClockList<key_t> clock_;
+};
+
+}  // namespace cache
+}  // namespace milvus
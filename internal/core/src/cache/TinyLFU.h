@@ -0,0 +1,200 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CachePolicy.h"
+#include "Clock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace milvus {
+namespace cache {
+
+// count-min sketch of access frequencies with saturating 4-bit counts, halved every sample period
+// so old popularity fades. increment() and estimate() are safe under a shared lock.
+template <typename key_t>
+class FrequencySketch {
+ public:
+    static constexpr int DEPTH = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+    static constexpr size_t MIN_WIDTH = 256;
+    static constexpr int64_t SAMPLE_FACTOR = 10;
+
+    FrequencySketch() {
+        resize(MIN_WIDTH);
+    }
+
+    void
+    increment(const key_t& key) {
+        auto hash = std::hash<key_t>()(key);
+        bool added = false;
+        for (int i = 0; i < DEPTH; ++i) {
+            auto& counter = table_[index_of(hash, i)];
+            auto count = counter.load(std::memory_order_relaxed);
+            // saturated counters are not written, hot keys don't bounce their cache line
+            while (count < MAX_COUNT && !counter.compare_exchange_weak(count, count + 1, std::memory_order_relaxed)) {
+            }
+            added |= count < MAX_COUNT;
+        }
+        if (added) {
+            additions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint8_t
+    estimate(const key_t& key) const {
+        auto hash = std::hash<key_t>()(key);
+        uint8_t count = MAX_COUNT;
+        for (int i = 0; i < DEPTH; ++i) {
+            count = std::min(count, table_[index_of(hash, i)].load(std::memory_order_relaxed));
+        }
+        return count;
+    }
+
+    // grow with the number of tracked items and age the counts, needs the exclusive lock
+    void
+    maintain(size_t num_items) {
+        size_t width = MIN_WIDTH;
+        while (width < num_items * 4) {
+            width <<= 1;
+        }
+        if (width > width_) {
+            resize(width);
+            return;
+        }
+        if (additions_.load(std::memory_order_relaxed) >= SAMPLE_FACTOR * static_cast<int64_t>(width_)) {
+            for (size_t i = 0; i < width_ * DEPTH; ++i) {
+                table_[i].store(table_[i].load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+            }
+            additions_.store(additions_.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+        }
+    }
+
+ private:
+    void
+    resize(size_t width) {
+        width_ = width;
+        table_ = std::make_unique<std::atomic<uint8_t>[]>(width * DEPTH);
+        for (size_t i = 0; i < width * DEPTH; ++i) {
+            table_[i].store(0, std::memory_order_relaxed);
+        }
+        additions_.store(0, std::memory_order_relaxed);
+    }
+
+    size_t
+    index_of(size_t hash, int row) const {
+        uint64_t x = hash + (row + 1) * 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return row * width_ + (x & (width_ - 1));
+    }
+
+ private:
+    size_t width_ = 0;
+    std::unique_ptr<std::atomic<uint8_t>[]> table_;
+    std::atomic<int64_t> additions_{0};
+};
+
+// W-TinyLFU over CLOCK regions. new items enter a window of about 1% of the budget, items pushed
+// out of the window join the main region as candidates, and on eviction an unused candidate only
+// stays if the sketch has seen it more often than the main region's victim. a one-off scan therefore churns
+// the window and the candidates instead of flushing the frequently used items.
+template <typename key_t>
+class TinyLfuPolicy : public CachePolicy<key_t> {
+ public:
+    static constexpr double WINDOW_RATIO = 0.01;
+
+    bool
+    concurrent_access() const override {
+        return true;
+    }
+
+    void
+    set_capacity(int64_t capacity) override {
+        window_capacity_ = static_cast<int64_t>(capacity * WINDOW_RATIO);
+    }
+
+    void
+    insert(const key_t& key, int64_t size) override {
+        sketch_.increment(key);
+        if (main_.contains(key)) {
+            main_.insert(key, size);
+        } else {
+            window_.insert(key, size);
+            // the newest item gets a second chance in the window
+            window_.access(key);
+            key_t overflow;
+            while (window_.usage() > window_capacity_ && window_.size() > 1 && window_.victim(overflow)) {
+                auto overflow_size = window_.size_of(overflow);
+                window_.erase(overflow);
+                main_.insert(overflow, overflow_size);
+                candidates_.push_back(overflow);
+            }
+        }
+        sketch_.maintain(window_.size() + main_.size());
+    }
+
+    void
+    access(const key_t& key) override {
+        sketch_.increment(key);
+        if (!window_.access(key)) {
+            main_.access(key);
+        }
+    }
+
+    void
+    erase(const key_t& key) override {
+        if (!window_.erase(key)) {
+            main_.erase(key);
+        }
+    }
+
+    bool
+    victim(key_t& key) override {
+        // candidates that left the main region, or were used there and so earned their place, are done
+        while (!candidates_.empty() &&
+               (!main_.contains(candidates_.front()) || main_.referenced(candidates_.front()))) {
+            candidates_.pop_front();
+        }
+        key_t main_victim;
+        if (!main_.victim(main_victim)) {
+            return window_.victim(key);
+        }
+        if (candidates_.empty()) {
+            key = main_victim;
+            return true;
+        }
+        auto candidate = candidates_.front();
+        candidates_.pop_front();
+        if (candidate != main_victim && sketch_.estimate(candidate) > sketch_.estimate(main_victim)) {
+            key = main_victim;
+        } else {
+            key = candidate;
+        }
+        return true;
+    }
+
+ private:
+    int64_t window_capacity_ = 0;
+    ClockList<key_t> window_;
+    ClockList<key_t> main_;
+    std::deque<key_t> candidates_;
+    FrequencySketch<key_t> sketch_;
+};
+
+}  // namespace cache
+}  // namespace milvus
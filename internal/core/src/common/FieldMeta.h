@@ -41,6 +41,8 @@ datatype_sizeof(DataType data_type, int dim = 1) {
             Assert(dim % 8 == 0);
             return dim / 8;
         }
+        case DataType::VECTOR_INT8:
+            return sizeof(int8_t) * dim;
         default: {
             throw std::invalid_argument("unsupported data type");
             return 0;
@@ -71,6 +73,8 @@ datatype_name(DataType data_type) {
         case DataType::VECTOR_BINARY: {
             return "vector_binary";
         }
+        case DataType::VECTOR_INT8:
+            return "vector_int8";
         default: {
             auto err_msg = "Unsupported DataType(" + std::to_string((int)data_type) + ")";
             PanicInfo(err_msg);
@@ -80,7 +84,8 @@ datatype_name(DataType data_type) {
 
 inline bool
 datatype_is_vector(DataType datatype) {
-    return datatype == DataType::VECTOR_BINARY || datatype == DataType::VECTOR_FLOAT;
+    return datatype == DataType::VECTOR_BINARY || datatype == DataType::VECTOR_FLOAT ||
+           datatype == DataType::VECTOR_INT8;
 }
 
 inline bool
@@ -128,7 +133,7 @@ class FieldMeta {
     bool
     is_vector() const {
         Assert(type_ != DataType::NONE);
-        return type_ == DataType::VECTOR_BINARY || type_ == DataType::VECTOR_FLOAT;
+        return datatype_is_vector(type_);
     }
 
     int64_t
@@ -19,6 +19,8 @@ struct LoadIndexInfo {
     int64_t field_id;
     std::map<std::string, std::string> index_params;
     milvus::knowhere::VecIndexPtr index;
+    // local copy of the index binaries when the index may be evicted, see ResidencyManager
+    std::string index_file;
 };
 
 // NOTE: field_id can be system field
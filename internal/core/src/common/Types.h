@@ -44,6 +44,13 @@ template <typename T>
 using aligned_vector = std::vector<T, boost::alignment::aligned_allocator<T, 64>>;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+// how a segment answered a vector search, chosen per segment by ExecPlanNodeVisitor
+enum class SearchStrategy {
+    INDEX = 0,                  // index (or full brute force) search with the predicate bitset
+    BRUTE_FORCE_ON_PASSED = 1,  // exact search over the rows passing the predicate only
+    WIDENED_INDEX = 2,          // index search with search params widened by the pass ratio
+};
+
 struct QueryResult {
     QueryResult() = default;
     QueryResult(uint64_t num_queries, uint64_t topK) : topK_(topK), num_queries_(num_queries) {
@@ -54,6 +61,9 @@ struct QueryResult {
 
     [[nodiscard]] uint64_t
     get_row_count() const {
+        if (!result_lims_.empty()) {
+            return result_lims_.back();
+        }
         return topK_ * num_queries_;
     }
 
@@ -61,7 +71,10 @@ struct QueryResult {
     uint64_t num_queries_;
     uint64_t topK_;
     uint64_t seg_id_;
+    SearchStrategy search_strategy_ = SearchStrategy::INDEX;
     std::vector<float> result_distances_;
+    // only for range search, hits of query i are [result_lims_[i], result_lims_[i + 1])
+    std::vector<int64_t> result_lims_;
 
  public:
     // TODO(gexi): utilize these field
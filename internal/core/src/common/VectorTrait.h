@@ -28,12 +28,20 @@ class BinaryVector : public VectorTrait {
     static constexpr auto metric_type = DataType::VECTOR_BINARY;
 };
 
+class Int8Vector : public VectorTrait {
+ public:
+    using embedded_type = int8_t;
+    static constexpr auto metric_type = DataType::VECTOR_INT8;
+};
+
 template <typename VectorType>
 inline constexpr int64_t
 get_element_sizeof(int64_t dim) {
     static_assert(std::is_base_of_v<VectorType, VectorTrait>);
     if constexpr (std::is_same_v<VectorType, FloatVector>) {
         return dim * sizeof(float);
+    } else if constexpr (std::is_same_v<VectorType, Int8Vector>) {
+        return dim * sizeof(int8_t);
     } else {
         return dim / 8;
     }
@@ -55,7 +63,7 @@ struct EmbeddedTypeImpl<T, std::enable_if_t<IsScalar<T>>> {
 
 template <typename T>
 struct EmbeddedTypeImpl<T, std::enable_if_t<IsVector<T>>> {
-    using type = std::conditional_t<std::is_same_v<T, FloatVector>, float, uint8_t>;
+    using type = typename T::embedded_type;
 };
 
 template <typename T>
@@ -24,6 +24,7 @@
 #include "knowhere/index/IndexType.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/MmapInvertedLists.h"
 #include "utils/ConfigUtils.h"
 #include "utils/Error.h"
 #include "utils/Log.h"
@@ -86,15 +87,28 @@ KnowhereConfig::SetClusteringType(const ClusteringType clustering_type) {
         case ClusteringType::K_MEANS_PLUS_PLUS:
             faiss::clustering_type = faiss::ClusteringType::K_MEANS_PLUS_PLUS;
             break;
+        case ClusteringType::K_MEANS_PARALLEL:
+            faiss::clustering_type = faiss::ClusteringType::K_MEANS_PARALLEL;
+            break;
     }
 }
 
+void
+KnowhereConfig::SetClusteringMiniBatchSize(const int64_t mini_batch_size) {
+    faiss::kmeans_mini_batch_size = mini_batch_size;
+}
+
 void
 KnowhereConfig::SetStatisticsLevel(const int64_t stat_level) {
     milvus::knowhere::STATISTICS_LEVEL = stat_level;
     faiss::STATISTICS_LEVEL = stat_level;
 }
 
+void
+KnowhereConfig::SetMmapPath(const std::string& mmap_path) {
+    knowhere::SetMmapPath(mmap_path);
+}
+
 void
 KnowhereConfig::SetLogHandler() {
     faiss::LOG_ERROR_ = &knowhere::log_error_;
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "utils/Status.h"
@@ -56,17 +57,32 @@ class KnowhereConfig {
     enum ClusteringType {
         K_MEANS,            // k-means (default)
         K_MEANS_PLUS_PLUS,  // k-means++
+        K_MEANS_PARALLEL,   // k-means||
     };
 
     static void
     SetClusteringType(const ClusteringType clustering_type);
 
+    /**
+     * set Clustering mini-batch size
+     *   Each K-means iteration updates the centroids with this many sampled points.
+     *   And if mini_batch_size = 0, all the training points are used
+     */
+    static void
+    SetClusteringMiniBatchSize(const int64_t mini_batch_size);
+
     /**
      * set Statistics Level [0, 3]
      */
     static void
     SetStatisticsLevel(const int64_t stat_level);
 
+    /**
+     * set the directory MODE_MMAP indexes map their inverted lists from
+     */
+    static void
+    SetMmapPath(const std::string& mmap_path);
+
     // todo: add log level?
     /**
      * set Log handler
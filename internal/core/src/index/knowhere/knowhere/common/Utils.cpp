@@ -65,11 +65,16 @@ Assemble(BinarySet& binarySet) {
         int slice_num = item[SLICE_NUM];
         auto total_len = static_cast<size_t>(item[TOTAL_LEN]);
         auto p_data = std::shared_ptr<uint8_t[]>(new uint8_t[total_len]);
-        int64_t pos = 0;
+        std::vector<BinaryPtr> slices(slice_num);
+        std::vector<int64_t> offsets(slice_num + 1, 0);
         for (auto i = 0; i < slice_num; ++i) {
-            auto slice_i_sp = binarySet.Erase(prefix + "_" + std::to_string(i));
-            memcpy(p_data.get() + pos, slice_i_sp->data.get(), static_cast<size_t>(slice_i_sp->size));
-            pos += slice_i_sp->size;
+            slices[i] = binarySet.Erase(prefix + "_" + std::to_string(i));
+            offsets[i + 1] = offsets[i] + slices[i]->size;
+        }
+        // the slices of a large index are copied by several threads, a single one is bound by memory latency
+#pragma omp parallel for
+        for (auto i = 0; i < slice_num; ++i) {
+            memcpy(p_data.get() + offsets[i], slices[i]->data.get(), static_cast<size_t>(slices[i]->size));
         }
         binarySet.Append(prefix, p_data, total_len);
     }
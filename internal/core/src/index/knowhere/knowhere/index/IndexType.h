@@ -52,6 +52,7 @@ extern const char* INVALID;
 extern const char* INDEX_FAISS_IDMAP;
 extern const char* INDEX_FAISS_IVFFLAT;
 extern const char* INDEX_FAISS_IVFPQ;
+extern const char* INDEX_FAISS_IVFPQ_FASTSCAN;
 extern const char* INDEX_FAISS_IVFSQ8;
 extern const char* INDEX_FAISS_IVFSQ8H;
 extern const char* INDEX_FAISS_IVFHNSW;
@@ -71,7 +72,7 @@ extern const char* INDEX_NGTPANNG;
 extern const char* INDEX_NGTONNG;
 }  // namespace IndexEnum
 
-enum class IndexMode { MODE_CPU = 0, MODE_GPU = 1 };
+enum class IndexMode { MODE_CPU = 0, MODE_GPU = 1, MODE_MMAP = 2 };
 
 }  // namespace knowhere
 }  // namespace milvus
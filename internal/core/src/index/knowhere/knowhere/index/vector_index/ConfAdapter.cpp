@@ -141,6 +141,9 @@ IVFConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMod
     }
 #endif
     CheckIntByRange(knowhere::IndexParams::nprobe, MIN_NPROBE, max_nprobe);
+    if (oricfg.contains(knowhere::IndexParams::adaptive_patience)) {
+        CheckIntByRange(knowhere::IndexParams::adaptive_patience, 0, max_nprobe);
+    }
 
     return ConfAdapter::CheckSearch(oricfg, type, mode);
 }
@@ -210,6 +213,20 @@ IVFPQConfAdapter::CheckCPUPQParams(int64_t dimension, int64_t m) {
     return (dimension % m == 0);
 }
 
+bool
+IVFPQFastScanConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    if (!IVFConfAdapter::CheckTrain(oricfg, mode)) {
+        return false;
+    }
+
+    // the fast scan kernels work on 4-bit codes only
+    oricfg[knowhere::IndexParams::nbits] = 4;
+
+    auto m = oricfg[knowhere::IndexParams::m].get<int64_t>();
+    auto dimension = oricfg[knowhere::meta::DIM].get<int64_t>();
+    return IVFPQConfAdapter::CheckCPUPQParams(dimension, m);
+}
+
 bool
 IVFHNSWConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     // HNSW param check
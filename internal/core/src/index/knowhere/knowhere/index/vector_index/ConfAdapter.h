@@ -61,6 +61,12 @@ class IVFPQConfAdapter : public IVFConfAdapter {
     CheckCPUPQParams(int64_t dimension, int64_t m);
 };
 
+class IVFPQFastScanConfAdapter : public IVFConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class IVFHNSWConfAdapter : public ConfAdapter {
  public:
     bool
@@ -158,6 +158,19 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const fais
     index_->setEf(config[IndexParams::ef].get<int64_t>());
     bool transform = (index_->metric_type_ == 1);  // InnerProduct: 1
 
+    bool brute_force = false;
+    bool expand_filtered = false;
+    if (!bitset.empty()) {
+        auto total = static_cast<int64_t>(index_->cur_element_count);
+        auto passed = std::max<int64_t>(total - static_cast<int64_t>(bitset.count_1()), 0);
+        auto pass_ratio = total == 0 ? 1.0 : static_cast<double>(passed) / total;
+        if (pass_ratio < BRUTE_FORCE_PASS_RATIO || passed <= static_cast<int64_t>(std::max(index_->ef_, k))) {
+            brute_force = true;
+        } else if (pass_ratio < EXPAND_PASS_RATIO) {
+            expand_filtered = true;
+        }
+    }
+
     std::chrono::high_resolution_clock::time_point query_start, query_end;
     query_start = std::chrono::high_resolution_clock::now();
 
@@ -165,11 +178,13 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const fais
     for (unsigned int i = 0; i < rows; ++i) {
         auto single_query = (float*)p_data + i * dim;
         std::priority_queue<std::pair<float, hnswlib::labeltype>> rst;
-        if (STATISTICS_LEVEL >= 3) {
-            rst = index_->searchKnn(single_query, k, bitset, query_stats[i]);
+        if (brute_force) {
+            rst = index_->searchKnnBF(single_query, k, bitset);
+        } else if (STATISTICS_LEVEL >= 3) {
+            rst = index_->searchKnn(single_query, k, bitset, query_stats[i], expand_filtered);
         } else {
             auto dummy_stat = hnswlib::StatisticsInfo();
-            rst = index_->searchKnn(single_query, k, bitset, dummy_stat);
+            rst = index_->searchKnn(single_query, k, bitset, dummy_stat, expand_filtered);
         }
         size_t rst_size = rst.size();
 
@@ -224,6 +239,48 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const fais
     return ret_ds;
 }
 
+DatasetPtr
+IndexHNSW::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config, const faiss::BitsetView bitset) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GET_TENSOR_DATA_DIM(dataset_ptr)
+
+    if (config.contains(IndexParams::ef)) {
+        index_->setEf(config[IndexParams::ef].get<int64_t>());
+    }
+    bool transform = (index_->metric_type_ == 1);  // InnerProduct: 1
+    auto radius = config[IndexParams::range_search_radius].get<float>();
+    // hnswlib measures inner product as 1 - ip, so ip > radius becomes 1 - ip < 1 - radius
+    auto hnsw_radius = transform ? (1 - radius) : radius;
+
+    std::vector<std::vector<std::pair<float, hnswlib::labeltype>>> hits(rows);
+#pragma omp parallel for
+    for (unsigned int i = 0; i < rows; ++i) {
+        auto single_query = (float*)p_data + i * dim;
+        auto dummy_stat = hnswlib::StatisticsInfo();
+        hits[i] = index_->searchRange(single_query, hnsw_radius, bitset, dummy_stat);
+    }
+
+    faiss::RangeSearchResult result(rows);
+    for (auto i = 0; i < rows; ++i) {
+        result.lims[i] = hits[i].size();
+    }
+    result.do_allocation();
+    for (auto i = 0; i < rows; ++i) {
+        auto ofs = result.lims[i];
+        for (auto& hit : hits[i]) {
+            result.distances[ofs] = transform ? (1 - hit.first) : hit.first;
+            result.labels[ofs] = hit.second;
+            ++ofs;
+        }
+    }
+
+    auto ret_ds = RangeSearchResultToDataset(result);
+    MapOffsetToUid(ret_ds->Get<int64_t*>(meta::IDS), result.lims[rows]);
+    return ret_ds;
+}
+
 int64_t
 IndexHNSW::Count() {
     if (!index_) {
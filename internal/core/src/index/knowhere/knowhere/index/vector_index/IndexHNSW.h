@@ -43,6 +43,9 @@ class IndexHNSW : public VecIndex {
     DatasetPtr
     Query(const DatasetPtr& dataset_ptr, const Config& config, const faiss::BitsetView bitset) override;
 
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) override;
+
     int64_t
     Count() override;
 
@@ -56,6 +59,12 @@ class IndexHNSW : public VecIndex {
     ClearStatistics() override;
 
  private:
+    // Filtered search switches strategy on the fraction of rows passing the bitset: below
+    // BRUTE_FORCE_PASS_RATIO the passing rows are scanned exhaustively, below EXPAND_PASS_RATIO
+    // the graph walk hops over filtered nodes to their neighbours, above it the plain walk is used.
+    static constexpr double BRUTE_FORCE_PASS_RATIO = 0.02;
+    static constexpr double EXPAND_PASS_RATIO = 0.3;
+
     std::shared_ptr<hnswlib::HierarchicalNSW<float>> index_;
 };
 
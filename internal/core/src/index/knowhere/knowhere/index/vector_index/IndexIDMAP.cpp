@@ -134,6 +134,37 @@ IDMAP::QueryByDistance(const milvus::knowhere::DatasetPtr& dataset,
     return result;
 }
 
+DatasetPtr
+IDMAP::QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset)
+
+    auto real_idx = dynamic_cast<faiss::IndexFlat*>(index_.get());
+    if (real_idx == nullptr) {
+        KNOWHERE_THROW_MSG("Cannot dynamic_cast the index to faiss::IndexFlat type!");
+    }
+    auto default_type = index_->metric_type;
+    if (config.contains(Metric::TYPE)) {
+        index_->metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    }
+    // unlike QueryByDistance, the radius is in the unit Query reports distances in, i.e. squared for L2
+    auto radius = config[IndexParams::range_search_radius].get<float>();
+    auto buffer_size = config.contains(IndexParams::range_search_buffer_size)
+                           ? config[IndexParams::range_search_buffer_size].get<size_t>()
+                           : 16384;
+    std::vector<faiss::RangeSearchPartialResult*> res;
+    real_idx->range_search(rows, reinterpret_cast<const float*>(p_data), radius, res, buffer_size, bitset);
+    index_->metric_type = default_type;
+
+    faiss::RangeSearchResult result(rows);
+    MergeRangeSearchPartialResults(res, result);
+    auto ret_ds = RangeSearchResultToDataset(result);
+    MapOffsetToUid(ret_ds->Get<int64_t*>(meta::IDS), result.lims[rows]);
+    return ret_ds;
+}
+
 int64_t
 IDMAP::Count() {
     if (!index_) {
@@ -36,6 +36,7 @@
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "knowhere/index/vector_index/helpers/MmapInvertedLists.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/gpu/IndexGPUIVF.h"
 #include "knowhere/index/vector_index/helpers/FaissGpuResourceMgr.h"
@@ -52,6 +53,10 @@ IVF::Serialize(const Config& config) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
 
+    if (index_mode_ == IndexMode::MODE_MMAP) {
+        KNOWHERE_THROW_MSG("can not serialize an index with mapped inverted lists");
+    }
+
     auto ret = SerializeImpl(index_type_);
     if (config.contains(INDEX_FILE_SLICE_SIZE_IN_MEGABYTE)) {
         Disassemble(config[INDEX_FILE_SLICE_SIZE_IN_MEGABYTE].get<int64_t>() * 1024 * 1024, ret);
@@ -64,10 +69,21 @@ IVF::Load(const BinarySet& binary_set) {
     Assemble(const_cast<BinarySet&>(binary_set));
     LoadImpl(binary_set, index_type_);
 
+    if (index_mode_ == IndexMode::MODE_MMAP) {
+        // only the quantizer stays in memory
+        auto ivf_index = static_cast<faiss::IndexIVF*>(index_.get());
+        ivf_index->replace_invlists(new MmapInvertedLists(*ivf_index->invlists), true);
+    }
+
     if (IndexMode() == IndexMode::MODE_CPU && STATISTICS_LEVEL >= 3) {
         auto ivf_index = static_cast<faiss::IndexIVFFlat*>(index_.get());
         ivf_index->nprobe_statistics.resize(ivf_index->nlist, 0);
     }
+
+    if (index_mode_ == IndexMode::MODE_CPU) {
+        // for the adaptive_bound, not in mmap mode where it would read all the lists
+        static_cast<faiss::IndexIVF*>(index_.get())->compute_list_radii();
+    }
 }
 
 void
@@ -83,6 +99,22 @@ IVF::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     index_ = index;
 }
 
+void
+IVF::InitWithQuantizer(const std::shared_ptr<faiss::Index>& quantizer, const Config& config) {
+    if (!quantizer || !quantizer->is_trained || quantizer->ntotal == 0) {
+        KNOWHERE_THROW_MSG("coarse quantizer not trained");
+    }
+    auto dim = config[meta::DIM].get<int64_t>();
+    faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    if (quantizer->d != dim || quantizer->metric_type != metric_type) {
+        KNOWHERE_THROW_MSG("coarse quantizer does not match the dimension or metric type");
+    }
+
+    // not owned by the faiss index, the deleter holds the reference
+    auto index = new faiss::IndexIVFFlat(quantizer.get(), dim, quantizer->ntotal, metric_type);
+    index_ = std::shared_ptr<faiss::Index>(index, [quantizer](faiss::Index* p) { delete p; });
+}
+
 void
 IVF::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
     if (!index_ || !index_->is_trained) {
@@ -91,6 +123,7 @@ IVF::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
 
     GET_TENSOR_DATA(dataset_ptr)
     index_->add(rows, reinterpret_cast<const float*>(p_data));
+    dynamic_cast<faiss::IndexIVF*>(index_.get())->compute_list_radii();
 }
 
 DatasetPtr
@@ -139,6 +172,37 @@ IVF::Query(const DatasetPtr& dataset_ptr, const Config& config, const faiss::Bit
     }
 }
 
+DatasetPtr
+IVF::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config, const faiss::BitsetView bitset) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GET_TENSOR_DATA(dataset_ptr)
+
+    try {
+        auto params = GenParams(config);
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+        ivf_index->nprobe = std::min(params->nprobe, ivf_index->invlists->nlist);
+        if (params->nprobe > 1 && rows <= 4) {
+            ivf_index->parallel_mode = 1;
+        } else {
+            ivf_index->parallel_mode = 0;
+        }
+        auto radius = config[IndexParams::range_search_radius].get<float>();
+        faiss::RangeSearchResult result(rows);
+        ivf_index->range_search(rows, reinterpret_cast<const float*>(p_data), radius, &result, bitset);
+
+        auto ret_ds = RangeSearchResultToDataset(result);
+        MapOffsetToUid(ret_ds->Get<int64_t*>(meta::IDS), result.lims[rows]);
+        return ret_ds;
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 #if 0
 DatasetPtr
 IVF::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
@@ -332,6 +396,14 @@ IVF::QueryImpl(int64_t n,
     } else {
         ivf_index->parallel_mode = 0;
     }
+    ivf_index->adaptive_patience =
+        config.contains(IndexParams::adaptive_patience) ? config[IndexParams::adaptive_patience].get<int64_t>() : 0;
+    ivf_index->adaptive_bound =
+        config.contains(IndexParams::adaptive_bound) && config[IndexParams::adaptive_bound].get<bool>();
+    if (ivf_index->adaptive_patience > 0 || ivf_index->adaptive_bound) {
+        // the adaptive termination works per query
+        ivf_index->parallel_mode = 0;
+    }
     auto ivf_stats = std::dynamic_pointer_cast<IVFStatistics>(stats);
     ivf_index->search(n, data, k, distances, labels, bitset);
     stdclock::time_point after = stdclock::now();
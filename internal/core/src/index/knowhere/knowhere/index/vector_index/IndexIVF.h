@@ -45,12 +45,20 @@ class IVF : public VecIndex, public FaissBaseIndex {
     void
     Train(const DatasetPtr&, const Config&) override;
 
+    // instead of Train for IVF_FLAT: uses a trained coarse quantizer, which can be shared with other
+    // indexes. the index keeps the quantizer alive, it must not change afterwards
+    void
+    InitWithQuantizer(const std::shared_ptr<faiss::Index>& quantizer, const Config& config);
+
     void
     AddWithoutIds(const DatasetPtr&, const Config&) override;
 
     DatasetPtr
     Query(const DatasetPtr&, const Config&, const faiss::BitsetView) override;
 
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
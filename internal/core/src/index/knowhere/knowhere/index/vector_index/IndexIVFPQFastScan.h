@@ -0,0 +1,49 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "knowhere/index/vector_index/IndexIVF.h"
+
+namespace milvus {
+namespace knowhere {
+
+// IVF_PQ with 4-bit codes, searched 32 codes at a time with SIMD look-ups. the quantized distances only
+// select the candidates, their distances are exact PQ distances, so results match IVF_PQ with nbits 4.
+class IVFPQFastScan : public IVF {
+ public:
+    IVFPQFastScan() : IVF() {
+        index_type_ = IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN;
+        stats = std::make_shared<milvus::knowhere::IVFStatistics>(index_type_);
+    }
+
+    explicit IVFPQFastScan(std::shared_ptr<faiss::Index> index) : IVF(std::move(index)) {
+        index_type_ = IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN;
+        stats = std::make_shared<milvus::knowhere::IVFStatistics>(index_type_);
+    }
+
+    void
+    Train(const DatasetPtr&, const Config&) override;
+
+    VecIndexPtr
+    CopyCpuToGpu(const int64_t, const Config&) override;
+
+    void
+    UpdateIndexSize() override;
+};
+
+using IVFPQFastScanPtr = std::shared_ptr<IVFPQFastScan>;
+
+}  // namespace knowhere
+}  // namespace milvus
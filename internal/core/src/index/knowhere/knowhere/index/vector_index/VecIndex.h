@@ -49,6 +49,12 @@ class VecIndex : public Index {
     virtual DatasetPtr
     Query(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) = 0;
 
+    // all hits within IndexParams::range_search_radius, see RangeSearchResultToDataset for the layout
+    virtual DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) {
+        KNOWHERE_THROW_MSG("range search is not supported by index type " + index_type_);
+    }
+
     virtual int64_t
     Dim() = 0;
 
@@ -74,6 +80,11 @@ class VecIndex : public Index {
         return index_mode_;
     }
 
+    void
+    SetIndexMode(IndexMode index_mode) {
+        index_mode_ = index_mode;
+    }
+
     std::shared_ptr<std::vector<IDType>>
     GetUids() const {
         return uids_;
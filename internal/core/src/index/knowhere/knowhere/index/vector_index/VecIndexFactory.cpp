@@ -20,6 +20,7 @@
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/IndexNGTONNG.h"
 #include "knowhere/index/vector_index/IndexNGTPANNG.h"
@@ -60,21 +61,36 @@ VecIndexFactory::CreateVecIndex(const IndexType& type, const IndexMode mode) {
             return std::make_shared<knowhere::GPUIVF_NM>(gpu_device);
         }
 #endif
-        return std::make_shared<knowhere::IVF_NM>();
+        auto index = std::make_shared<knowhere::IVF_NM>();
+        if (mode == IndexMode::MODE_MMAP) {
+            index->SetIndexMode(mode);
+        }
+        return index;
     } else if (type == IndexEnum::INDEX_FAISS_IVFPQ) {
 #ifdef MILVUS_GPU_VERSION
         if (mode == IndexMode::MODE_GPU) {
             return std::make_shared<knowhere::GPUIVFPQ>(gpu_device);
         }
 #endif
-        return std::make_shared<knowhere::IVFPQ>();
+        auto index = std::make_shared<knowhere::IVFPQ>();
+        if (mode == IndexMode::MODE_MMAP) {
+            index->SetIndexMode(mode);
+        }
+        return index;
+    } else if (type == IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN) {
+        // blocked lists, no GPU or mmap variant
+        return std::make_shared<knowhere::IVFPQFastScan>();
     } else if (type == IndexEnum::INDEX_FAISS_IVFSQ8) {
 #ifdef MILVUS_GPU_VERSION
         if (mode == IndexMode::MODE_GPU) {
             return std::make_shared<knowhere::GPUIVFSQ>(gpu_device);
         }
 #endif
-        return std::make_shared<knowhere::IVFSQ>();
+        auto index = std::make_shared<knowhere::IVFSQ>();
+        if (mode == IndexMode::MODE_MMAP) {
+            index->SetIndexMode(mode);
+        }
+        return index;
 #ifdef MILVUS_GPU_VERSION
     } else if (type == IndexEnum::INDEX_FAISS_IVFSQ8H) {
         return std::make_shared<knowhere::IVFSQHybrid>(gpu_device);
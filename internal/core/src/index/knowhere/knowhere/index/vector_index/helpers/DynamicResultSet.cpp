@@ -17,6 +17,7 @@
 #include "faiss/impl/AuxIndexStructures.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/helpers/DynamicResultSet.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus {
 namespace knowhere {
@@ -192,5 +193,37 @@ ExchangeDataset(DynamicResultSegment& milvus_dataset, std::vector<faiss::RangeSe
     }
 }
 
+void
+MergeRangeSearchPartialResults(std::vector<faiss::RangeSearchPartialResult*>& partial_results,
+                               faiss::RangeSearchResult& result) {
+    for (auto& pres : partial_results) {
+        if (pres->res != &result) {
+            delete pres->res;
+            pres->res = &result;
+        }
+    }
+    faiss::RangeSearchPartialResult::merge(partial_results, true);
+}
+
+DatasetPtr
+RangeSearchResultToDataset(const faiss::RangeSearchResult& result) {
+    auto nq = result.nq;
+    auto total = result.lims[nq];
+    auto p_lims = static_cast<size_t*>(malloc(sizeof(size_t) * (nq + 1)));
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * total));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * total));
+    memcpy(p_lims, result.lims, sizeof(size_t) * (nq + 1));
+    if (total > 0) {
+        memcpy(p_id, result.labels, sizeof(int64_t) * total);
+        memcpy(p_dist, result.distances, sizeof(float) * total);
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    ret_ds->Set(meta::LIMS, p_lims);
+    return ret_ds;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 #include "faiss/impl/AuxIndexStructures.h"
+#include "knowhere/common/Dataset.h"
 #include "knowhere/common/Typedef.h"
 
 namespace milvus {
@@ -81,5 +82,20 @@ struct DynamicResultCollector {
 void
 ExchangeDataset(DynamicResultSegment& milvus_dataset, std::vector<faiss::RangeSearchPartialResult*>& faiss_dataset);
 
+/*
+ * Gather the partial results of a range search over nq queries into one result,
+ * the partial results are released.
+ */
+void
+MergeRangeSearchPartialResults(std::vector<faiss::RangeSearchPartialResult*>& partial_results,
+                               faiss::RangeSearchResult& result);
+
+/*
+ * Copy a range search result into a dataset of IDS, DISTANCE and LIMS,
+ * hits of query i are IDS[LIMS[i]] ~ IDS[LIMS[i + 1] - 1], not sorted.
+ */
+DatasetPtr
+RangeSearchResultToDataset(const faiss::RangeSearchResult& result);
+
 }  // namespace knowhere
 }  // namespace milvus
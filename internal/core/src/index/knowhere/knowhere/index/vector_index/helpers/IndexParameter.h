@@ -23,6 +23,7 @@ constexpr const char* TENSOR = "tensor";
 constexpr const char* ROWS = "rows";
 constexpr const char* IDS = "ids";
 constexpr const char* DISTANCE = "distance";
+constexpr const char* LIMS = "lims";
 constexpr const char* TOPK = "k";
 constexpr const char* DEVICEID = "gpu_id";
 };  // namespace meta
@@ -32,11 +33,17 @@ namespace IndexParams {
 constexpr const char* range_search_radius = "range_search_radius";
 constexpr const char* range_search_buffer_size = "range_search_buffer_size";
 
+// Refine Params
+constexpr const char* refine_factor = "refine_factor";
+
 // IVF Params
 constexpr const char* nprobe = "nprobe";
 constexpr const char* nlist = "nlist";
 constexpr const char* m = "m";          // PQ
 constexpr const char* nbits = "nbits";  // PQ/SQ
+// IVF adaptive search Params
+constexpr const char* adaptive_patience = "adaptive_patience";
+constexpr const char* adaptive_bound = "adaptive_bound";
 
 // NSG Params
 constexpr const char* knng = "knng";
@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/helpers/MmapInvertedLists.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#include "knowhere/common/Exception.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+constexpr size_t ALIGNMENT = 64;
+constexpr size_t PAGE_SIZE = 4096;
+
+std::mutex mmap_path_mutex;
+std::string mmap_path = "/tmp/milvus/mmap";  // NOLINT
+
+size_t
+AlignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+void
+CreateDirectories(const std::string& path) {
+    for (size_t pos = path.find('/', 1);; pos = path.find('/', pos + 1)) {
+        auto dir = path.substr(0, pos);
+        if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+            KNOWHERE_THROW_MSG("failed to create directory " + dir + ": " + strerror(errno));
+        }
+        if (pos == std::string::npos) {
+            break;
+        }
+    }
+}
+}  // namespace
+
+void
+SetMmapPath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mmap_path_mutex);
+    mmap_path = path;
+}
+
+std::string
+GetMmapPath() {
+    std::lock_guard<std::mutex> lock(mmap_path_mutex);
+    return mmap_path;
+}
+
+std::shared_ptr<uint8_t[]>
+CreateMmapBuffer(size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+    auto path = GetMmapPath();
+    CreateDirectories(path);
+    auto filename = path + "/index_XXXXXX";
+    int fd = mkstemp(filename.data());
+    if (fd < 0) {
+        KNOWHERE_THROW_MSG("failed to create mmap file " + filename + ": " + strerror(errno));
+    }
+    unlink(filename.c_str());
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        KNOWHERE_THROW_MSG("failed to resize mmap file " + filename + ": " + strerror(errno));
+    }
+    auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        KNOWHERE_THROW_MSG("failed to map " + filename + ": " + strerror(errno));
+    }
+    return std::shared_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(ptr),
+                                      [size](uint8_t* ptr) { munmap(ptr, size); });
+}
+
+MmapInvertedLists::MmapInvertedLists(const faiss::InvertedLists& other, const uint8_t* raw_data)
+    : faiss::ReadOnlyInvertedLists(other.nlist, other.code_size), offsets_(other.nlist + 1, 0) {
+    for (size_t i = 0; i < nlist; i++) {
+        offsets_[i + 1] = offsets_[i] + other.list_size(i);
+    }
+    auto ntotal = offsets_[nlist];
+    ids_offset_ = AlignUp(ntotal * code_size, ALIGNMENT);
+    mapped_size_ = ids_offset_ + ntotal * sizeof(idx_t);
+    buffer_ = CreateMmapBuffer(mapped_size_);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < static_cast<int64_t>(nlist); i++) {
+        auto list_size = other.list_size(i);
+        if (list_size == 0) {
+            continue;
+        }
+        auto codes = buffer_.get() + offsets_[i] * code_size;
+        faiss::InvertedLists::ScopedIds ids(&other, i);
+        if (raw_data != nullptr) {
+            for (size_t j = 0; j < list_size; j++) {
+                memcpy(codes + j * code_size, raw_data + ids[j] * code_size, code_size);
+            }
+        } else {
+            faiss::InvertedLists::ScopedCodes list_codes(&other, i);
+            memcpy(codes, list_codes.get(), list_size * code_size);
+        }
+        memcpy(buffer_.get() + ids_offset_ + offsets_[i] * sizeof(idx_t), ids.get(), list_size * sizeof(idx_t));
+    }
+    // the lists are only read from now on. dropping the pages from the mapping leaves them to the page cache,
+    // which writes them back and reclaims them, searches fault in what they probe
+    if (buffer_ != nullptr) {
+        mprotect(buffer_.get(), mapped_size_, PROT_READ);
+        madvise(buffer_.get(), mapped_size_, MADV_DONTNEED);
+    }
+}
+
+size_t
+MmapInvertedLists::list_size(size_t list_no) const {
+    return offsets_[list_no + 1] - offsets_[list_no];
+}
+
+const uint8_t*
+MmapInvertedLists::get_codes(size_t list_no) const {
+    return buffer_.get() + offsets_[list_no] * code_size;
+}
+
+const faiss::InvertedLists::idx_t*
+MmapInvertedLists::get_ids(size_t list_no) const {
+    return reinterpret_cast<const idx_t*>(buffer_.get() + ids_offset_) + offsets_[list_no];
+}
+
+void
+MmapInvertedLists::prefetch_lists(const idx_t* list_nos, int n) const {
+    auto advise = [&](size_t begin, size_t end) {
+        if (begin == end) {
+            return;
+        }
+        begin = begin / PAGE_SIZE * PAGE_SIZE;
+        madvise(buffer_.get() + begin, end - begin, MADV_WILLNEED);
+    };
+    // the lists of each query come in probe order, the kernel starts reading the nearest first
+    for (int i = 0; i < n; i++) {
+        auto list_no = list_nos[i];
+        if (list_no < 0 || list_size(list_no) == 0) {
+            continue;
+        }
+        advise(offsets_[list_no] * code_size, offsets_[list_no + 1] * code_size);
+        advise(ids_offset_ + offsets_[list_no] * sizeof(idx_t), ids_offset_ + offsets_[list_no + 1] * sizeof(idx_t));
+    }
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,79 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <faiss/InvertedLists.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace knowhere {
+
+// directory of the files MODE_MMAP indexes map their inverted lists from
+void
+SetMmapPath(const std::string& path);
+
+std::string
+GetMmapPath();
+
+// shared mapping of a new file of the given size under the mmap path. the file is unlinked right away, its
+// pages are written back to it and dropped by the kernel when memory is short, and freed with the mapping.
+std::shared_ptr<uint8_t[]>
+CreateMmapBuffer(size_t size);
+
+// read-only inverted lists in a mapped file: the codes of all lists back to back, then their ids. only the
+// list offsets stay in memory, prefetch_lists asks the kernel to read the probed lists ahead in probe order.
+struct MmapInvertedLists : public faiss::ReadOnlyInvertedLists {
+    // copies the lists of other. the IVF_NM lists keep only ids, their codes are gathered from the rows of
+    // raw_data instead, which arranges the raw data list by list as IVF_NM searches it.
+    explicit MmapInvertedLists(const faiss::InvertedLists& other, const uint8_t* raw_data = nullptr);
+
+    size_t
+    list_size(size_t list_no) const override;
+
+    const uint8_t*
+    get_codes(size_t list_no) const override;
+
+    const idx_t*
+    get_ids(size_t list_no) const override;
+
+    void
+    prefetch_lists(const idx_t* list_nos, int nlist) const override;
+
+    // bytes mapped from the file
+    size_t
+    mapped_size() const {
+        return mapped_size_;
+    }
+
+    // codes of all lists back to back, list_no starts at row offset(list_no)
+    std::shared_ptr<uint8_t[]>
+    codes() const {
+        return buffer_;
+    }
+
+    size_t
+    offset(size_t list_no) const {
+        return offsets_[list_no];
+    }
+
+ private:
+    std::vector<size_t> offsets_;
+    size_t ids_offset_ = 0;
+    size_t mapped_size_ = 0;
+    std::shared_ptr<uint8_t[]> buffer_;
+};
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -34,6 +34,7 @@
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "knowhere/index/vector_index/helpers/MmapInvertedLists.h"
 #include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
 #ifdef MILVUS_GPU_VERSION
 #include "knowhere/index/vector_index/gpu/IndexGPUIVF.h"
@@ -51,6 +52,10 @@ IVF_NM::Serialize(const Config& config) {
         KNOWHERE_THROW_MSG("index not initialize or trained");
     }
 
+    if (index_mode_ == IndexMode::MODE_MMAP) {
+        KNOWHERE_THROW_MSG("can not serialize an index with mapped inverted lists");
+    }
+
     auto ret = SerializeImpl(index_type_);
     if (config.contains(INDEX_FILE_SLICE_SIZE_IN_MEGABYTE)) {
         Disassemble(config[INDEX_FILE_SLICE_SIZE_IN_MEGABYTE].get<int64_t>() * 1024 * 1024, ret);
@@ -76,19 +81,31 @@ IVF_NM::Load(const BinarySet& binary_set) {
         ivf_index->nprobe_statistics.resize(invlists->nlist, 0);
     }
 
+    if (index_mode_ == IndexMode::MODE_MMAP) {
+        // the arranged data are the codes of the mapped lists, only the quantizer stays in memory
+        auto mmap_invlists = new MmapInvertedLists(*invlists, binary->data.get());
+        ivf_index->replace_invlists(mmap_invlists, true);
+        for (size_t i = 0; i < mmap_invlists->nlist; i++) {
+            prefix_sum[i] = mmap_invlists->offset(i);
+        }
+        data_ = mmap_invlists->codes();
+        return;
+    }
+
 #ifndef MILVUS_GPU_VERSION
-    auto ails = dynamic_cast<faiss::ArrayInvertedLists*>(invlists);
     size_t nb = binary->size / invlists->code_size;
     auto arranged_data = new float[d * nb];
     for (size_t i = 0; i < invlists->nlist; i++) {
-        auto list_size = ails->ids[i].size();
+        auto list_size = invlists->list_size(i);
+        faiss::InvertedLists::ScopedIds list_ids(invlists, i);
         for (size_t j = 0; j < list_size; j++) {
-            memcpy(arranged_data + d * (curr_index + j), original_data + d * ails->ids[i][j], d * sizeof(float));
+            memcpy(arranged_data + d * (curr_index + j), original_data + d * list_ids[j], d * sizeof(float));
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
     }
     data_ = std::shared_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(arranged_data));
+    ivf_index->compute_list_radii(data_.get(), prefix_sum.data(), d * sizeof(float));
 #else
     auto rol = dynamic_cast<faiss::ReadOnlyArrayInvertedLists*>(invlists);
     auto arranged_data = reinterpret_cast<float*>(rol->pin_readonly_codes->data);
@@ -334,6 +351,14 @@ IVF_NM::QueryImpl(int64_t n,
     } else {
         ivf_index->parallel_mode = 0;
     }
+    ivf_index->adaptive_patience =
+        config.contains(IndexParams::adaptive_patience) ? config[IndexParams::adaptive_patience].get<int64_t>() : 0;
+    ivf_index->adaptive_bound =
+        config.contains(IndexParams::adaptive_bound) && config[IndexParams::adaptive_bound].get<bool>();
+    if (ivf_index->adaptive_patience > 0 || ivf_index->adaptive_bound) {
+        // the adaptive termination works per query
+        ivf_index->parallel_mode = 0;
+    }
     bool is_sq8 = (index_type_ == IndexEnum::INDEX_FAISS_IVFSQ8) ? true : false;
 
 #ifndef MILVUS_GPU_VERSION
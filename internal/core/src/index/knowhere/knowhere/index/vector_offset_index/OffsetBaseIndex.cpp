@@ -46,7 +46,8 @@ OffsetBaseIndex::LoadImpl(const BinarySet& binary_set, const IndexType& type) {
     reader.total = binary->size;
     reader.data_ = binary->data.get();
 
-    faiss::Index* index = faiss::read_index_nm(&reader);
+    // loaded indexes are sealed, their inverted lists are read into one packed buffer
+    faiss::Index* index = faiss::read_index_nm(&reader, faiss::IO_FLAG_READ_ONLY);
     index_.reset(index);
 
     SealImpl();
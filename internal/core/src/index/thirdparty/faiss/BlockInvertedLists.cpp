@@ -0,0 +1,104 @@
+// -*- c++ -*-
+
+#include <faiss/BlockInvertedLists.h>
+
+#include <cassert>
+#include <cstring>
+
+#include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/PQ4FastScan.h>
+
+namespace faiss {
+
+BlockInvertedLists::BlockInvertedLists (size_t nlist, size_t M,
+                                        size_t code_size):
+    InvertedLists (nlist, code_size),
+    M (M), block_size (pq4_block_bytes (M))
+{
+    FAISS_THROW_IF_NOT (code_size == (M + 1) / 2);
+    ids.resize (nlist);
+    codes.resize (nlist);
+}
+
+size_t BlockInvertedLists::list_blocks (size_t list_no) const
+{
+    return (ids[list_no].size() + PQ4_BLOCK_SIZE - 1) / PQ4_BLOCK_SIZE;
+}
+
+size_t BlockInvertedLists::list_size (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return ids[list_no].size();
+}
+
+const uint8_t * BlockInvertedLists::get_codes (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return codes[list_no].data();
+}
+
+const InvertedLists::idx_t * BlockInvertedLists::get_ids (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return ids[list_no].data();
+}
+
+const uint8_t * BlockInvertedLists::get_single_code (
+            size_t list_no, size_t offset) const
+{
+    assert (offset < ids[list_no].size());
+    uint8_t *code = new uint8_t [code_size];
+    const uint8_t *block =
+        codes[list_no].data() + offset / PQ4_BLOCK_SIZE * block_size;
+    pq4_unpack_code (block, M, offset % PQ4_BLOCK_SIZE, code);
+    return code;
+}
+
+void BlockInvertedLists::release_codes (size_t list_no,
+                                        const uint8_t *codes_in) const
+{
+    // only the single codes are allocated
+    if (codes_in != codes[list_no].data()) {
+        delete [] codes_in;
+    }
+}
+
+size_t BlockInvertedLists::add_entries (
+           size_t list_no, size_t n_entry,
+           const idx_t* ids_in, const uint8_t *code)
+{
+    if (n_entry == 0) return 0;
+    assert (list_no < nlist);
+    size_t o = ids[list_no].size();
+    ids[list_no].resize (o + n_entry);
+    memcpy (&ids[list_no][o], ids_in, sizeof (ids_in[0]) * n_entry);
+    codes[list_no].resize (list_blocks (list_no) * block_size, 0);
+    update_entries (list_no, o, n_entry, ids_in, code);
+    return o;
+}
+
+void BlockInvertedLists::update_entries (
+      size_t list_no, size_t offset, size_t n_entry,
+      const idx_t *ids_in, const uint8_t *codes_in)
+{
+    assert (list_no < nlist);
+    assert (n_entry + offset <= ids[list_no].size());
+    memcpy (&ids[list_no][offset], ids_in, sizeof(ids_in[0]) * n_entry);
+    for (size_t i = 0; i < n_entry; i++) {
+        size_t j = offset + i;
+        uint8_t *block =
+            codes[list_no].data() + j / PQ4_BLOCK_SIZE * block_size;
+        pq4_pack_code (codes_in + i * code_size, M, j % PQ4_BLOCK_SIZE, block);
+    }
+}
+
+void BlockInvertedLists::resize (size_t list_no, size_t new_size)
+{
+    ids[list_no].resize (new_size);
+    codes[list_no].resize (list_blocks (list_no) * block_size, 0);
+}
+
+BlockInvertedLists::~BlockInvertedLists ()
+{}
+
+} // namespace faiss
@@ -0,0 +1,53 @@
+// -*- c++ -*-
+
+#ifndef FAISS_BLOCK_INVERTED_LISTS_H
+#define FAISS_BLOCK_INVERTED_LISTS_H
+
+#include <vector>
+
+#include <faiss/InvertedLists.h>
+
+namespace faiss {
+
+/** Inverted lists of 4-bit PQ codes in the blocked layout of
+ * impl/PQ4FastScan.h, for IndexIVFPQFastScan.
+ *
+ * Codes come in and go out (get_single_code) packed as ProductQuantizer
+ * does, code_size bytes per vector. get_codes returns the blocks, the last
+ * one padded with zero codes.
+ */
+struct BlockInvertedLists: InvertedLists {
+    size_t M;                  ///< number of 4-bit sub-quantizers
+    size_t block_size;         ///< bytes per block of 32 codes
+
+    std::vector<std::vector<uint8_t> > codes;  ///< blocks, size nlist
+    std::vector<std::vector<idx_t> > ids;      ///< ids, size nlist
+
+    BlockInvertedLists (size_t nlist, size_t M, size_t code_size);
+
+    /// number of blocks of a list
+    size_t list_blocks (size_t list_no) const;
+
+    size_t list_size (size_t list_no) const override;
+    const uint8_t * get_codes (size_t list_no) const override;
+    const idx_t * get_ids (size_t list_no) const override;
+
+    const uint8_t * get_single_code (
+                size_t list_no, size_t offset) const override;
+    void release_codes (size_t list_no, const uint8_t *codes) const override;
+
+    size_t add_entries (
+           size_t list_no, size_t n_entry,
+           const idx_t* ids, const uint8_t *code) override;
+
+    void update_entries (size_t list_no, size_t offset, size_t n_entry,
+                         const idx_t *ids, const uint8_t *code) override;
+
+    void resize (size_t list_no, size_t new_size) override;
+
+    ~BlockInvertedLists () override;
+};
+
+} // namespace faiss
+
+#endif
@@ -10,6 +10,7 @@
 #include <faiss/Clustering.h>
 #include <faiss/impl/AuxIndexStructures.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -19,6 +20,7 @@
 #include <faiss/utils/utils.h>
 #include <faiss/utils/random.h>
 #include <faiss/utils/distances.h>
+#include <faiss/utils/Heap.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/FaissHook.h>
 #include <faiss/IndexFlat.h>
@@ -36,7 +38,8 @@ ClusteringParameters::ClusteringParameters ():
     min_points_per_centroid(39),
     max_points_per_centroid(256),
     seed(1234),
-    decode_block_size(32768)
+    decode_block_size(32768),
+    prune_assign(true)
 {}
 // 39 corresponds to 10000 / 256 -> to avoid warnings on PQ tests with randu10k
 
@@ -101,9 +104,17 @@ idx_t subsample_training_set(
         printf("Sampling a subset of %ld / %ld for training\n",
                clus.k * clus.max_points_per_centroid, nx);
     }
-    std::vector<int> perm (nx);
-    rand_perm (perm.data (), nx, clus.seed);
-    nx = clus.k * clus.max_points_per_centroid;
+    // one point from each of nx_new equal strata: the input is in insertion
+    // order, so the sample covers all of it, and no permutation of nx
+    idx_t nx_new = clus.k * clus.max_points_per_centroid;
+    std::vector<idx_t> perm (nx_new);
+    RandomGenerator rng (clus.seed);
+    for (idx_t i = 0; i < nx_new; i++) {
+        idx_t lo = i * nx / nx_new;
+        idx_t hi = (i + 1) * nx / nx_new;
+        perm[i] = lo + rng.rand_int64 () % (hi - lo);
+    }
+    nx = nx_new;
     uint8_t * x_new = new uint8_t [nx * line_size];
     *x_out = x_new;
     for (idx_t i = 0; i < nx; i++) {
@@ -259,10 +270,133 @@ int split_clusters (size_t d, size_t k, size_t n,
     return nsplit;
 
 }
+
+/** nearest kk (1 or 2) centroids of the n points with sgemm, by blocks of
+ * points over the threads. The distances are squared L2, sorted.
+ *
+ * IndexFlat only uses sgemm above distance_compute_blas_threshold queries,
+ * the clustering iterations search fewer points than that at a time.
+ */
+void search_centroids_blas (size_t d, size_t n, const float * x,
+                            size_t k, const float * centroids, size_t kk,
+                            int64_t * labels, float * distances)
+{
+    const size_t bs = 1024;
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i0 = 0; i0 < n; i0 += bs) {
+        size_t i1 = std::min (n, i0 + bs);
+        float_maxheap_array_t res = {
+            i1 - i0, kk, labels + i0 * kk, distances + i0 * kk};
+        res.heapify ();
+        knn_add_to_heaps_blas (x + i0 * d, centroids, nullptr,
+                               d, i1 - i0, k, METRIC_L2, nullptr,
+                               kk, distances + i0 * kk, labels + i0 * kk);
+        res.reorder ();
+    }
+}
+
+/** Assignment step that skips the points which keep their centroid.
+ *
+ * lower[i] is a lower bound of the distance of point i to the centroids
+ * other than its own. After an update it loses the largest shift of these
+ * centroids (triangle inequality). If the point is still strictly closer to
+ * its own centroid, the assignment does not change. The others are searched
+ * with search_centroids_blas, which also gives their new bound.
+ *
+ * @param shift   distance each centroid moved in the last update, size k,
+ *                nullptr to search all points
+ * @return        nb of points searched
+ */
+size_t assign_with_bounds (size_t d, size_t n, const float * x,
+                           size_t k, const float * centroids,
+                           const float * shift,
+                           int64_t * assign, float * dis, float * lower)
+{
+    std::vector<uint8_t> todo (n, 1);
+    if (shift) {
+        size_t c_max = std::max_element (shift, shift + k) - shift;
+        float max_shift = shift[c_max], second_shift = 0;
+        for (size_t c = 0; c < k; c++) {
+            if (c != c_max) second_shift = std::max (second_shift, shift[c]);
+        }
+#pragma omp parallel for
+        for (size_t i = 0; i < n; i++) {
+            lower[i] -= assign[i] == c_max ? second_shift : max_shift;
+            dis[i] = fvec_L2sqr (x + i * d, centroids + assign[i] * d, d);
+            todo[i] = !(lower[i] > 0 && dis[i] < lower[i] * lower[i]);
+        }
+    }
+
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < n; i++) {
+        if (todo[i]) ids.push_back (i);
+    }
+
+    // gather the points to search by blocks, to bound the memory
+    const size_t bs = 65536;
+    std::vector<float> xs (std::min (bs, ids.size()) * d);
+    std::vector<float> D (std::min (bs, ids.size()) * 2);
+    std::vector<int64_t> I (std::min (bs, ids.size()) * 2);
+    for (size_t j0 = 0; j0 < ids.size(); j0 += bs) {
+        size_t j1 = std::min (ids.size(), j0 + bs);
+        for (size_t j = j0; j < j1; j++) {
+            memcpy (xs.data() + (j - j0) * d, x + ids[j] * d,
+                    sizeof (float) * d);
+        }
+        search_centroids_blas (d, j1 - j0, xs.data(), k, centroids, 2,
+                               I.data(), D.data());
+        for (size_t j = j0; j < j1; j++) {
+            size_t i = ids[j];
+            assign[i] = I[(j - j0) * 2];
+            dis[i] = D[(j - j0) * 2];
+            lower[i] = sqrtf (D[(j - j0) * 2 + 1]);
+        }
+    }
+    return ids.size();
+}
+
+/** Mini-batch centroid update (Sculley, web-scale k-means): each point
+ * moves its centroid towards it by its weight over the total weight the
+ * centroid got so far. Each thread takes care of a range of centroids.
+ *
+ * @param x        decoded batch, size n * d
+ * @param counts   total weight per centroid, size k, kept between batches
+ */
+void mini_batch_update (size_t d, size_t k, size_t n, size_t k_frozen,
+                        const float * x, const int64_t * assign,
+                        const float * weights, float * counts,
+                        float * centroids)
+{
+#pragma omp parallel
+    {
+        int nt = omp_get_num_threads();
+        int rank = omp_get_thread_num();
+
+        size_t c0 = k_frozen + ((k - k_frozen) * rank) / nt;
+        size_t c1 = k_frozen + ((k - k_frozen) * (rank + 1)) / nt;
+
+        for (size_t i = 0; i < n; i++) {
+            size_t ci = assign[i];
+            float w = weights ? weights[i] : 1;
+            if (ci < c0 || ci >= c1 || w == 0) {
+                continue;
+            }
+            counts[ci] += w;
+            float eta = w / counts[ci];
+            float * c = centroids + ci * d;
+            const float * xi = x + i * d;
+            for (size_t j = 0; j < d; j++) {
+                c[j] += eta * (xi[j] - c[j]);
+            }
+        }
+    }
+}
+
 };
 
 ClusteringType clustering_type = ClusteringType::K_MEANS;
 double early_stop_threshold = 0.0;
+int64_t kmeans_mini_batch_size = 0;
 
 void Clustering::kmeans_algorithm(std::vector<int>& centroids_index, int64_t random_seed,
                                   size_t n_input_centroids, size_t d, size_t k,
@@ -370,6 +504,164 @@ void Clustering::kmeans_plus_plus_algorithm(std::vector<int>& centroids_index, i
     }
 }   
 
+void Clustering::kmeans_parallel_algorithm(std::vector<int>& centroids_index, int64_t random_seed,
+                                           size_t n_input_centroids, size_t d,
+                                           size_t k, idx_t nx, const uint8_t *x_in)
+{
+    FAISS_THROW_IF_NOT_MSG (
+       n_input_centroids == 0,
+       "Kmeans|| only support the provided input centroids number of zero"
+    );
+
+    auto x = reinterpret_cast<const float*>(x_in);
+    RandomGenerator rng (random_seed);
+
+    // 1. oversampling rounds. min_dis is the squared distance of each point
+    //    to the candidates, nearest the candidate it is closest to
+    const int n_rounds = 5;
+    const double oversampling = std::max<size_t> (k / 2, 1);
+
+    std::vector<idx_t> candidates (1, rng.rand_int64 () % nx);
+    std::vector<uint8_t> picked (nx, 0);
+    picked[candidates[0]] = 1;
+    std::vector<float> min_dis (nx);
+    std::vector<idx_t> nearest (nx, 0);
+#pragma omp parallel for
+    for (idx_t i = 0; i < nx; i++) {
+        min_dis[i] = fvec_L2sqr (x + i * d, x + candidates[0] * d, d);
+    }
+
+    std::vector<float> round_x, round_dis (nx);
+    std::vector<int64_t> round_nearest (nx);
+    for (int r = 0; r < n_rounds; r++) {
+        double phi = 0;
+        for (idx_t i = 0; i < nx; i++) {
+            phi += min_dis[i];
+        }
+        if (phi == 0) {
+            break;
+        }
+
+        size_t n0 = candidates.size();
+        for (idx_t i = 0; i < nx; i++) {
+            if (!picked[i] && rng.rand_double () * phi < oversampling * min_dis[i]) {
+                picked[i] = 1;
+                candidates.push_back (i);
+            }
+        }
+        size_t m = candidates.size() - n0;
+        if (m == 0) {
+            continue;
+        }
+
+        round_x.resize (m * d);
+        for (size_t j = 0; j < m; j++) {
+            memcpy (round_x.data() + j * d, x + candidates[n0 + j] * d,
+                    sizeof (float) * d);
+        }
+        search_centroids_blas (d, nx, x, m, round_x.data(), 1,
+                               round_nearest.data(), round_dis.data());
+        for (idx_t i = 0; i < nx; i++) {
+            if (round_dis[i] < min_dis[i]) {
+                min_dis[i] = round_dis[i];
+                nearest[i] = n0 + round_nearest[i];
+            }
+        }
+    }
+
+    // too few candidates (many duplicate points): complete with random ones
+    while (candidates.size() < k) {
+        idx_t i = rng.rand_int64 () % nx;
+        if (!picked[i]) {
+            picked[i] = 1;
+            candidates.push_back (i);
+        }
+    }
+
+    // 2. weight of a candidate: the nb of points closest to it
+    size_t nc = candidates.size();
+    std::vector<double> weight (nc, 0);
+    for (idx_t i = 0; i < nx; i++) {
+        weight[nearest[i]] += 1;
+    }
+    std::vector<float> cx (nc * d);
+    for (size_t c = 0; c < nc; c++) {
+        memcpy (cx.data() + c * d, x + candidates[c] * d, sizeof (float) * d);
+    }
+
+    // 3. weighted kmeans++ on the candidates. A pass draws up to k / 64
+    //    centers before the distances are updated, which does not change
+    //    much as there are only a few per pass
+    std::vector<float> cand_dis (nc, HUGE_VALF);
+    std::vector<uint8_t> chosen (nc, 0);
+    std::vector<size_t> result, pending;
+    std::vector<double> pre_sum (nc);
+    const size_t batch = std::max<size_t> (1, k / 64);
+
+    // the first one with probability proportional to its weight
+    for (size_t c = 0; c < nc; c++) {
+        pre_sum[c] = (c == 0 ? 0 : pre_sum[c - 1]) + std::max (weight[c], 1e-6);
+    }
+    size_t first = std::upper_bound (pre_sum.begin(), pre_sum.end(),
+                                     rng.rand_double () * pre_sum[nc - 1])
+        - pre_sum.begin();
+    first = std::min (first, nc - 1);
+    chosen[first] = 1;
+    result.push_back (first);
+    pending.push_back (first);
+
+    std::vector<float> pending_x, pending_dis (nc);
+    std::vector<int64_t> pending_nearest (nc);
+    while (true) {
+        pending_x.resize (pending.size() * d);
+        for (size_t j = 0; j < pending.size(); j++) {
+            memcpy (pending_x.data() + j * d, cx.data() + pending[j] * d,
+                    sizeof (float) * d);
+        }
+        search_centroids_blas (d, nc, cx.data(), pending.size(),
+                               pending_x.data(), 1,
+                               pending_nearest.data(), pending_dis.data());
+        for (size_t c = 0; c < nc; c++) {
+            cand_dis[c] = chosen[c] ? 0 : std::min (cand_dis[c], pending_dis[c]);
+        }
+        pending.clear();
+        if (result.size() == k) {
+            break;
+        }
+
+        for (size_t c = 0; c < nc; c++) {
+            pre_sum[c] = (c == 0 ? 0 : pre_sum[c - 1]) + weight[c] * cand_dis[c];
+        }
+        double total = pre_sum[nc - 1];
+        size_t n_draw = std::min (batch, k - result.size());
+        if (total == 0) {
+            // the remaining candidates coincide with chosen ones
+            for (size_t c = 0; c < nc && pending.size() < n_draw; c++) {
+                if (!chosen[c]) pending.push_back (c);
+            }
+        } else {
+            for (size_t j = 0; j < n_draw; j++) {
+                size_t c = std::upper_bound (pre_sum.begin(), pre_sum.end(),
+                                             rng.rand_double () * total)
+                    - pre_sum.begin();
+                c = std::min (c, nc - 1);
+                if (!chosen[c] && cand_dis[c] > 0) {
+                    chosen[c] = 1;
+                    pending.push_back (c);
+                }
+            }
+        }
+        for (auto c : pending) {
+            chosen[c] = 1;
+            result.push_back (c);
+        }
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        centroids_index[i] = candidates[result[i]];
+    }
+}
+
 void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
                                 const Index * codec, Index & index,
                                 const float *weights) {
@@ -484,22 +776,42 @@ void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
     std::vector<float> decode_buffer
         (codec ? d * decode_block_size : 0);
 
+    // float points assigned with sgemm and bounds, see assign_with_bounds
+    bool blas_assign = prune_assign && !codec && !update_index &&
+        index.metric_type == METRIC_L2 &&
+        dynamic_cast<IndexFlat *>(&index) != nullptr;
+    std::vector<float> lower (blas_assign ? nx : 0);
+    std::vector<float> shift (blas_assign ? k : 0);
+    std::vector<float> prev_centroids;
+
+    // mini-batch iterations on decoded samples of the training set
+    size_t batch_size = kmeans_mini_batch_size;
+    bool mini_batch = batch_size > 0 && batch_size < nx;
+    std::vector<float> batch_x (mini_batch ? batch_size * d : 0);
+    std::vector<float> batch_weights (mini_batch && weights ? batch_size : 0);
+    std::vector<float> counts (mini_batch ? k : 0);
+
     for (int redo = 0; redo < nredo; redo++) {
 
         if (verbose && nredo > 1) {
             printf("Outer iteration %d / %d\n", redo, nredo);
         }
 
+        int64_t random_seed = seed + 1 + redo * 15486557L;
         {
-            int64_t random_seed = seed + 1 + redo * 15486557L;
             std::vector<int> centroids_index(nx);
 
+            // the seeding draws from the sampled points x
             if (ClusteringType::K_MEANS == clustering_type) {
                 //Use classic kmeans algorithm
-                kmeans_algorithm(centroids_index, random_seed, n_input_centroids, d, k, nx, x_in);
+                kmeans_algorithm(centroids_index, random_seed, n_input_centroids, d, k, nx, x);
             } else if (ClusteringType::K_MEANS_PLUS_PLUS == clustering_type) {
                 //Use kmeans++ algorithm
-                kmeans_plus_plus_algorithm(centroids_index, random_seed, n_input_centroids, d, k, nx, x_in);
+                kmeans_plus_plus_algorithm(centroids_index, random_seed, n_input_centroids, d, k, nx, x);
+            } else if (ClusteringType::K_MEANS_PARALLEL == clustering_type) {
+                //Use kmeans|| algorithm
+                FAISS_THROW_IF_NOT_MSG (!codec, "Kmeans|| needs float input");
+                kmeans_parallel_algorithm(centroids_index, random_seed, n_input_centroids, d, k, nx, x);
             } else {
                 FAISS_THROW_FMT ("Clustering Type is knonws: %d", (int)clustering_type);
             }
@@ -534,10 +846,45 @@ void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
 
         float err = 0;
         float prev_objective = 0;
+        RandomGenerator batch_rng (random_seed);
+        std::fill (counts.begin(), counts.end(), 0);
+        size_t k_frozen = frozen_centroids ? n_input_centroids : 0;
         for (int i = 0; i < niter; i++) {
             double t0s = getmillisecs();
 
-            if (!codec) {
+            // points of this iteration
+            size_t n_iter = nx;
+            if (mini_batch) {
+                n_iter = batch_size;
+                for (size_t j = 0; j < batch_size; j++) {
+                    idx_t src = batch_rng.rand_int64 () % nx;
+                    if (!codec) {
+                        memcpy (&batch_x[j * d], x + src * line_size, line_size);
+                    } else {
+                        codec->sa_decode (1, x + src * line_size, &batch_x[j * d]);
+                    }
+                    if (weights) {
+                        batch_weights[j] = weights[src];
+                    }
+                }
+            }
+
+            if (mini_batch && blas_assign) {
+                search_centroids_blas (d, n_iter, batch_x.data(), k,
+                                       centroids.data(), 1,
+                                       assign.get(), dis.get());
+            } else if (mini_batch) {
+                index.assign (n_iter, batch_x.data(), assign.get(), dis.get());
+            } else if (blas_assign) {
+                size_t n_search = assign_with_bounds (
+                      d, nx, reinterpret_cast<const float *>(x), k,
+                      centroids.data(), i == 0 ? nullptr : shift.data(),
+                      assign.get(), dis.get(), lower.data());
+                if (verbose) {
+                    printf ("  Iteration %d: searched %zd / %ld points\n",
+                            i, n_search, nx);
+                }
+            } else if (!codec) {
                 index.assign (nx, reinterpret_cast<const float *>(x),
                               assign.get(), dis.get());
             } else {
@@ -556,31 +903,45 @@ void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
             InterruptCallback::check();
             t_search_tot += getmillisecs() - t0s;
 
-            // accumulate error
+            // accumulate error, scaled to the training set for a batch
             err = 0;
-            for (int j = 0; j < nx; j++) {
+            for (size_t j = 0; j < n_iter; j++) {
                 err += dis[j];
             }
+            err *= float(nx) / n_iter;
 
             // update the centroids
-            std::vector<float> hassign (k);
+            int nsplit = 0;
+            if (mini_batch) {
+                mini_batch_update (
+                      d, k, n_iter, k_frozen,
+                      batch_x.data(), assign.get(),
+                      weights ? batch_weights.data() : nullptr,
+                      counts.data(), centroids.data()
+                );
+            } else {
+                if (blas_assign) {
+                    prev_centroids = centroids;
+                }
+
+                std::vector<float> hassign (k);
 
-            size_t k_frozen = frozen_centroids ? n_input_centroids : 0;
-            compute_centroids (
-                  d, k, nx, k_frozen,
-                  x, codec, assign.get(), weights,
-                  hassign.data(), centroids.data()
-            );
+                compute_centroids (
+                      d, k, nx, k_frozen,
+                      x, codec, assign.get(), weights,
+                      hassign.data(), centroids.data()
+                );
 
-            int nsplit = split_clusters (
-                  d, k, nx, k_frozen,
-                  hassign.data(), centroids.data()
-            );
+                nsplit = split_clusters (
+                      d, k, nx, k_frozen,
+                      hassign.data(), centroids.data()
+                );
+            }
 
             // collect statistics
             ClusteringIterationStats stats =
                 { err, (getmillisecs() - t0) / 1000.0,
-                  t_search_tot / 1000, imbalance_factor (nx, k, assign.get()),
+                  t_search_tot / 1000, imbalance_factor (n_iter, k, assign.get()),
                   nsplit };
             iteration_stats.push_back(stats);
 
@@ -594,6 +955,13 @@ void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
 
             post_process_centroids ();
 
+            if (blas_assign && !mini_batch) {
+                for (size_t c = 0; c < k; c++) {
+                    shift[c] = sqrtf (fvec_L2sqr (&centroids[c * d],
+                                                  &prev_centroids[c * d], d));
+                }
+            }
+
             // add centroids to index for the next iteration (or for output)
 
             index.reset ();
@@ -603,10 +971,11 @@ void Clustering::train_encoded (idx_t nx, const uint8_t *x_in,
 
             index.add (k, centroids.data());
 
-            // Early stop strategy
+            // Early stop strategy, not on the objectives of the batches
+            // that go up and down
             float diff = (prev_objective == 0) ? std::numeric_limits<float>::max() : (prev_objective - stats.obj) / prev_objective;
             prev_objective = stats.obj;
-            if (diff < early_stop_threshold / 100.) {
+            if (!mini_batch && diff < early_stop_threshold / 100.) {
                 break;
             }
 
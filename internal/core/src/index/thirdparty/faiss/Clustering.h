@@ -23,6 +23,7 @@ enum ClusteringType
     K_MEANS,
     K_MEANS_PLUS_PLUS,
     K_MEANS_TWO,
+    K_MEANS_PARALLEL,   ///< k-means|| seeding, a few oversampling rounds
 };
 
 // The default algorithm use the K_MEANS
@@ -31,6 +32,9 @@ extern ClusteringType clustering_type;
 // K-Means Early Stop Threshold; defaults to 0.0
 extern double early_stop_threshold;
 
+// Points per mini-batch iteration of K-Means; defaults to 0, full iterations
+extern int64_t kmeans_mini_batch_size;
+
 
 /** Class for the clustering parameters. Can be passed to the
  * constructor of the Clustering object.
@@ -52,6 +56,13 @@ struct ClusteringParameters {
 
     size_t decode_block_size;  ///< how many vectors at a time to decode
 
+    /** with float input and an L2 IndexFlat, assign with sgemm and keep a
+     * lower bound of the distance to the second nearest centroid: the
+     * points whose bound is not passed after a centroid update keep their
+     * centroid without a search. The assignment is the same as without,
+     * up to float rounding. */
+    bool prune_assign;
+
     /// sets reasonable defaults
     ClusteringParameters ();
 };
@@ -122,6 +133,16 @@ struct Clustering: ClusteringParameters {
                                     size_t n_input_centroids, size_t d, size_t k,
                                     idx_t nx, const uint8_t *x_in);
 
+    /**
+     * @brief Kmeans|| algorithm: a few rounds sample about k/2 points each
+     * with probability proportional to their squared distance to the
+     * sampled set, then a weighted kmeans++ reduces the candidates to k.
+     * Takes the same arguments as kmeans_plus_plus_algorithm.
+     */
+    void kmeans_parallel_algorithm(std::vector<int>& centroids_index, int64_t random_seed,
+                                   size_t n_input_centroids, size_t d, size_t k,
+                                   idx_t nx, const uint8_t *x_in);
+
     /** run with encoded vectors
      *
      * win addition to train()'s parameters takes a codec as parameter
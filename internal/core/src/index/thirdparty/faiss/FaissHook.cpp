@@ -6,6 +6,9 @@
 
 #include <faiss/FaissHook.h>
 #include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/PQ4FastScan.h>
+#include <faiss/impl/PQ4FastScan_avx.h>
+#include <faiss/impl/PQ4FastScan_avx512.h>
 #include <faiss/impl/ScalarQuantizerDC.h>
 #include <faiss/impl/ScalarQuantizerDC_avx.h>
 #include <faiss/impl/ScalarQuantizerDC_avx512.h>
@@ -26,10 +29,15 @@ fvec_func_ptr fvec_L2sqr = fvec_L2sqr_avx;
 fvec_func_ptr fvec_L1 = fvec_L1_avx;
 fvec_func_ptr fvec_Linf = fvec_Linf_avx;
 
+i8vec_func_ptr i8vec_inner_product = i8vec_inner_product_avx;
+i8vec_func_ptr i8vec_L2sqr = i8vec_L2sqr_avx;
+
 sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_computer_avx;
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+pq4_accumulate_func_ptr pq4_accumulate = pq4_accumulate_avx;
+
 /*****************************************************************************/
 
 bool support_avx512() {
@@ -41,6 +49,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vnni() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VNNI());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -66,11 +81,23 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_avx512;
         fvec_Linf = fvec_Linf_avx512;
 
+        /* for int8 vectors */
+        if (support_avx512_vnni()) {
+            i8vec_inner_product = i8vec_inner_product_avx512_vnni;
+            i8vec_L2sqr = i8vec_L2sqr_avx512_vnni;
+        } else {
+            i8vec_inner_product = i8vec_inner_product_avx512;
+            i8vec_L2sqr = i8vec_L2sqr_avx512;
+        }
+
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx512;
         sq_sel_quantizer = sq_select_quantizer_avx512;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx512;
 
+        /* for IVFPQ fast scan */
+        pq4_accumulate = pq4_accumulate_avx512;
+
         cpu_flag = "AVX512";
     } else if (support_avx2()) {
         /* for IVFFLAT */
@@ -79,11 +106,18 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_avx;
         fvec_Linf = fvec_Linf_avx;
 
+        /* for int8 vectors */
+        i8vec_inner_product = i8vec_inner_product_avx;
+        i8vec_L2sqr = i8vec_L2sqr_avx;
+
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_avx;
         sq_sel_quantizer = sq_select_quantizer_avx;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+        /* for IVFPQ fast scan */
+        pq4_accumulate = pq4_accumulate_avx;
+
         cpu_flag = "AVX2";
     } else if (support_sse()) {
         /* for IVFFLAT */
@@ -92,11 +126,18 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_sse;
         fvec_Linf = fvec_Linf_sse;
 
+        /* for int8 vectors */
+        i8vec_inner_product = i8vec_inner_product_ref;
+        i8vec_L2sqr = i8vec_L2sqr_ref;
+
         /* for IVFSQ */
         sq_get_distance_computer = sq_get_distance_computer_ref;
         sq_sel_quantizer = sq_select_quantizer_ref;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_ref;
 
+        /* for IVFPQ fast scan */
+        pq4_accumulate = pq4_accumulate_sse;
+
         cpu_flag = "SSE42";
     } else {
         cpu_flag = "UNSUPPORTED";
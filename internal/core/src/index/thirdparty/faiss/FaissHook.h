@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <faiss/impl/ScalarQuantizer.h>
 #include <faiss/impl/ScalarQuantizerOp.h>
@@ -13,10 +14,12 @@
 namespace faiss {
 
 typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
+typedef int32_t (*i8vec_func_ptr)(const int8_t*, const int8_t*, size_t);
 
 typedef SQDistanceComputer* (*sq_get_distance_computer_func_ptr)(MetricType, QuantizerType, size_t, const std::vector<float>&);
 typedef Quantizer* (*sq_sel_quantizer_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
 typedef InvertedListScanner* (*sq_sel_inv_list_scanner_func_ptr)(MetricType, const ScalarQuantizer*, const Index*, size_t, bool, bool);
+typedef void (*pq4_accumulate_func_ptr)(size_t, size_t, const uint8_t*, const uint8_t*, uint16_t*);
 
 extern bool faiss_use_avx512;
 extern bool faiss_use_avx2;
@@ -27,11 +30,17 @@ extern fvec_func_ptr fvec_L2sqr;
 extern fvec_func_ptr fvec_L1;
 extern fvec_func_ptr fvec_Linf;
 
+extern i8vec_func_ptr i8vec_inner_product;
+extern i8vec_func_ptr i8vec_L2sqr;
+
 extern sq_get_distance_computer_func_ptr sq_get_distance_computer;
 extern sq_sel_quantizer_func_ptr sq_sel_quantizer;
 extern sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner;
 
+extern pq4_accumulate_func_ptr pq4_accumulate;
+
 extern bool support_avx512();
+extern bool support_avx512_vnni();
 extern bool support_avx2();
 extern bool support_sse();
 
@@ -12,8 +12,12 @@
 
 #include <omp.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <iostream>
 
 #include <faiss/utils/utils.h>
@@ -22,6 +26,7 @@
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/IndexFlat.h>
 #include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/BlockInvertedLists.h>
 
 namespace faiss {
 
@@ -174,7 +179,12 @@ IndexIVF::IndexIVF (Index * quantizer, size_t d,
     code_size (code_size),
     nprobe (1),
     max_codes (0),
-    parallel_mode (0)
+    parallel_mode (0),
+    list_major_ratio (8),
+    adaptive_patience (0),
+    adaptive_bound (false),
+    max_list_radius (0),
+    radii_ntotal (-1)
 {
     FAISS_THROW_IF_NOT (d == quantizer->d);
     is_trained = quantizer->is_trained && (quantizer->ntotal == nlist);
@@ -190,7 +200,9 @@ IndexIVF::IndexIVF (Index * quantizer, size_t d,
 IndexIVF::IndexIVF ():
     invlists (nullptr), own_invlists (false),
     code_size (0),
-    nprobe (1), max_codes (0), parallel_mode (0) {
+    nprobe (1), max_codes (0), parallel_mode (0), list_major_ratio (8),
+    adaptive_patience (0), adaptive_bound (false),
+    max_list_radius (0), radii_ntotal (-1) {
 }
 
 void IndexIVF::add (idx_t n, const float * x)
@@ -421,6 +433,28 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
     int pmode = this->parallel_mode & ~PARALLEL_MODE_NO_HEAP_INIT;
     bool do_heap_init = !(this->parallel_mode & PARALLEL_MODE_NO_HEAP_INIT);
 
+    if (use_list_major (n, nprobe, max_codes, store_pairs)) {
+        search_preassigned_list_major (n, x, k, keys, coarse_dis,
+                                       distances, labels, params, bitset);
+        return;
+    }
+
+    bool use_bound = adaptive_bound && has_list_radii ();
+
+    // adaptive_bound test of a probe against the k-th distance: 1 when
+    // neither it nor the farther probes can improve it, -1 when it cannot
+    auto skip_list = [&] (idx_t key, float cdis, float kth_dis) {
+        if (key < 0 || key >= (idx_t) nlist) {
+            return 0;
+        }
+        float lower = std::sqrt (std::max (cdis, 0.0f));
+        float kth = std::sqrt (kth_dis);
+        if (lower - max_list_radius > kth) {
+            return 1;
+        }
+        return lower - list_radii[key] > kth ? -1 : 0;
+    };
+
     // don't start parallel section if single query
     bool do_parallel =
         pmode == 0 ? n > 1 :
@@ -520,18 +554,34 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 init_result (simi, idxi);
 
                 long nscan = 0;
+                size_t nstale = 0;
 
                 // loop over probes
                 for (size_t ik = 0; ik < nprobe; ik++) {
-                    nscan += scan_one_list (
-                         keys [i * nprobe + ik],
-                         coarse_dis[i * nprobe + ik],
-                         simi, idxi, bitset
+                    idx_t key = keys [i * nprobe + ik];
+                    float cdis = coarse_dis[i * nprobe + ik];
+                    int skip = use_bound ? skip_list (key, cdis, simi[0]) : 0;
+                    if (skip > 0) {
+                        break;
+                    } else if (skip < 0) {
+                        continue;
+                    }
+
+                    size_t nheap0 = nheap;
+                    size_t list_size = scan_one_list (
+                         key, cdis, simi, idxi, bitset
                     );
+                    nscan += list_size;
 
                     if (max_codes && nscan >= max_codes) {
                         break;
                     }
+                    if (adaptive_patience && list_size > 0) {
+                        nstale = nheap == nheap0 ? nstale + 1 : 0;
+                        if (nstale >= adaptive_patience) {
+                            break;
+                        }
+                    }
                 }
 
                 ndis += nscan;
@@ -627,6 +677,30 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
     int pmode = this->parallel_mode & ~PARALLEL_MODE_NO_HEAP_INIT;
     bool do_heap_init = !(this->parallel_mode & PARALLEL_MODE_NO_HEAP_INIT);
 
+    if (use_list_major (n, nprobe, max_codes, store_pairs)) {
+        search_preassigned_list_major (n, x, k, keys, coarse_dis,
+                                       distances, labels, params, bitset,
+                                       arranged_codes, prefix_sum.data(),
+                                       d * (is_sq8 ? sizeof(uint8_t) : sizeof(float)));
+        return;
+    }
+
+    bool use_bound = adaptive_bound && has_list_radii ();
+
+    // adaptive_bound test of a probe against the k-th distance: 1 when
+    // neither it nor the farther probes can improve it, -1 when it cannot
+    auto skip_list = [&] (idx_t key, float cdis, float kth_dis) {
+        if (key < 0 || key >= (idx_t) nlist) {
+            return 0;
+        }
+        float lower = std::sqrt (std::max (cdis, 0.0f));
+        float kth = std::sqrt (kth_dis);
+        if (lower - max_list_radius > kth) {
+            return 1;
+        }
+        return lower - list_radii[key] > kth ? -1 : 0;
+    };
+
     // don't start parallel section if single query
     bool do_parallel =
         pmode == 0 ? n > 1 :
@@ -727,19 +801,34 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
                 init_result (simi, idxi);
 
                 long nscan = 0;
+                size_t nstale = 0;
 
                 // loop over probes
                 for (size_t ik = 0; ik < nprobe; ik++) {
-                    nscan += scan_one_list (
-                         keys [i * nprobe + ik],
-                         coarse_dis[i * nprobe + ik],
-                         arranged_codes,
-                         simi, idxi, bitset
+                    idx_t key = keys [i * nprobe + ik];
+                    float cdis = coarse_dis[i * nprobe + ik];
+                    int skip = use_bound ? skip_list (key, cdis, simi[0]) : 0;
+                    if (skip > 0) {
+                        break;
+                    } else if (skip < 0) {
+                        continue;
+                    }
+
+                    size_t nheap0 = nheap;
+                    size_t list_size = scan_one_list (
+                         key, cdis, arranged_codes, simi, idxi, bitset
                     );
+                    nscan += list_size;
 
                     if (max_codes && nscan >= max_codes) {
                         break;
                     }
+                    if (adaptive_patience && list_size > 0) {
+                        nstale = nheap == nheap0 ? nstale + 1 : 0;
+                        if (nstale >= adaptive_patience) {
+                            break;
+                        }
+                    }
                 }
 
                 ndis += nscan;
@@ -810,6 +899,286 @@ void IndexIVF::search_preassigned_without_codes (idx_t n, const float *x,
     }
 }
 
+void IndexIVF::compute_list_radii (const uint8_t *arranged_codes,
+                                   const size_t *prefix_sum,
+                                   size_t arranged_code_size)
+{
+    list_radii.clear ();
+    max_list_radius = 0;
+    radii_ntotal = -1;
+    if (metric_type != METRIC_L2 ||
+        dynamic_cast<const BlockInvertedLists *>(invlists)) {
+        return;
+    }
+
+    std::vector<float> radii (nlist, 0);
+
+#pragma omp parallel
+    {
+        // the scanner distance to the codes with the centroid as query,
+        // so that the bound holds for the distances of the search
+        InvertedListScanner *scanner = get_InvertedListScanner (false);
+        ScopeDeleter1<InvertedListScanner> del (scanner);
+        std::vector<float> centroid (d);
+
+#pragma omp for schedule(dynamic)
+        for (idx_t key = 0; key < (idx_t) nlist; key++) {
+            size_t list_size = invlists->list_size (key);
+            if (list_size == 0) {
+                continue;
+            }
+            quantizer->reconstruct (key, centroid.data ());
+            scanner->set_query (centroid.data ());
+            scanner->set_list (key, 0);
+
+            std::unique_ptr<ScopedCodes> scodes;
+            const uint8_t *codes = nullptr;
+            size_t stride = code_size;
+            if (arranged_codes) {
+                codes = arranged_codes + prefix_sum[key] * arranged_code_size;
+                stride = arranged_code_size;
+            } else {
+                scodes.reset (new ScopedCodes (invlists, key));
+                codes = scodes->get ();
+            }
+
+            float max_dis = 0;
+            for (size_t j = 0; j < list_size; j++) {
+                max_dis = std::max (max_dis,
+                                    scanner->distance_to_code (codes + j * stride));
+            }
+            radii[key] = std::sqrt (max_dis);
+        }
+    }
+
+    list_radii = std::move (radii);
+    for (auto r : list_radii) {
+        max_list_radius = std::max (max_list_radius, r);
+    }
+    radii_ntotal = ntotal;
+}
+
+bool IndexIVF::use_list_major (idx_t n, long nprobe, long max_codes,
+                               bool store_pairs) const
+{
+    int pmode = parallel_mode & ~PARALLEL_MODE_NO_HEAP_INIT;
+    if (pmode == 3) {
+        FAISS_THROW_IF_NOT_MSG (!store_pairs && max_codes == 0,
+            "list-major search does not support store_pairs nor max_codes");
+        return true;
+    }
+    return pmode == 0 && list_major_ratio > 0 && n > 1 &&
+           !store_pairs && max_codes == 0 &&
+           adaptive_patience == 0 && !adaptive_bound &&
+           n * nprobe >= list_major_ratio * nlist;
+}
+
+/* The (query, list) probes are grouped by list. The threads take whole
+ * lists, so the partial results of a query come from several threads:
+ * they are collected in small per-list heaps and merged into the result
+ * heap of the query under a per-query lock. */
+void IndexIVF::search_preassigned_list_major (idx_t n, const float *x,
+                                              idx_t k,
+                                              const idx_t *keys,
+                                              const float *coarse_dis,
+                                              float *distances,
+                                              idx_t *labels,
+                                              const IVFSearchParameters *params,
+                                              const BitsetView bitset,
+                                              const uint8_t *arranged_codes,
+                                              const size_t *prefix_sum,
+                                              size_t arranged_code_size) const
+{
+    long nprobe = params ? params->nprobe : this->nprobe;
+    bool do_heap_init = !(this->parallel_mode & PARALLEL_MODE_NO_HEAP_INIT);
+
+    using HeapForIP = CMin<float, idx_t>;
+    using HeapForL2 = CMax<float, idx_t>;
+
+    // invert the assignment: lims[key] .. lims[key + 1] are the probes
+    // of list key
+    std::vector<size_t> lims (nlist + 1, 0);
+    for (size_t i = 0; i < n * nprobe; i++) {
+        idx_t key = keys[i];
+        if (key < 0) {
+            // not enough centroids for multiprobe
+            continue;
+        }
+        FAISS_THROW_IF_NOT_FMT (key < (idx_t) nlist,
+                                "Invalid key=%ld nlist=%ld\n",
+                                key, nlist);
+        lims[key + 1]++;
+    }
+    for (size_t l = 0; l < nlist; l++) {
+        lims[l + 1] += lims[l];
+    }
+    std::vector<idx_t> probe_qno (lims[nlist]);
+    std::vector<float> probe_dis (lims[nlist]);
+    {
+        std::vector<size_t> ofs (lims.begin(), lims.end() - 1);
+        for (size_t i = 0; i < n * nprobe; i++) {
+            idx_t key = keys[i];
+            if (key < 0) continue;
+            size_t o = ofs[key]++;
+            probe_qno[o] = i / nprobe;
+            probe_dis[o] = coarse_dis[i];
+        }
+    }
+
+    // biggest lists first, for the dynamic schedule
+    std::vector<idx_t> lists;
+    for (size_t l = 0; l < nlist; l++) {
+        if (lims[l + 1] > lims[l] && invlists->list_size (l) > 0) {
+            lists.push_back (l);
+        }
+    }
+    auto work = [&] (idx_t l) {
+        return invlists->list_size (l) * (lims[l + 1] - lims[l]);
+    };
+    std::sort (lists.begin(), lists.end(), [&] (idx_t a, idx_t b) {
+        return work (a) > work (b);
+    });
+
+    if (do_heap_init) {
+        for (idx_t i = 0; i < n; i++) {
+            if (metric_type == METRIC_INNER_PRODUCT) {
+                heap_heapify<HeapForIP> (k, distances + i * k, labels + i * k);
+            } else {
+                heap_heapify<HeapForL2> (k, distances + i * k, labels + i * k);
+            }
+        }
+    }
+
+    std::vector<std::mutex> locks (n);
+    size_t nlistv = 0, ndis = 0, nheap = 0;
+    bool interrupt = false;
+
+#pragma omp parallel if(lists.size() > 1) reduction(+: nlistv, ndis, nheap)
+    {
+        InvertedListScanner *scanner = get_InvertedListScanner (false);
+        ScopeDeleter1<InvertedListScanner> del (scanner);
+
+        std::vector<float> xq, local_dis;
+        std::vector<idx_t> local_idx;
+
+#pragma omp for schedule(dynamic)
+        for (size_t li = 0; li < lists.size(); li++) {
+            if (interrupt) {
+                continue;
+            }
+            idx_t key = lists[li];
+            size_t nq = lims[key + 1] - lims[key];
+            const idx_t *qnos = probe_qno.data() + lims[key];
+
+            xq.resize (nq * d);
+            for (size_t q = 0; q < nq; q++) {
+                memcpy (xq.data() + q * d, x + qnos[q] * d, sizeof (float) * d);
+            }
+            local_dis.resize (nq * k);
+            local_idx.resize (nq * k);
+            for (size_t q = 0; q < nq; q++) {
+                if (metric_type == METRIC_INNER_PRODUCT) {
+                    heap_heapify<HeapForIP> (k, local_dis.data() + q * k,
+                                             local_idx.data() + q * k);
+                } else {
+                    heap_heapify<HeapForL2> (k, local_dis.data() + q * k,
+                                             local_idx.data() + q * k);
+                }
+            }
+
+            size_t list_size = invlists->list_size (key);
+            ScopedIds sids (invlists, key);
+            std::unique_ptr<ScopedCodes> scodes;
+            const uint8_t *codes;
+            if (arranged_codes) {
+                codes = arranged_codes + prefix_sum[key] * arranged_code_size;
+            } else {
+                scodes.reset (new ScopedCodes (invlists, key));
+                codes = scodes->get();
+            }
+
+            nheap += scan_list_for_queries (key, list_size, codes, sids.get(),
+                                            nq, xq.data(),
+                                            probe_dis.data() + lims[key], k,
+                                            local_dis.data(), local_idx.data(),
+                                            scanner, bitset);
+            nlistv++;
+            ndis += list_size * nq;
+
+            // merge into the results of the queries
+            for (size_t q = 0; q < nq; q++) {
+                idx_t qno = qnos[q];
+                std::lock_guard<std::mutex> guard (locks[qno]);
+                if (metric_type == METRIC_INNER_PRODUCT) {
+                    heap_addn<HeapForIP> (k, distances + qno * k,
+                                          labels + qno * k,
+                                          local_dis.data() + q * k,
+                                          local_idx.data() + q * k, k);
+                } else {
+                    heap_addn<HeapForL2> (k, distances + qno * k,
+                                          labels + qno * k,
+                                          local_dis.data() + q * k,
+                                          local_idx.data() + q * k, k);
+                }
+            }
+
+            if (InterruptCallback::is_interrupted ()) {
+                interrupt = true;
+            }
+        }
+    } // parallel section
+
+    if (interrupt) {
+        FAISS_THROW_MSG ("computation interrupted");
+    }
+
+    if (do_heap_init) {
+#pragma omp parallel for if(n > 1)
+        for (idx_t i = 0; i < n; i++) {
+            if (metric_type == METRIC_INNER_PRODUCT) {
+                heap_reorder<HeapForIP> (k, distances + i * k, labels + i * k);
+            } else {
+                heap_reorder<HeapForL2> (k, distances + i * k, labels + i * k);
+            }
+        }
+    }
+
+    if(STATISTICS_LEVEL >= 1) {
+        index_ivf_stats.nq += n;
+        index_ivf_stats.nlist += nlistv;
+        index_ivf_stats.ndis += ndis;
+        index_ivf_stats.nheap_updates += nheap;
+    }
+}
+
+size_t IndexIVF::scan_list_for_queries (idx_t key, size_t list_size,
+                                        const uint8_t *codes,
+                                        const idx_t *ids,
+                                        size_t nq, const float *xq,
+                                        const float *coarse_dis, idx_t k,
+                                        float *distances, idx_t *labels,
+                                        InvertedListScanner *scanner,
+                                        const BitsetView bitset) const
+{
+    // chunks of about 256kB, in multiples of 32 codes so that blocked
+    // code layouts (BlockInvertedLists) are cut at block boundaries
+    size_t chunk = (256 * 1024 / code_size) / 32 * 32;
+    if (chunk == 0) chunk = 32;
+
+    size_t nup = 0;
+    for (size_t j0 = 0; j0 < list_size; j0 += chunk) {
+        size_t j1 = std::min (list_size, j0 + chunk);
+        for (size_t q = 0; q < nq; q++) {
+            scanner->set_query (xq + q * d);
+            scanner->set_list (key, coarse_dis[q]);
+            nup += scanner->scan_codes (j1 - j0, codes + j0 * code_size,
+                                        ids + j0, distances + q * k,
+                                        labels + q * k, k, bitset);
+        }
+    }
+    return nup;
+}
+
 void IndexIVF::range_search (idx_t nx, const float *x, float radius,
                              RangeSearchResult *result,
                              const BitsetView bitset) const
@@ -1038,6 +1407,7 @@ void IndexIVF::reset ()
     direct_map.clear ();
     invlists->reset ();
     ntotal = 0;
+    list_radii.clear ();
 }
 
 
@@ -127,6 +127,8 @@ struct IndexIVF: Index, Level1Quantizer {
      * 0 (default): parallelize over queries
      * 1: parallelize over inverted lists
      * 2: parallelize over both
+     * 3: list-major, parallelize over the probed inverted lists and scan
+     *    each of them once for all the queries that probe it
      *
      * PARALLEL_MODE_NO_HEAP_INIT: binary or with the previous to
      * prevent the heap to be initialized and finalized
@@ -134,6 +136,32 @@ struct IndexIVF: Index, Level1Quantizer {
     int parallel_mode;
     const int PARALLEL_MODE_NO_HEAP_INIT = 1024;
 
+    /** in parallel mode 0, switch to the list-major search (mode 3) when
+     * the lists are probed by at least this many queries on average,
+     * ie. n * nprobe >= list_major_ratio * nlist. 0 disables it. */
+    float list_major_ratio;
+
+    /** adaptive termination of the per-query scan, in parallel mode 0.
+     * The lists are visited in centroid distance order and nprobe stays
+     * the cap on their number.
+     *
+     * adaptive_patience: stop after this many consecutive non-empty lists
+     * that did not update the result heap. 0 disables it.
+     *
+     * adaptive_bound: with METRIC_L2 and up-to-date list_radii, skip a
+     * list when sqrt(coarse_dis) - radius, a lower bound of the distance
+     * to its vectors, is beyond the current k-th distance, and stop at
+     * the first list where this holds with max_list_radius. */
+    size_t adaptive_patience;
+    bool adaptive_bound;
+
+    /** max distance (not squared) of the vectors of each list to its
+     * centroid, set by compute_list_radii. Only used while ntotal is
+     * still radii_ntotal. */
+    std::vector<float> list_radii;
+    float max_list_radius;
+    idx_t radii_ntotal;
+
     /** optional map that maps back ids to invlist entries. This
      *  enables reconstruct() */
     DirectMap direct_map;
@@ -211,6 +239,59 @@ struct IndexIVF: Index, Level1Quantizer {
                                      const BitsetView bitset = nullptr
                                      ) const;
 
+    /// whether search_preassigned goes list-major, see list_major_ratio
+    bool use_list_major (idx_t n, long nprobe, long max_codes,
+                         bool store_pairs) const;
+
+    /** list-major version of search_preassigned, the probes are grouped
+     * by inverted list. The codes are taken from arranged_codes, with the
+     * list offsets in prefix_sum, when it is set (IVF_NM). Does not
+     * support store_pairs nor max_codes. */
+    void search_preassigned_list_major (idx_t n, const float *x, idx_t k,
+                                        const idx_t *assign,
+                                        const float *centroid_dis,
+                                        float *distances, idx_t *labels,
+                                        const IVFSearchParameters *params,
+                                        const BitsetView bitset,
+                                        const uint8_t *arranged_codes = nullptr,
+                                        const size_t *prefix_sum = nullptr,
+                                        size_t arranged_code_size = 0) const;
+
+    /** scan one inverted list for nq queries of the list-major search.
+     *
+     * @param xq     the queries, size nq * d
+     * @param coarse_dis
+     *               distance of each query to the list centroid, size nq
+     * @param distances, labels
+     *               initialized result heaps of the queries, size nq * k
+     * @return       nb of heap updates
+     *
+     * The default implementation runs the scanner over chunks of the list
+     * that stay in cache while all the queries go over them.
+     */
+    virtual size_t scan_list_for_queries (idx_t key, size_t list_size,
+                                          const uint8_t *codes,
+                                          const idx_t *ids,
+                                          size_t nq, const float *xq,
+                                          const float *coarse_dis, idx_t k,
+                                          float *distances, idx_t *labels,
+                                          InvertedListScanner *scanner,
+                                          const BitsetView bitset) const;
+
+    /** compute list_radii with the scanner distances of the codes to the
+     * centroids, taken from arranged_codes like in the list-major search
+     * when it is set. Clears them for other metrics than METRIC_L2 and
+     * for the block-packed lists of the fast scan. */
+    void compute_list_radii (const uint8_t *arranged_codes = nullptr,
+                             const size_t *prefix_sum = nullptr,
+                             size_t arranged_code_size = 0);
+
+    /// whether the adaptive_bound can use list_radii
+    bool has_list_radii () const {
+        return metric_type == METRIC_L2 && list_radii.size() == nlist &&
+               radii_ntotal == ntotal;
+    }
+
     /** Similar to search_preassigned, but does not store codes **/
     virtual void search_preassigned_without_codes (idx_t n, const float *x, 
                                                    const uint8_t *arranged_codes, 
@@ -248,6 +248,27 @@ InvertedListScanner* IndexIVFFlat::get_InvertedListScanner
 
 
 
+size_t IndexIVFFlat::scan_list_for_queries (idx_t key, size_t list_size,
+                                            const uint8_t *codes,
+                                            const idx_t *ids,
+                                            size_t nq, const float *xq,
+                                            const float *coarse_dis, idx_t k,
+                                            float *distances, idx_t *labels,
+                                            InvertedListScanner *scanner,
+                                            const BitsetView bitset) const
+{
+    // too few queries for sgemm to pay off
+    if (nq < 4) {
+        return IndexIVF::scan_list_for_queries (key, list_size, codes, ids,
+                                                nq, xq, coarse_dis, k,
+                                                distances, labels,
+                                                scanner, bitset);
+    }
+    return knn_add_to_heaps_blas (xq, (const float*)codes, ids, d, nq, list_size,
+                                  metric_type, nullptr, k, distances, labels,
+                                  bitset);
+}
+
 void IndexIVFFlat::reconstruct_from_offset (int64_t list_no, int64_t offset,
                                             float* recons) const
 {
@@ -48,6 +48,9 @@ IndexIVFPQ::IndexIVFPQ (Index * quantizer, size_t d, size_t nlist,
     by_residual = true;
     use_precomputed_table = 0;
     scan_table_threshold = 0;
+    // the scanner tables are per query, list-major would recompute them
+    // for every probed list
+    list_major_ratio = 0;
 
     polysemous_training = nullptr;
     do_polysemous_training = false;
@@ -1176,6 +1179,7 @@ IndexIVFPQ::IndexIVFPQ ()
     // initialize some runtime values
     use_precomputed_table = 0;
     scan_table_threshold = 0;
+    list_major_ratio = 0;
     do_polysemous_training = false;
     polysemous_ht = 0;
     polysemous_training = nullptr;
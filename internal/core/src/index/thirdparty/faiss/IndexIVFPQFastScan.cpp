@@ -0,0 +1,253 @@
+// -*- c++ -*-
+
+#include <faiss/IndexIVFPQFastScan.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <faiss/BlockInvertedLists.h>
+#include <faiss/DirectMap.h>
+#include <faiss/FaissHook.h>
+#include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/PQ4FastScan.h>
+#include <faiss/utils/Heap.h>
+
+namespace faiss {
+
+IndexIVFPQFastScan::IndexIVFPQFastScan (Index * quantizer, size_t d,
+                                        size_t nlist, size_t M,
+                                        MetricType metric):
+    IndexIVFPQ (quantizer, d, nlist, M, 4, metric),
+    rerank (true)
+{
+    // the scanner computes its tables per list, no precomputed table
+    use_precomputed_table = -1;
+    replace_invlists (new BlockInvertedLists (nlist, M, code_size), true);
+}
+
+IndexIVFPQFastScan::IndexIVFPQFastScan ():
+    rerank (true)
+{
+    use_precomputed_table = -1;
+}
+
+void IndexIVFPQFastScan::reconstruct_from_offset (int64_t list_no,
+                                                  int64_t offset,
+                                                  float* recons) const
+{
+    InvertedLists::ScopedCodes code (invlists, list_no, offset);
+    pq.decode (code.get(), recons);
+    if (by_residual) {
+        std::vector<float> centroid (d);
+        quantizer->reconstruct (list_no, centroid.data());
+        for (int i = 0; i < d; ++i) {
+            recons[i] += centroid[i];
+        }
+    }
+}
+
+void IndexIVFPQFastScan::merge_from (IndexIVF &, idx_t)
+{
+    FAISS_THROW_MSG ("merge_from not implemented for IndexIVFPQFastScan");
+}
+
+namespace {
+
+using idx_t = Index::idx_t;
+
+/* The scanner works on costs, smaller is better: the L2 distance, or the
+ * opposite of the inner product. */
+template<MetricType METRIC_TYPE, class C>
+struct IVFPQFastScanScanner: InvertedListScanner {
+    const IndexIVFPQFastScan & ivfpq;
+    const ProductQuantizer & pq;
+    bool store_pairs;
+    size_t M, M2;
+
+    const float *qi = nullptr;
+    idx_t key = -1;
+
+    std::vector<float> residual;
+    std::vector<float> sim_table;     // float costs, M * 16
+    std::vector<uint8_t> q_table;     // quantized costs, M2 * 16
+    float base = 0;                   // cost of the list
+    float q_bias = 0;                 // sum of the per-row minima
+    float q_scale = 0;                // quantized units per cost unit
+    mutable std::vector<uint16_t> q_dis;
+
+    IVFPQFastScanScanner (const IndexIVFPQFastScan & ivfpq, bool store_pairs):
+        ivfpq (ivfpq), pq (ivfpq.pq), store_pairs (store_pairs),
+        M (pq.M), M2 (pq4_M2 (pq.M)),
+        residual (ivfpq.d), sim_table (pq.M * pq.ksub), q_table (M2 * 16, 0)
+    {
+        FAISS_THROW_IF_NOT (pq.nbits == 4);
+    }
+
+    /* One scale for all rows, so the sum of M entries fits in uint16. Each
+     * entry is off by at most 0.5 unit. */
+    void quantize_table ()
+    {
+        std::vector<float> mins (M);
+        float span = 0;
+        q_bias = 0;
+        for (size_t m = 0; m < M; m++) {
+            const float *row = sim_table.data() + m * 16;
+            float lo = *std::min_element (row, row + 16);
+            float hi = *std::max_element (row, row + 16);
+            mins[m] = lo;
+            q_bias += lo;
+            span = std::max (span, hi - lo);
+        }
+        float q_max = std::min<size_t> (255, 65535 / M);
+        q_scale = span > 0 ? q_max / span : 0;
+        for (size_t m = 0; m < M; m++) {
+            for (size_t j = 0; j < 16; j++) {
+                float v = (sim_table[m * 16 + j] - mins[m]) * q_scale;
+                q_table[m * 16 + j] = (uint8_t) std::lrint (v);
+            }
+        }
+    }
+
+    void set_query (const float *query) override
+    {
+        qi = query;
+        if (METRIC_TYPE == METRIC_INNER_PRODUCT) {
+            // <q, c + r> = <q, c> + <q, r>, the table is the same for all lists
+            pq.compute_inner_prod_table (qi, sim_table.data());
+            for (auto & v : sim_table) {
+                v = -v;
+            }
+            quantize_table ();
+        } else if (!ivfpq.by_residual) {
+            pq.compute_distance_table (qi, sim_table.data());
+            quantize_table ();
+        }
+    }
+
+    void set_list (idx_t list_no, float coarse_dis) override
+    {
+        key = list_no;
+        if (METRIC_TYPE == METRIC_INNER_PRODUCT) {
+            base = ivfpq.by_residual ? -coarse_dis : 0;
+        } else if (ivfpq.by_residual) {
+            ivfpq.quantizer->compute_residual (qi, residual.data(), list_no);
+            pq.compute_distance_table (residual.data(), sim_table.data());
+            quantize_table ();
+        }
+    }
+
+    inline float to_dis (float cost) const
+    {
+        return METRIC_TYPE == METRIC_INNER_PRODUCT ? -cost : cost;
+    }
+
+    /// quantized distances below the threshold may beat dis
+    uint32_t threshold (float dis) const
+    {
+        if (q_scale == 0) return 65536;
+        // the margin covers the rounding of the M entries
+        float v = (to_dis (dis) - base - q_bias) * q_scale + 0.5f * M + 1;
+        if (!(v < 65536)) return 65536;
+        if (v <= 0) return 0;
+        return (uint32_t) std::ceil (v);
+    }
+
+    float block_cost (const uint8_t *codes, size_t j) const
+    {
+        if (!ivfpq.rerank) {
+            return base + q_bias + (q_scale > 0 ? q_dis[j] / q_scale : 0);
+        }
+        const uint8_t *block =
+            codes + j / PQ4_BLOCK_SIZE * pq4_block_bytes (M);
+        size_t i = j % PQ4_BLOCK_SIZE;
+        float cost = base;
+        for (size_t m = 0; m < M; m++) {
+            cost += sim_table[m * 16 + pq4_get_code (block, m, i)];
+        }
+        return cost;
+    }
+
+    float distance_to_code (const uint8_t *code) const override
+    {
+        float cost = base;
+        for (size_t m = 0; m < M; m++) {
+            uint8_t c = (code[m >> 1] >> ((m & 1) * 4)) & 15;
+            cost += sim_table[m * 16 + c];
+        }
+        return to_dis (cost);
+    }
+
+    void accumulate (size_t n, const uint8_t *codes) const
+    {
+        size_t nblocks = (n + PQ4_BLOCK_SIZE - 1) / PQ4_BLOCK_SIZE;
+        q_dis.resize (nblocks * PQ4_BLOCK_SIZE);
+        pq4_accumulate (nblocks, M2, codes, q_table.data(), q_dis.data());
+    }
+
+    size_t scan_codes (size_t n,
+                       const uint8_t *codes,
+                       const idx_t *ids,
+                       float *heap_sim, idx_t *heap_ids,
+                       size_t k,
+                       const BitsetView bitset) const override
+    {
+        accumulate (n, codes);
+        size_t nup = 0;
+        uint32_t thresh = threshold (heap_sim[0]);
+        for (size_t j = 0; j < n; j++) {
+            if (q_dis[j] >= thresh) continue;
+            idx_t id = store_pairs ? lo_build (key, j) : ids[j];
+            if (!bitset.empty() && bitset.test ((ConcurrentBitset::id_type_t)id))
+                continue;
+            float dis = to_dis (block_cost (codes, j));
+            if (C::cmp (heap_sim[0], dis)) {
+                heap_swap_top<C> (k, heap_sim, heap_ids, dis, id);
+                thresh = threshold (heap_sim[0]);
+                nup++;
+            }
+        }
+        return nup;
+    }
+
+    void scan_codes_range (size_t n,
+                           const uint8_t *codes,
+                           const idx_t *ids,
+                           float radius,
+                           RangeQueryResult & res,
+                           const BitsetView bitset) const override
+    {
+        accumulate (n, codes);
+        uint32_t thresh = threshold (radius);
+        for (size_t j = 0; j < n; j++) {
+            if (q_dis[j] >= thresh) continue;
+            idx_t id = store_pairs ? lo_build (key, j) : ids[j];
+            if (!bitset.empty() && bitset.test ((ConcurrentBitset::id_type_t)id))
+                continue;
+            float dis = to_dis (block_cost (codes, j));
+            if (C::cmp (radius, dis)) {
+                res.add (dis, id);
+            }
+        }
+    }
+};
+
+} // namespace
+
+InvertedListScanner *
+IndexIVFPQFastScan::get_InvertedListScanner (bool store_pairs) const
+{
+    FAISS_THROW_IF_NOT_MSG (dynamic_cast<const BlockInvertedLists*>(invlists),
+                            "IndexIVFPQFastScan needs BlockInvertedLists");
+    if (metric_type == METRIC_INNER_PRODUCT) {
+        return new IVFPQFastScanScanner<METRIC_INNER_PRODUCT, CMin<float, idx_t> >
+            (*this, store_pairs);
+    } else if (metric_type == METRIC_L2) {
+        return new IVFPQFastScanScanner<METRIC_L2, CMax<float, idx_t> >
+            (*this, store_pairs);
+    }
+    FAISS_THROW_MSG ("metric type not supported");
+}
+
+} // namespace faiss
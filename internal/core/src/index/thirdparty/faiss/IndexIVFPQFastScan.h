@@ -0,0 +1,40 @@
+// -*- c++ -*-
+
+#pragma once
+
+#include <faiss/IndexIVFPQ.h>
+
+namespace faiss {
+
+/** IVFPQ with 4-bit codes scanned 32 at a time with SIMD.
+ *
+ * The codes are stored in BlockInvertedLists. Per inverted list the query
+ * look-up tables are quantized to uint8 and the distances of a block are
+ * accumulated in uint16 registers with pshufb (see impl/PQ4FastScan.h).
+ *
+ * The quantized distances only filter: a code is looked at further only if
+ * its quantized distance, with the quantization error as margin, can beat
+ * the top of the result heap. With rerank (the default) its distance is
+ * then recomputed with the float tables, so the results are the same as
+ * IndexIVFPQ with nbits = 4.
+ */
+struct IndexIVFPQFastScan: IndexIVFPQ {
+    /// recompute the distances of the filtered codes with the float tables
+    bool rerank;
+
+    IndexIVFPQFastScan (
+            Index * quantizer, size_t d, size_t nlist,
+            size_t M, MetricType metric = METRIC_L2);
+
+    IndexIVFPQFastScan ();
+
+    void reconstruct_from_offset (int64_t list_no, int64_t offset,
+                                  float* recons) const override;
+
+    void merge_from (IndexIVF &other, idx_t add_id) override;
+
+    InvertedListScanner *get_InvertedListScanner (bool store_pairs)
+        const override;
+};
+
+} // namespace faiss
@@ -14,6 +14,7 @@
 
 #include <omp.h>
 
+#include <faiss/utils/distances.h>
 #include <faiss/utils/utils.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/impl/AuxIndexStructures.h>
@@ -339,6 +340,54 @@ InvertedListScanner* IndexIVFScalarQuantizer::get_InvertedListScanner
 }
 
 
+size_t IndexIVFScalarQuantizer::scan_list_for_queries (
+            idx_t key, size_t list_size,
+            const uint8_t *codes, const idx_t *ids,
+            size_t nq, const float *xq,
+            const float *coarse_dis, idx_t k,
+            float *distances, idx_t *labels,
+            InvertedListScanner *scanner,
+            const BitsetView bitset) const
+{
+    // too few queries for sgemm to pay off
+    if (nq < 4) {
+        return IndexIVF::scan_list_for_queries (key, list_size, codes, ids,
+                                                nq, xq, coarse_dis, k,
+                                                distances, labels,
+                                                scanner, bitset);
+    }
+
+    // the codes decode to residuals: the L2 queries are taken relative to
+    // the centroid, and <q, c> is added to the inner products
+    const float *x = xq;
+    const float *x_shift = nullptr;
+    std::vector<float> residuals;
+    if (by_residual) {
+        if (metric_type == METRIC_INNER_PRODUCT) {
+            x_shift = coarse_dis;
+        } else {
+            residuals.resize (nq * d);
+            for (size_t q = 0; q < nq; q++) {
+                quantizer->compute_residual (xq + q * d,
+                                             residuals.data() + q * d, key);
+            }
+            x = residuals.data();
+        }
+    }
+
+    const size_t bs = 256;
+    std::vector<float> decoded (bs * d);
+    size_t nup = 0;
+    for (size_t j0 = 0; j0 < list_size; j0 += bs) {
+        size_t j1 = std::min (list_size, j0 + bs);
+        sq.decode (codes + j0 * code_size, decoded.data(), j1 - j0);
+        nup += knn_add_to_heaps_blas (x, decoded.data(), ids + j0, d, nq,
+                                      j1 - j0, metric_type, x_shift, k,
+                                      distances, labels, bitset);
+    }
+    return nup;
+}
+
 void IndexIVFScalarQuantizer::reconstruct_from_offset (int64_t list_no,
                                                        int64_t offset,
                                                        float* recons) const
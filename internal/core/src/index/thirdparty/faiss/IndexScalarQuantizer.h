@@ -114,6 +114,16 @@ struct IndexIVFScalarQuantizer: IndexIVF {
     InvertedListScanner *get_InvertedListScanner (bool store_pairs)
         const override;
 
+    /// decodes the list by blocks and computes the distances with sgemm
+    size_t scan_list_for_queries (idx_t key, size_t list_size,
+                                  const uint8_t *codes,
+                                  const idx_t *ids,
+                                  size_t nq, const float *xq,
+                                  const float *coarse_dis, idx_t k,
+                                  float *distances, idx_t *labels,
+                                  InvertedListScanner *scanner,
+                                  const BitsetView bitset) const override;
+
 
     void reconstruct_from_offset (int64_t list_no, int64_t offset,
                                   float* recons) const override;
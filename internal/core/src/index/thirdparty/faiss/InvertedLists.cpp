@@ -9,9 +9,15 @@
 
 #include <faiss/InvertedLists.h>
 
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <numeric>
 
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
+
 #include <faiss/utils/utils.h>
 #include <faiss/impl/FaissAssert.h>
 
@@ -298,7 +304,7 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(size_t nlist,
         FAISS_THROW_MSG ("Invalid list_length");
         return;
     }
-    auto total_size = std::accumulate(readonly_length.begin(), readonly_length.end(), 0);
+    auto total_size = std::accumulate(readonly_length.begin(), readonly_length.end(), size_t(0));
     readonly_offset.reserve(nlist);
 
 #ifdef USE_CPU
@@ -326,12 +332,14 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(const ArrayInvertedLists&
     }
 
 #ifdef USE_CPU
+    readonly_ids.resize(offset);
+    readonly_codes.resize(offset * code_size);
     for (auto i = 0; i < other.ids.size(); i++) {
         auto& list_ids = other.ids[i];
-        readonly_ids.insert(readonly_ids.end(), list_ids.begin(), list_ids.end());
+        memcpy(readonly_ids.data() + readonly_offset[i], list_ids.data(), list_ids.size() * sizeof(idx_t));
 
         auto& list_codes = other.codes[i];
-        readonly_codes.insert(readonly_codes.end(), list_codes.begin(), list_codes.end());
+        memcpy(readonly_codes.data() + readonly_offset[i] * code_size, list_codes.data(), list_codes.size());
     }
 #else
     size_t ids_size = offset * sizeof(idx_t);
@@ -370,9 +378,10 @@ ReadOnlyArrayInvertedLists::ReadOnlyArrayInvertedLists(const ArrayInvertedLists&
     }
 
 #ifdef USE_CPU
+    readonly_ids.resize(offset);
     for (auto i = 0; i < other.ids.size(); i++) {
         auto& list_ids = other.ids[i];
-        readonly_ids.insert(readonly_ids.end(), list_ids.begin(), list_ids.end());
+        memcpy(readonly_ids.data() + readonly_offset[i], list_ids.data(), list_ids.size() * sizeof(idx_t));
     }
 #else
     size_t ids_size = offset * sizeof(idx_t);
@@ -445,10 +454,37 @@ const uint8_t * ReadOnlyArrayInvertedLists::get_codes (size_t list_no) const
 #endif
 }
 
+namespace {
+
+/// zero-extends 32-bit ids, four at a time with SSE4.1
+void widen_ids (const uint32_t *src, InvertedLists::idx_t *dst, size_t n)
+{
+    size_t i = 0;
+#ifdef __SSE4_1__
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128 ((const __m128i *)(src + i));
+        _mm_storeu_si128 ((__m128i *)(dst + i), _mm_cvtepu32_epi64 (v));
+        _mm_storeu_si128 ((__m128i *)(dst + i + 2),
+                          _mm_cvtepu32_epi64 (_mm_srli_si128 (v, 8)));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = src[i];
+    }
+}
+
+}  // namespace
+
 const InvertedLists::idx_t* ReadOnlyArrayInvertedLists::get_ids (size_t list_no) const
 {
     FAISS_ASSERT(list_no < nlist && valid);
 #ifdef USE_CPU
+    if (compact) {
+        size_t n = readonly_length[list_no];
+        idx_t *ids = new idx_t[n];
+        widen_ids (readonly_compact_ids.data() + readonly_offset[list_no], ids, n);
+        return ids;
+    }
     return readonly_ids.data() + readonly_offset[list_no];
 #else
     idx_t *pids = (idx_t *)pin_readonly_ids->data;
@@ -456,10 +492,56 @@ const InvertedLists::idx_t* ReadOnlyArrayInvertedLists::get_ids (size_t list_no)
 #endif
 }
 
+void ReadOnlyArrayInvertedLists::release_ids (size_t, const idx_t *ids) const
+{
+    if (compact) {
+        delete [] ids;
+    }
+}
+
+InvertedLists::idx_t ReadOnlyArrayInvertedLists::get_single_id (
+        size_t list_no, size_t offset) const
+{
+    FAISS_ASSERT(list_no < nlist && valid);
+    FAISS_ASSERT(offset < readonly_length[list_no]);
+#ifdef USE_CPU
+    if (compact) {
+        return readonly_compact_ids[readonly_offset[list_no] + offset];
+    }
+    return readonly_ids[readonly_offset[list_no] + offset];
+#else
+    return ((idx_t *)pin_readonly_ids->data)[readonly_offset[list_no] + offset];
+#endif
+}
+
+bool ReadOnlyArrayInvertedLists::compact_ids ()
+{
+#ifdef USE_CPU
+    if (compact) {
+        return true;
+    }
+    for (auto id : readonly_ids) {
+        if (id < 0 || id > (idx_t) UINT32_MAX) {
+            return false;
+        }
+    }
+    readonly_compact_ids.resize (readonly_ids.size());
+    for (size_t i = 0; i < readonly_ids.size(); i++) {
+        readonly_compact_ids[i] = (uint32_t) readonly_ids[i];
+    }
+    decltype(readonly_ids)().swap (readonly_ids);
+    compact = true;
+    return true;
+#else
+    // the GPU copies the pinned ids as they are
+    return false;
+#endif
+}
+
 const InvertedLists::idx_t* ReadOnlyArrayInvertedLists::get_all_ids() const {
     FAISS_ASSERT(valid);
 #ifdef USE_CPU
-    return readonly_ids.data();
+    return compact ? nullptr : readonly_ids.data();
 #else
     return (idx_t *)(pin_readonly_ids->data);
 #endif
@@ -15,7 +15,11 @@
  * the interface.
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 #include <faiss/Index.h>
 
@@ -47,6 +51,53 @@ using PageLockMemoryPtr = std::shared_ptr<PageLockMemory>;
 
 namespace faiss {
 
+/** Allocator for the packed buffers of ReadOnlyArrayInvertedLists: the
+ * buffers start on a cache line, and resize leaves the new elements
+ * uninitialized, since they are always overwritten right away.
+ */
+template <typename T>
+struct AlignedAllocator {
+    typedef T value_type;
+    static constexpr size_t alignment = 64;
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, alignment, std::max(n * sizeof(T), alignment)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t) {
+        free(ptr);
+    }
+
+    template <typename U>
+    void construct(U* ptr) {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* ptr, Args&&... args) {
+        ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const {
+        return false;
+    }
+};
+
 /** Table of inverted lists
  * multithreading rules:
  * - concurrent read accesses are allowed
@@ -252,10 +303,18 @@ struct ArrayInvertedLists: InvertedLists {
     virtual ~ArrayInvertedLists ();
 };
 
+/** Read-only lists packed in two buffers, codes and ids, with the lists
+ * back to back. Loading a sealed index reads straight into them.
+ */
 struct ReadOnlyArrayInvertedLists: InvertedLists {
+    /// ids are stored in readonly_compact_ids, see compact_ids
+    bool compact = false;
+
 #ifdef USE_CPU
-    std::vector <uint8_t> readonly_codes;
-    std::vector <idx_t> readonly_ids;
+    std::vector <uint8_t, AlignedAllocator<uint8_t>> readonly_codes;
+    std::vector <idx_t, AlignedAllocator<idx_t>> readonly_ids;
+    /// ids narrowed by compact_ids, readonly_ids is empty then
+    std::vector <uint32_t, AlignedAllocator<uint32_t>> readonly_compact_ids;
 #else
     PageLockMemoryPtr pin_readonly_codes;
     PageLockMemoryPtr pin_readonly_ids;
@@ -278,6 +337,19 @@ struct ReadOnlyArrayInvertedLists: InvertedLists {
     const uint8_t * get_codes (size_t list_no) const override;
     const idx_t * get_ids (size_t list_no) const override;
 
+    /// with compact ids, get_ids widens the list into a buffer that
+    /// release_ids frees
+    void release_ids (size_t list_no, const idx_t *ids) const override;
+    idx_t get_single_id (size_t list_no, size_t offset) const override;
+
+    /** Stores the ids in 32 bits when they all fit, which halves their
+     * memory and the bandwidth of a scan. Sealed segments never reach
+     * 2^32 rows. get_all_ids returns nullptr afterwards.
+     *
+     * @return whether the ids were narrowed
+     */
+    bool compact_ids ();
+
     const uint8_t * get_all_codes() const;
     const idx_t * get_all_ids() const;
     const std::vector<size_t>& get_list_length() const;
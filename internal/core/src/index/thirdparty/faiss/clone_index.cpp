@@ -21,6 +21,8 @@
 #include <faiss/IndexPQ.h>
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexIVFPQFastScan.h>
+#include <faiss/BlockInvertedLists.h>
 #include <faiss/IndexIVFPQR.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
@@ -71,6 +73,7 @@ VectorTransform *Cloner::clone_VectorTransform (const VectorTransform *vt)
 IndexIVF * Cloner::clone_IndexIVF (const IndexIVF *ivf)
 {
     TRYCLONE (IndexIVFPQR, ivf)
+    TRYCLONE (IndexIVFPQFastScan, ivf)
     TRYCLONE (IndexIVFPQ, ivf)
     TRYCLONE (IndexIVFFlat, ivf)
     TRYCLONE (IndexIVFScalarQuantizer, ivf)
@@ -106,6 +109,9 @@ Index *Cloner::clone_Index (const Index *index)
         } else if (auto *ails = dynamic_cast<const ReadOnlyArrayInvertedLists*>(ivf->invlists)) {
             res->invlists = new ReadOnlyArrayInvertedLists(*ails);
             res->own_invlists = true;
+        } else if (auto *bils = dynamic_cast<const BlockInvertedLists*>(ivf->invlists)) {
+            res->invlists = new BlockInvertedLists(*bils);
+            res->own_invlists = true;
         } else {
             FAISS_THROW_MSG( "clone not supported for this type of inverted lists");
         }
@@ -0,0 +1,63 @@
+// -*- c++ -*-
+
+#include <faiss/impl/PQ4FastScan.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+void pq4_pack_code (const uint8_t *code, size_t M, size_t i, uint8_t *block)
+{
+    size_t shift = i < 16 ? 0 : 4;
+    uint8_t mask = i < 16 ? 0xf0 : 0x0f;
+    for (size_t m = 0; m < M; m++) {
+        uint8_t c = (code[m >> 1] >> ((m & 1) * 4)) & 15;
+        uint8_t & b = block[m * 16 + (i & 15)];
+        b = (b & mask) | (c << shift);
+    }
+}
+
+void pq4_unpack_code (const uint8_t *block, size_t M, size_t i, uint8_t *code)
+{
+    for (size_t m = 0; m < M; m += 2) {
+        uint8_t c = pq4_get_code (block, m, i);
+        if (m + 1 < M) {
+            c |= pq4_get_code (block, m + 1, i) << 4;
+        }
+        code[m >> 1] = c;
+    }
+}
+
+void pq4_accumulate_sse (size_t nblocks, size_t M2,
+                         const uint8_t *blocks, const uint8_t *LUT,
+                         uint16_t *out)
+{
+    const __m128i mask = _mm_set1_epi8 (15);
+    const __m128i zero = _mm_setzero_si128 ();
+
+    for (size_t b = 0; b < nblocks; b++) {
+        __m128i acc0 = zero, acc1 = zero, acc2 = zero, acc3 = zero;
+
+        for (size_t m = 0; m < M2; m++) {
+            __m128i c = _mm_loadu_si128 ((const __m128i*)(blocks + m * 16));
+            __m128i lut = _mm_loadu_si128 ((const __m128i*)(LUT + m * 16));
+            __m128i lo = _mm_shuffle_epi8 (lut, _mm_and_si128 (c, mask));
+            __m128i hi = _mm_shuffle_epi8 (
+                  lut, _mm_and_si128 (_mm_srli_epi16 (c, 4), mask));
+            acc0 = _mm_add_epi16 (acc0, _mm_unpacklo_epi8 (lo, zero));
+            acc1 = _mm_add_epi16 (acc1, _mm_unpackhi_epi8 (lo, zero));
+            acc2 = _mm_add_epi16 (acc2, _mm_unpacklo_epi8 (hi, zero));
+            acc3 = _mm_add_epi16 (acc3, _mm_unpackhi_epi8 (hi, zero));
+        }
+
+        _mm_storeu_si128 ((__m128i*)(out + 0), acc0);
+        _mm_storeu_si128 ((__m128i*)(out + 8), acc1);
+        _mm_storeu_si128 ((__m128i*)(out + 16), acc2);
+        _mm_storeu_si128 ((__m128i*)(out + 24), acc3);
+
+        blocks += M2 * 16;
+        out += PQ4_BLOCK_SIZE;
+    }
+}
+
+} // namespace faiss
@@ -0,0 +1,60 @@
+// -*- c++ -*-
+
+/* Blocked layout and distance accumulation of 4-bit PQ codes.
+ *
+ * The codes of an inverted list are stored by blocks of 32 vectors. In a
+ * block, each sub-quantizer m takes 16 bytes, byte i holds the code of
+ * vector i in its low nibble and the code of vector i + 16 in its high
+ * nibble. The number of sub-quantizers is padded to an even M2, so that two
+ * sub-quantizers fill a 256-bit register.
+ *
+ * The look-up tables are quantized to uint8, 16 entries per sub-quantizer,
+ * and accumulated in uint16 with pshufb. The SIMD versions are in
+ * PQ4FastScan_avx.cpp and PQ4FastScan_avx512.cpp. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// vectors per block
+constexpr size_t PQ4_BLOCK_SIZE = 32;
+
+/// sub-quantizers rounded up to a multiple of 2
+inline size_t pq4_M2 (size_t M) {
+    return (M + 1) & ~(size_t)1;
+}
+
+/// bytes taken by a block of 32 codes
+inline size_t pq4_block_bytes (size_t M) {
+    return pq4_M2 (M) * 16;
+}
+
+/// code of vector i for sub-quantizer m in a block
+inline uint8_t pq4_get_code (const uint8_t *block, size_t m, size_t i) {
+    uint8_t c = block[m * 16 + (i & 15)];
+    return i < 16 ? c & 15 : c >> 4;
+}
+
+/// writes the PQ code (M nibbles, as ProductQuantizer packs them with
+/// nbits = 4) of vector i into a block
+void pq4_pack_code (const uint8_t *code, size_t M, size_t i, uint8_t *block);
+
+/// reads back the PQ code of vector i of a block
+void pq4_unpack_code (const uint8_t *block, size_t M, size_t i, uint8_t *code);
+
+/** accumulates the quantized distances of nblocks blocks
+ *
+ * @param nblocks  number of blocks
+ * @param M2       padded number of sub-quantizers
+ * @param blocks   codes, size nblocks * M2 * 16
+ * @param LUT      quantized look-up table, size M2 * 16
+ * @param out      distances in vector order, size nblocks * 32
+ */
+void pq4_accumulate_sse (size_t nblocks, size_t M2,
+                         const uint8_t *blocks, const uint8_t *LUT,
+                         uint16_t *out);
+
+} // namespace faiss
@@ -0,0 +1,70 @@
+// -*- c++ -*-
+
+#include <faiss/impl/PQ4FastScan_avx.h>
+#include <faiss/impl/PQ4FastScan.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+namespace {
+
+/* The 16-bit lanes of the accumulators hold the even (low byte) and odd
+ * (high byte) vectors of a half block, for the even sub-quantizers in the
+ * low 128 bits and the odd ones in the high 128 bits. */
+inline void accumulate_pair (__m256i c, __m256i lut, __m256i mask,
+                             __m256i lomask,
+                             __m256i & lo_even, __m256i & lo_odd,
+                             __m256i & hi_even, __m256i & hi_odd)
+{
+    __m256i lo = _mm256_shuffle_epi8 (lut, _mm256_and_si256 (c, mask));
+    __m256i hi = _mm256_shuffle_epi8 (
+          lut, _mm256_and_si256 (_mm256_srli_epi16 (c, 4), mask));
+    lo_even = _mm256_add_epi16 (lo_even, _mm256_and_si256 (lo, lomask));
+    lo_odd = _mm256_add_epi16 (lo_odd, _mm256_srli_epi16 (lo, 8));
+    hi_even = _mm256_add_epi16 (hi_even, _mm256_and_si256 (hi, lomask));
+    hi_odd = _mm256_add_epi16 (hi_odd, _mm256_srli_epi16 (hi, 8));
+}
+
+/// sums both halves and interleaves even and odd vectors back in order
+inline void store_half (__m256i even, __m256i odd, uint16_t *out)
+{
+    __m128i e = _mm_add_epi16 (_mm256_castsi256_si128 (even),
+                               _mm256_extracti128_si256 (even, 1));
+    __m128i o = _mm_add_epi16 (_mm256_castsi256_si128 (odd),
+                               _mm256_extracti128_si256 (odd, 1));
+    _mm_storeu_si128 ((__m128i*)out, _mm_unpacklo_epi16 (e, o));
+    _mm_storeu_si128 ((__m128i*)(out + 8), _mm_unpackhi_epi16 (e, o));
+}
+
+} // namespace
+
+void pq4_accumulate_avx (size_t nblocks, size_t M2,
+                         const uint8_t *blocks, const uint8_t *LUT,
+                         uint16_t *out)
+{
+    const __m256i mask = _mm256_set1_epi8 (15);
+    const __m256i lomask = _mm256_set1_epi16 (0xff);
+
+    for (size_t b = 0; b < nblocks; b++) {
+        __m256i lo_even = _mm256_setzero_si256 ();
+        __m256i lo_odd = _mm256_setzero_si256 ();
+        __m256i hi_even = _mm256_setzero_si256 ();
+        __m256i hi_odd = _mm256_setzero_si256 ();
+
+        for (size_t m = 0; m < M2; m += 2) {
+            __m256i c = _mm256_loadu_si256 ((const __m256i*)(blocks + m * 16));
+            __m256i lut = _mm256_loadu_si256 ((const __m256i*)(LUT + m * 16));
+            accumulate_pair (c, lut, mask, lomask,
+                             lo_even, lo_odd, hi_even, hi_odd);
+        }
+
+        store_half (lo_even, lo_odd, out);
+        store_half (hi_even, hi_odd, out + 16);
+
+        blocks += M2 * 16;
+        out += PQ4_BLOCK_SIZE;
+    }
+}
+
+} // namespace faiss
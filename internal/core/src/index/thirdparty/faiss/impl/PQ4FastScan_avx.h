@@ -0,0 +1,16 @@
+// -*- c++ -*-
+
+/* 4-bit PQ accumulation, implemented in PQ4FastScan_avx.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+void pq4_accumulate_avx (size_t nblocks, size_t M2,
+                         const uint8_t *blocks, const uint8_t *LUT,
+                         uint16_t *out);
+
+} // namespace faiss
@@ -0,0 +1,87 @@
+// -*- c++ -*-
+
+#include <faiss/impl/PQ4FastScan_avx512.h>
+#include <faiss/impl/PQ4FastScan.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+namespace {
+
+/// folds the upper 256 bits of a 512-bit accumulator onto the lower ones
+inline __m256i fold (__m512i x)
+{
+    return _mm256_add_epi16 (_mm512_castsi512_si256 (x),
+                             _mm512_extracti64x4_epi64 (x, 1));
+}
+
+/// sums the 128-bit lanes and interleaves even and odd vectors in order
+inline void store_half (__m256i even, __m256i odd, uint16_t *out)
+{
+    __m128i e = _mm_add_epi16 (_mm256_castsi256_si128 (even),
+                               _mm256_extracti128_si256 (even, 1));
+    __m128i o = _mm_add_epi16 (_mm256_castsi256_si128 (odd),
+                               _mm256_extracti128_si256 (odd, 1));
+    _mm_storeu_si128 ((__m128i*)out, _mm_unpacklo_epi16 (e, o));
+    _mm_storeu_si128 ((__m128i*)(out + 8), _mm_unpackhi_epi16 (e, o));
+}
+
+} // namespace
+
+/* Same as the AVX2 version with 4 sub-quantizers per register, one per
+ * 128-bit lane, and a 256-bit step when M2 is not a multiple of 4. */
+void pq4_accumulate_avx512 (size_t nblocks, size_t M2,
+                            const uint8_t *blocks, const uint8_t *LUT,
+                            uint16_t *out)
+{
+    const __m512i mask = _mm512_set1_epi8 (15);
+    const __m512i lomask = _mm512_set1_epi16 (0xff);
+    size_t M4 = M2 & ~(size_t)3;
+
+    for (size_t b = 0; b < nblocks; b++) {
+        __m512i lo_even = _mm512_setzero_si512 ();
+        __m512i lo_odd = _mm512_setzero_si512 ();
+        __m512i hi_even = _mm512_setzero_si512 ();
+        __m512i hi_odd = _mm512_setzero_si512 ();
+
+        for (size_t m = 0; m < M4; m += 4) {
+            __m512i c = _mm512_loadu_si512 ((const void*)(blocks + m * 16));
+            __m512i lut = _mm512_loadu_si512 ((const void*)(LUT + m * 16));
+            __m512i lo = _mm512_shuffle_epi8 (lut, _mm512_and_si512 (c, mask));
+            __m512i hi = _mm512_shuffle_epi8 (
+                  lut, _mm512_and_si512 (_mm512_srli_epi16 (c, 4), mask));
+            lo_even = _mm512_add_epi16 (lo_even, _mm512_and_si512 (lo, lomask));
+            lo_odd = _mm512_add_epi16 (lo_odd, _mm512_srli_epi16 (lo, 8));
+            hi_even = _mm512_add_epi16 (hi_even, _mm512_and_si512 (hi, lomask));
+            hi_odd = _mm512_add_epi16 (hi_odd, _mm512_srli_epi16 (hi, 8));
+        }
+
+        __m256i lo_even2 = fold (lo_even);
+        __m256i lo_odd2 = fold (lo_odd);
+        __m256i hi_even2 = fold (hi_even);
+        __m256i hi_odd2 = fold (hi_odd);
+
+        if (M4 < M2) {
+            const __m256i mask2 = _mm256_set1_epi8 (15);
+            const __m256i lomask2 = _mm256_set1_epi16 (0xff);
+            __m256i c = _mm256_loadu_si256 ((const __m256i*)(blocks + M4 * 16));
+            __m256i lut = _mm256_loadu_si256 ((const __m256i*)(LUT + M4 * 16));
+            __m256i lo = _mm256_shuffle_epi8 (lut, _mm256_and_si256 (c, mask2));
+            __m256i hi = _mm256_shuffle_epi8 (
+                  lut, _mm256_and_si256 (_mm256_srli_epi16 (c, 4), mask2));
+            lo_even2 = _mm256_add_epi16 (lo_even2, _mm256_and_si256 (lo, lomask2));
+            lo_odd2 = _mm256_add_epi16 (lo_odd2, _mm256_srli_epi16 (lo, 8));
+            hi_even2 = _mm256_add_epi16 (hi_even2, _mm256_and_si256 (hi, lomask2));
+            hi_odd2 = _mm256_add_epi16 (hi_odd2, _mm256_srli_epi16 (hi, 8));
+        }
+
+        store_half (lo_even2, lo_odd2, out);
+        store_half (hi_even2, hi_odd2, out + 16);
+
+        blocks += M2 * 16;
+        out += PQ4_BLOCK_SIZE;
+    }
+}
+
+} // namespace faiss
@@ -14,6 +14,7 @@
 #include <omp.h>
 #include <immintrin.h>
 
+#include <faiss/FaissHook.h>
 #include <faiss/utils/utils.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/impl/ScalarQuantizer.h>
@@ -468,10 +469,34 @@ struct DistanceComputerByte_avx512<Similarity, 16> : SQDistanceComputer {
 
     int d;
     std::vector<uint8_t> tmp;
+    bool use_vnni;
 
-    DistanceComputerByte_avx512(int d, const std::vector<float> &): d(d), tmp(d) {}
+    DistanceComputerByte_avx512(int d, const std::vector<float> &): d(d), tmp(d),
+        use_vnni(support_avx512_vnni()) {}
+
+    // vpdpwssd fuses the multiply and the accumulation of the 16-bit lanes
+    __attribute__((target("avx512vnni")))
+    int compute_code_distance_vnni(const uint8_t* code1, const uint8_t* code2) const {
+        __m512i accu = _mm512_setzero_si512 ();
+        for (int i = 0; i < d; i += 32) {
+            __m512i c1 = _mm512_cvtepu8_epi16
+                (_mm256_loadu_si256((__m256i*)(code1 + i)));
+            __m512i c2 = _mm512_cvtepu8_epi16
+                (_mm256_loadu_si256((__m256i*)(code2 + i)));
+            if (Sim::metric_type == METRIC_INNER_PRODUCT) {
+                accu = _mm512_dpwssd_epi32 (accu, c1, c2);
+            } else {
+                __m512i diff = _mm512_sub_epi16(c1, c2);
+                accu = _mm512_dpwssd_epi32 (accu, diff, diff);
+            }
+        }
+        return _mm512_reduce_add_epi32 (accu);
+    }
 
     int compute_code_distance(const uint8_t* code1, const uint8_t* code2) const {
+        if (use_vnni) {
+            return compute_code_distance_vnni(code1, code2);
+        }
         // __m256i accu = _mm256_setzero_ps ();
         __m512i accu = _mm512_setzero_si512 ();
         for (int i = 0; i < d; i += 32) {
@@ -11,6 +11,8 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
+#include <numeric>
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -29,6 +31,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -40,6 +43,7 @@
 #include <faiss/IndexLattice.h>
 
 #include <faiss/OnDiskInvertedLists.h>
+#include <faiss/BlockInvertedLists.h>
 #include <faiss/IndexBinaryFlat.h>
 #include <faiss/IndexBinaryFromFloat.h>
 #include <faiss/IndexBinaryHNSW.h>
@@ -197,6 +201,45 @@ static void read_ArrayInvertedLists_sizes (
     }
 }
 
+/// reads the lists of a sealed index straight into the packed buffers
+static ReadOnlyArrayInvertedLists *read_ReadOnlyArrayInvertedLists (
+        IOReader *f, bool with_codes)
+{
+    size_t nlist, code_size;
+    READ1 (nlist);
+    READ1 (code_size);
+    std::vector<size_t> sizes (nlist);
+    read_ArrayInvertedLists_sizes (f, sizes);
+    std::unique_ptr<ReadOnlyArrayInvertedLists> ails (
+            new ReadOnlyArrayInvertedLists (nlist, code_size, sizes));
+    size_t n = std::accumulate (sizes.begin(), sizes.end(), size_t(0));
+#ifdef USE_CPU
+    if (with_codes) {
+        ails->readonly_codes.resize (n * code_size);
+    }
+    ails->readonly_ids.resize (n);
+    uint8_t *codes = ails->readonly_codes.data();
+    InvertedLists::idx_t *ids = ails->readonly_ids.data();
+#else
+    // the IVF_NM lists keep their arranged data in the codes buffer
+    ails->pin_readonly_codes = std::make_shared<PageLockMemory>(n * code_size);
+    ails->pin_readonly_ids = std::make_shared<PageLockMemory>(n * sizeof(InvertedLists::idx_t));
+    uint8_t *codes = (uint8_t *) ails->pin_readonly_codes->data;
+    InvertedLists::idx_t *ids = (InvertedLists::idx_t *) ails->pin_readonly_ids->data;
+#endif
+    for (size_t i = 0; i < nlist; i++) {
+        size_t offset = ails->readonly_offset[i];
+        if (sizes[i] > 0) {
+            if (with_codes) {
+                READANDCHECK (codes + offset * code_size, sizes[i] * code_size);
+            }
+            READANDCHECK (ids + offset, sizes[i]);
+        }
+    }
+    ails->compact_ids ();
+    return ails.release();
+}
+
 InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
     uint32_t h;
     READ1 (h);
@@ -219,6 +262,7 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         ails->readonly_codes.resize(n*code_size);
         READANDCHECK(ails->readonly_ids.data(), n);
         READANDCHECK(ails->readonly_codes.data(), n * code_size);
+        ails->compact_ids();
 #else
         ails->pin_readonly_ids = std::make_shared<PageLockMemory>(n * sizeof(InvertedLists::idx_t));
         ails->pin_readonly_codes = std::make_shared<PageLockMemory>(n * code_size * sizeof(uint8_t));
@@ -226,6 +270,8 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         READANDCHECK((uint8_t *) ails->pin_readonly_codes->data, n * code_size);
 #endif
         return ails;
+    } else if (h == fourcc ("ilar") && (io_flags & IO_FLAG_READ_ONLY) && !(io_flags & IO_FLAG_MMAP)) {
+        return read_ReadOnlyArrayInvertedLists (f, true);
     } else if (h == fourcc ("ilar") && !(io_flags & IO_FLAG_MMAP)) {
         auto ails = new ArrayInvertedLists (0, 0);
         READ1 (ails->nlist);
@@ -286,6 +332,23 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         // resume normal reading of file
         fseek (fdesc, o, SEEK_SET);
         return ails;
+    } else if (h == fourcc ("ilbl")) {
+        size_t nlist, code_size, M;
+        READ1 (nlist);
+        READ1 (code_size);
+        READ1 (M);
+        auto bils = new BlockInvertedLists (nlist, M, code_size);
+        std::vector<size_t> sizes;
+        READVECTOR (sizes);
+        FAISS_THROW_IF_NOT (sizes.size() == nlist);
+        for (size_t i = 0; i < nlist; i++) {
+            bils->resize (i, sizes[i]);
+            if (sizes[i] > 0) {
+                READANDCHECK (bils->ids[i].data(), sizes[i]);
+                READANDCHECK (bils->codes[i].data(), bils->codes[i].size());
+            }
+        }
+        return bils;
     } else if (h == fourcc ("ilod")) {
         OnDiskInvertedLists *od = new OnDiskInvertedLists();
         od->read_only = io_flags & IO_FLAG_READ_ONLY;
@@ -354,6 +417,8 @@ InvertedLists *read_InvertedLists_nm (IOReader *f, int io_flags) {
     } else if (h == fourcc ("iloa") && !(io_flags & IO_FLAG_MMAP)) {
         // not going to happen
         return nullptr;
+    } else if (h == fourcc ("ilar") && (io_flags & IO_FLAG_READ_ONLY) && !(io_flags & IO_FLAG_MMAP)) {
+        return read_ReadOnlyArrayInvertedLists (f, false);
     } else if (h == fourcc ("ilar") && !(io_flags & IO_FLAG_MMAP)) {
         auto ails = new ArrayInvertedLists (0, 0);
         READ1 (ails->nlist);
@@ -758,6 +823,14 @@ Index *read_index (IOReader *f, int io_flags) {
         READVECTOR (ivsp->trained);
         read_InvertedLists (ivsp, f, io_flags);
         idx = ivsp;
+    } else if(h == fourcc ("IwPf")) {
+        IndexIVFPQFastScan * ivfs = new IndexIVFPQFastScan ();
+        read_ivf_header (ivfs, f);
+        READ1 (ivfs->by_residual);
+        READ1 (ivfs->code_size);
+        read_ProductQuantizer (&ivfs->pq, f);
+        read_InvertedLists (ivfs, f, io_flags);
+        idx = ivfs;
     } else if(h == fourcc ("IvPQ") || h == fourcc ("IvQR") ||
               h == fourcc ("IwPQ") || h == fourcc ("IwQR")) {
 
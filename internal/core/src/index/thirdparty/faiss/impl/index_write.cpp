@@ -11,6 +11,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <numeric>
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -29,6 +30,7 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/IndexIVFPQR.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFSpectralHash.h>
@@ -40,6 +42,7 @@
 #include <faiss/IndexLattice.h>
 
 #include <faiss/OnDiskInvertedLists.h>
+#include <faiss/BlockInvertedLists.h>
 #include <faiss/IndexBinaryFlat.h>
 #include <faiss/IndexBinaryFromFloat.h>
 #include <faiss/IndexBinaryHNSW.h>
@@ -249,9 +252,15 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
         WRITE1 (oa->code_size);
         WRITEVECTOR(oa->readonly_length);
 #ifdef USE_CPU
-        size_t n = oa->readonly_ids.size();
+        size_t n = std::accumulate(oa->readonly_length.begin(), oa->readonly_length.end(), size_t(0));
         WRITE1(n);
-        WRITEANDCHECK(oa->readonly_ids.data(), n);
+        // the ids may be compact, widen them list by list
+        for (size_t i = 0; i < oa->nlist; i++) {
+            if (oa->readonly_length[i] > 0) {
+                InvertedLists::ScopedIds ids (oa, i);
+                WRITEANDCHECK(ids.get(), oa->readonly_length[i]);
+            }
+        }
         WRITEANDCHECK(oa->readonly_codes.data(), n * oa->code_size);
 #else
         size_t n = oa->pin_readonly_ids->size() / sizeof(InvertedLists::idx_t);
@@ -259,6 +268,27 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
         WRITEANDCHECK((InvertedLists::idx_t *) oa->pin_readonly_ids->data, n);
         WRITEANDCHECK((uint8_t *) oa->pin_readonly_codes->data, n * oa->code_size);
 #endif
+    } else if (const auto & bils =
+               dynamic_cast<const BlockInvertedLists *>(ils)) {
+        uint32_t h = fourcc ("ilbl");
+        WRITE1 (h);
+        WRITE1 (bils->nlist);
+        WRITE1 (bils->code_size);
+        WRITE1 (bils->M);
+        std::vector<size_t> sizes;
+        for (size_t i = 0; i < bils->nlist; i++) {
+            sizes.push_back (bils->ids[i].size());
+        }
+        WRITEVECTOR (sizes);
+        // the blocks are written as they are, padding included
+        for (size_t i = 0; i < bils->nlist; i++) {
+            size_t n = bils->ids[i].size();
+            if (n > 0) {
+                WRITEANDCHECK (bils->ids[i].data(), n);
+                WRITEANDCHECK (bils->codes[i].data(),
+                               bils->list_blocks(i) * bils->block_size);
+            }
+        }
     } else if (const auto & od =
                dynamic_cast<const OnDiskInvertedLists *>(ils)) {
         uint32_t h = fourcc ("ilod");
@@ -335,7 +365,21 @@ void write_InvertedLists_nm (const InvertedLists *ils, IOWriter *f) {
         }
     } else if (const auto & oa =
             dynamic_cast<const ReadOnlyArrayInvertedLists *>(ils)) {
-        // not going to happen
+        // a sealed index is written back in the array layout it was read from
+        uint32_t h = fourcc ("ilar");
+        WRITE1 (h);
+        WRITE1 (oa->nlist);
+        WRITE1 (oa->code_size);
+        uint32_t list_type = fourcc("full");
+        WRITE1 (list_type);
+        WRITEVECTOR (oa->readonly_length);
+        for (size_t i = 0; i < oa->nlist; i++) {
+            size_t n = oa->readonly_length[i];
+            if (n > 0) {
+                InvertedLists::ScopedIds ids (oa, i);
+                WRITEANDCHECK (ids.get(), n);
+            }
+        }
     } else {
         fprintf(stderr, "WARN! write_InvertedLists: unsupported invlist type, "
                 "saving null invlist\n");
@@ -515,6 +559,15 @@ void write_index (const Index *idx, IOWriter *f) {
         WRITE1 (ivsp->threshold_type);
         WRITEVECTOR (ivsp->trained);
         write_InvertedLists (ivsp->invlists, f);
+    } else if(const IndexIVFPQFastScan * ivfs =
+              dynamic_cast<const IndexIVFPQFastScan *> (idx)) {
+        uint32_t h = fourcc ("IwPf");
+        WRITE1 (h);
+        write_ivf_header (ivfs, f);
+        WRITE1 (ivfs->by_residual);
+        WRITE1 (ivfs->code_size);
+        write_ProductQuantizer (&ivfs->pq, f);
+        write_InvertedLists (ivfs->invlists, f);
     } else if(const IndexIVFPQ * ivpq =
               dynamic_cast<const IndexIVFPQ *> (idx)) {
         const IndexIVFPQR * ivfpqr = dynamic_cast<const IndexIVFPQR *> (idx);
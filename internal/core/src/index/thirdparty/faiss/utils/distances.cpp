@@ -13,6 +13,8 @@
 #include <cassert>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <memory>
 
 #include <omp.h>
 #include <faiss/BuilderSuspend.h>
@@ -622,6 +624,76 @@ void knn_L2sqr (const float * x,
     }
 }
 
+void knn_inner_product_int8 (const int8_t * x,
+        const int8_t * y,
+        size_t d, size_t nx, size_t ny,
+        float_minheap_array_t * res,
+        const BitsetView bitset)
+{
+    size_t k = res->k;
+
+#pragma omp parallel for
+    for (size_t i = 0; i < nx; i++) {
+        const int8_t *x_i = x + i * d;
+        const int8_t *y_j = y;
+
+        float * __restrict val_ = res->val + i * k;
+        int64_t * __restrict ids_ = res->ids + i * k;
+
+        for (size_t j = 0; j < k; j++) {
+            val_[j] = -1.0 / 0.0;
+            ids_[j] = -1;
+        }
+
+        for (size_t j = 0; j < ny; j++) {
+            if (!bitset || !bitset.test(j)) {
+                float disij = i8vec_inner_product (x_i, y_j, d);
+                if (disij > val_[0]) {
+                    minheap_swap_top (k, val_, ids_, disij, j);
+                }
+            }
+            y_j += d;
+        }
+
+        minheap_reorder (k, val_, ids_);
+    }
+}
+
+void knn_L2sqr_int8 (const int8_t * x,
+        const int8_t * y,
+        size_t d, size_t nx, size_t ny,
+        float_maxheap_array_t * res,
+        const BitsetView bitset)
+{
+    size_t k = res->k;
+
+#pragma omp parallel for
+    for (size_t i = 0; i < nx; i++) {
+        const int8_t *x_i = x + i * d;
+        const int8_t *y_j = y;
+
+        float * __restrict val_ = res->val + i * k;
+        int64_t * __restrict ids_ = res->ids + i * k;
+
+        for (size_t j = 0; j < k; j++) {
+            val_[j] = 1.0 / 0.0;
+            ids_[j] = -1;
+        }
+
+        for (size_t j = 0; j < ny; j++) {
+            if (!bitset || !bitset.test(j)) {
+                float disij = i8vec_L2sqr (x_i, y_j, d);
+                if (disij < val_[0]) {
+                    maxheap_swap_top (k, val_, ids_, disij, j);
+                }
+            }
+            y_j += d;
+        }
+
+        maxheap_reorder (k, val_, ids_);
+    }
+}
+
 void knn_jaccard (const float * x,
                   const float * y,
                   size_t d, size_t nx, size_t ny,
@@ -655,6 +727,95 @@ void knn_L2sqr_base_shift (
     knn_L2sqr_blas (x, y, d, nx, ny, res, corr);
 }
 
+namespace {
+
+template<MetricType metric, class C>
+size_t knn_add_to_heaps_blas_tpl (const float * x, const float * y,
+                                  const int64_t * ids,
+                                  size_t d, size_t nx, size_t ny,
+                                  const float * x_shift, size_t k,
+                                  float * distances, int64_t * labels,
+                                  const BitsetView bitset)
+{
+    /* block sizes, an ip block of 256kB */
+    const size_t bs_x = 256, bs_y = 256;
+    std::unique_ptr<float[]> ip_block (new float[bs_x * bs_y]);
+    std::unique_ptr<float[]> x_norms (new float[nx]);
+    std::unique_ptr<float[]> y_norms (new float[bs_y]);
+
+    if (metric == METRIC_L2) {
+        fvec_norms_L2sqr (x_norms.get(), x, d, nx);
+    }
+
+    size_t nup = 0;
+    for (size_t j0 = 0; j0 < ny; j0 += bs_y) {
+        size_t j1 = std::min (ny, j0 + bs_y);
+        if (metric == METRIC_L2) {
+            fvec_norms_L2sqr (y_norms.get(), y + j0 * d, d, j1 - j0);
+        }
+        for (size_t i0 = 0; i0 < nx; i0 += bs_x) {
+            size_t i1 = std::min (nx, i0 + bs_x);
+            {
+                float one = 1, zero = 0;
+                FINTEGER nyi = j1 - j0, nxi = i1 - i0, di = d;
+                sgemm_ ("Transpose", "Not transpose", &nyi, &nxi, &di, &one,
+                        y + j0 * d, &di,
+                        x + i0 * d, &di, &zero,
+                        ip_block.get(), &nyi);
+            }
+            for (size_t i = i0; i < i1; i++) {
+                float * simi = distances + i * k;
+                int64_t * idxi = labels + i * k;
+                const float *ip_line = ip_block.get() + (i - i0) * (j1 - j0);
+                float shift = x_shift ? x_shift[i] : 0;
+                for (size_t j = j0; j < j1; j++, ip_line++) {
+                    int64_t id = ids ? ids[j] : j;
+                    if (bitset && bitset.test(id)) {
+                        continue;
+                    }
+                    float dis;
+                    if (metric == METRIC_L2) {
+                        dis = x_norms[i] + y_norms[j - j0] - 2 * *ip_line;
+                        // negative values can occur for identical vectors
+                        // due to roundoff errors
+                        if (dis < 0) dis = 0;
+                    } else {
+                        dis = *ip_line + shift;
+                    }
+                    if (C::cmp (simi[0], dis)) {
+                        heap_swap_top<C> (k, simi, idxi, dis, id);
+                        nup++;
+                    }
+                }
+            }
+        }
+    }
+    return nup;
+}
+
+} // anonymous namespace
+
+size_t knn_add_to_heaps_blas (const float * x, const float * y,
+                              const int64_t * ids,
+                              size_t d, size_t nx, size_t ny,
+                              MetricType metric, const float * x_shift,
+                              size_t k, float * distances, int64_t * labels,
+                              const BitsetView bitset)
+{
+    // BLAS does not like empty matrices
+    if (nx == 0 || ny == 0) return 0;
+
+    if (metric == METRIC_INNER_PRODUCT) {
+        return knn_add_to_heaps_blas_tpl<METRIC_INNER_PRODUCT,
+                                         CMin<float, int64_t> >
+            (x, y, ids, d, nx, ny, x_shift, k, distances, labels, bitset);
+    } else if (metric == METRIC_L2) {
+        return knn_add_to_heaps_blas_tpl<METRIC_L2, CMax<float, int64_t> >
+            (x, y, ids, d, nx, ny, x_shift, k, distances, labels, bitset);
+    }
+    FAISS_THROW_MSG ("metric type not supported");
+}
+
 
 
 /***************************************************************************
@@ -14,6 +14,7 @@
 
 #include <stdint.h>
 
+#include <faiss/MetricType.h>
 #include <faiss/utils/Heap.h>
 #include <faiss/utils/ConcurrentBitset.h>
 #include <faiss/utils/BitsetView.h>
@@ -48,6 +49,18 @@ float fvec_Linf_sse (
         size_t d);
 #endif
 
+/// int8 vectors, exact in the integer domain. FaissHook picks the SIMD
+/// versions as i8vec_inner_product and i8vec_L2sqr
+int32_t i8vec_inner_product_ref (
+        const int8_t * x,
+        const int8_t * y,
+        size_t d);
+
+int32_t i8vec_L2sqr_ref (
+        const int8_t * x,
+        const int8_t * y,
+        size_t d);
+
 /** Compute pairwise distances between sets of vectors
  *
  * @param d     dimension of the vectors
@@ -180,6 +193,22 @@ void knn_L2sqr (
         float_maxheap_array_t * res,
         const BitsetView bitset = nullptr);
 
+/** Same as knn_inner_product and knn_L2sqr, for int8 vectors with
+ * i8vec_inner_product and i8vec_L2sqr */
+void knn_inner_product_int8 (
+        const int8_t * x,
+        const int8_t * y,
+        size_t d, size_t nx, size_t ny,
+        float_minheap_array_t * res,
+        const BitsetView bitset = nullptr);
+
+void knn_L2sqr_int8 (
+        const int8_t * x,
+        const int8_t * y,
+        size_t d, size_t nx, size_t ny,
+        float_maxheap_array_t * res,
+        const BitsetView bitset = nullptr);
+
 void knn_jaccard (
         const float * x,
         const float * y,
@@ -199,6 +228,28 @@ void knn_L2sqr_base_shift (
          float_maxheap_array_t * res,
          const float *base_shift);
 
+/** Adds the ny vectors to the result heaps of the nx queries, the
+ * distances are computed with sgemm.
+ *
+ * @param ids        ids of the y vectors, size ny, or nullptr for
+ *                   their positions in y
+ * @param x_shift    added to the inner products of each query, size nx
+ *                   or nullptr. Not used for L2
+ * @param distances, labels
+ *                   initialized result heaps, size nx * k
+ * @return           nb of heap updates
+ */
+size_t knn_add_to_heaps_blas (
+        const float * x,
+        const float * y,
+        const int64_t * ids,
+        size_t d, size_t nx, size_t ny,
+        MetricType metric,
+        const float * x_shift,
+        size_t k,
+        float * distances, int64_t * labels,
+        const BitsetView bitset = nullptr);
+
 /* Find the nearest neighbors for nx queries in a set of ny vectors
  * indexed by ids. May be useful for re-ranking a pre-selected vector list
  */
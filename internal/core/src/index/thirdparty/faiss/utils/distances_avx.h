@@ -31,6 +31,13 @@ fvec_L1_avx(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx(const float* x, const float* y, size_t d);
 
+/// int8 inner product and squared L2, widened to int16 so -128 stays exact
+int32_t
+i8vec_inner_product_avx(const int8_t* x, const int8_t* y, size_t d);
+
+int32_t
+i8vec_L2sqr_avx(const int8_t* x, const int8_t* y, size_t d);
+
 /// binary distance
 int
 xor_popcnt_AVX2_lookup(const uint8_t* data1, const uint8_t* data2, const size_t n);
@@ -30,6 +30,20 @@ fvec_L1_avx512(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx512(const float* x, const float* y, size_t d);
 
+/// int8 inner product and squared L2
+int32_t
+i8vec_inner_product_avx512(const int8_t* x, const int8_t* y, size_t d);
+
+int32_t
+i8vec_L2sqr_avx512(const int8_t* x, const int8_t* y, size_t d);
+
+/// same with AVX512-VNNI dot products, only call when the cpu has it
+int32_t
+i8vec_inner_product_avx512_vnni(const int8_t* x, const int8_t* y, size_t d);
+
+int32_t
+i8vec_L2sqr_avx512_vnni(const int8_t* x, const int8_t* y, size_t d);
+
 /// popcnt
 int
 popcnt_AVX512VBMI_lookup(const uint8_t* data, const size_t n);
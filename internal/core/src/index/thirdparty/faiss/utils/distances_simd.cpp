@@ -102,6 +102,28 @@ float fvec_inner_product_ref (const float * x,
     return res;
 }
 
+int32_t i8vec_inner_product_ref (const int8_t * x,
+                                 const int8_t * y,
+                                 size_t d)
+{
+    int32_t res = 0;
+    for (size_t i = 0; i < d; i++)
+       res += int32_t(x[i]) * int32_t(y[i]);
+    return res;
+}
+
+int32_t i8vec_L2sqr_ref (const int8_t * x,
+                         const int8_t * y,
+                         size_t d)
+{
+    int32_t res = 0;
+    for (size_t i = 0; i < d; i++) {
+        const int32_t tmp = int32_t(x[i]) - int32_t(y[i]);
+        res += tmp * tmp;
+    }
+    return res;
+}
+
 float fvec_norm_L2sqr_ref (const float *x, size_t d)
 {
     size_t i;
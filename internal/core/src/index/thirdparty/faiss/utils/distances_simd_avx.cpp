@@ -180,6 +180,47 @@ float fvec_L2sqr_avx (const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+static inline int32_t _mm256_hsum_epi32 (__m256i v) {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+// pmaddubsw would saturate the int16 pair sums, so both sides are widened
+// to int16 first and multiplied with pmaddwd, which is exact
+int32_t i8vec_inner_product_avx (const int8_t* x, const int8_t* y, size_t d) {
+    __m256i msum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= d; i += 16) {
+        __m256i mx = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(x + i)));
+        __m256i my = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(y + i)));
+        msum = _mm256_add_epi32(msum, _mm256_madd_epi16(mx, my));
+    }
+    int32_t res = _mm256_hsum_epi32(msum);
+    for (; i < d; i++) {
+        res += int32_t(x[i]) * int32_t(y[i]);
+    }
+    return res;
+}
+
+int32_t i8vec_L2sqr_avx (const int8_t* x, const int8_t* y, size_t d) {
+    __m256i msum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= d; i += 16) {
+        __m256i mx = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(x + i)));
+        __m256i my = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(y + i)));
+        __m256i diff = _mm256_sub_epi16(mx, my);
+        msum = _mm256_add_epi32(msum, _mm256_madd_epi16(diff, diff));
+    }
+    int32_t res = _mm256_hsum_epi32(msum);
+    for (; i < d; i++) {
+        const int32_t tmp = int32_t(x[i]) - int32_t(y[i]);
+        res += tmp * tmp;
+    }
+    return res;
+}
+
 float fvec_L1_avx (const float * x, const float * y, size_t d)
 {
     __m256 msum1 = _mm256_setzero_ps();
@@ -502,6 +543,16 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+int32_t i8vec_inner_product_avx (const int8_t* x, const int8_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int32_t i8vec_L2sqr_avx (const int8_t* x, const int8_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
 #endif
 
 } // namespace faiss
@@ -236,6 +236,75 @@ std::uint64_t _mm512_hsum_epi64(__m512i v) {
 }
 
 
+int32_t
+i8vec_inner_product_avx512(const int8_t* x, const int8_t* y, size_t d) {
+    __m512i msum = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 32 <= d; i += 32) {
+        __m512i mx = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(x + i)));
+        __m512i my = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(y + i)));
+        msum = _mm512_add_epi32(msum, _mm512_madd_epi16(mx, my));
+    }
+    int32_t res = _mm512_reduce_add_epi32(msum);
+    for (; i < d; i++) {
+        res += int32_t(x[i]) * int32_t(y[i]);
+    }
+    return res;
+}
+
+int32_t
+i8vec_L2sqr_avx512(const int8_t* x, const int8_t* y, size_t d) {
+    __m512i msum = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 32 <= d; i += 32) {
+        __m512i mx = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(x + i)));
+        __m512i my = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(y + i)));
+        __m512i diff = _mm512_sub_epi16(mx, my);
+        msum = _mm512_add_epi32(msum, _mm512_madd_epi16(diff, diff));
+    }
+    int32_t res = _mm512_reduce_add_epi32(msum);
+    for (; i < d; i++) {
+        const int32_t tmp = int32_t(x[i]) - int32_t(y[i]);
+        res += tmp * tmp;
+    }
+    return res;
+}
+
+// vpdpbusd multiplies unsigned by signed bytes, so x is shifted to x + 128
+// and the 128 * sum(y) it adds is taken out again at the end
+__attribute__((target("avx512vnni"))) int32_t
+i8vec_inner_product_avx512_vnni(const int8_t* x, const int8_t* y, size_t d) {
+    const __m512i offset = _mm512_set1_epi8(-128);
+    const __m512i ones = _mm512_set1_epi8(1);
+    __m512i msum = _mm512_setzero_si512();
+    __m512i ysum = _mm512_setzero_si512();
+    for (size_t i = 0; i < d; i += 64) {
+        const __mmask64 mask = d - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (d - i)) - 1;
+        __m512i mx = _mm512_maskz_loadu_epi8(mask, x + i);
+        __m512i my = _mm512_maskz_loadu_epi8(mask, y + i);
+        msum = _mm512_dpbusd_epi32(msum, _mm512_xor_si512(mx, offset), my);
+        ysum = _mm512_dpbusd_epi32(ysum, ones, my);
+    }
+    return _mm512_reduce_add_epi32(msum) - 128 * _mm512_reduce_add_epi32(ysum);
+}
+
+__attribute__((target("avx512vnni"))) int32_t
+i8vec_L2sqr_avx512_vnni(const int8_t* x, const int8_t* y, size_t d) {
+    __m512i msum = _mm512_setzero_si512();
+    for (size_t i = 0; i < d; i += 64) {
+        const __mmask64 mask = d - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (d - i)) - 1;
+        __m512i mx = _mm512_maskz_loadu_epi8(mask, x + i);
+        __m512i my = _mm512_maskz_loadu_epi8(mask, y + i);
+        __m512i diff_lo = _mm512_sub_epi16(_mm512_cvtepi8_epi16(_mm512_castsi512_si256(mx)),
+                                           _mm512_cvtepi8_epi16(_mm512_castsi512_si256(my)));
+        __m512i diff_hi = _mm512_sub_epi16(_mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(mx, 1)),
+                                           _mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(my, 1)));
+        msum = _mm512_dpwssd_epi32(msum, diff_lo, diff_lo);
+        msum = _mm512_dpwssd_epi32(msum, diff_hi, diff_hi);
+    }
+    return _mm512_reduce_add_epi32(msum);
+}
+
 int
 popcnt_AVX512VBMI_lookup(const uint8_t* data, const size_t n) {
 
@@ -451,6 +520,30 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+int32_t
+i8vec_inner_product_avx512(const int8_t* x, const int8_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int32_t
+i8vec_L2sqr_avx512(const int8_t* x, const int8_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int32_t
+i8vec_inner_product_avx512_vnni(const int8_t* x, const int8_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+int32_t
+i8vec_L2sqr_avx512_vnni(const int8_t* x, const int8_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
 #endif
 
 } // namespace faiss
@@ -288,6 +288,10 @@ class InstructionSet {
     PREFETCHWT1(void) {
         return f_7_ECX_[0];
     }
+    bool
+    AVX512VNNI(void) {
+        return f_7_ECX_[11];
+    }
 
     bool
     LAHF(void) {
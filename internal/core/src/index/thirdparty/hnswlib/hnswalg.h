@@ -317,6 +317,101 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return top_candidates;
     }
 
+    // Base-layer search for selective filters: only rows passing the bitset are scored and kept as candidates,
+    // a filtered neighbour is not a dead end but is hopped over by expanding its own neighbour list.
+    std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
+    searchBaseLayerExpandST(tableint ep_id, const void *data_point, size_t ef, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+        vl_type *visited_array = vl->mass;
+        vl_type visited_array_tag = vl->curV;
+
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
+
+        dist_t lowerBound = std::numeric_limits<dist_t>::max();
+
+        auto is_filtered = [&](tableint id) {
+            return (int64_t)id < bitset.size() && bitset.test((faiss::ConcurrentBitset::id_type_t)(id));
+        };
+        auto try_add = [&](tableint id) {
+            visited_array[id] = visited_array_tag;
+            dist_t dist = fstdistfunc_(data_point, getDataByInternalId(id), dist_func_param_);
+            if (top_candidates.size() < ef || lowerBound > dist) {
+                candidate_set.emplace(-dist, id);
+                top_candidates.emplace(dist, id);
+                if (top_candidates.size() > ef)
+                    top_candidates.pop();
+                lowerBound = top_candidates.top().first;
+            }
+        };
+
+        visited_array[ep_id] = visited_array_tag;
+        if (!is_filtered(ep_id)) {
+            try_add(ep_id);
+        } else {
+            // the entry point is filtered out, walk through filtered nodes until some passing ones are reached
+            std::vector<tableint> frontier{ep_id};
+            std::vector<tableint> next;
+            while (candidate_set.empty() && !frontier.empty()) {
+                next.clear();
+                for (auto node : frontier) {
+                    int *data = (int *) get_linklist0(node);
+                    size_t size = getListCount((linklistsizeint*)data);
+                    for (size_t j = 1; j <= size; j++) {
+                        tableint candidate_id = *(data + j);
+                        if (visited_array[candidate_id] == visited_array_tag) continue;
+                        if (is_filtered(candidate_id)) {
+                            visited_array[candidate_id] = visited_array_tag;
+                            next.push_back(candidate_id);
+                        } else {
+                            try_add(candidate_id);
+                        }
+                    }
+                }
+                frontier.swap(next);
+            }
+        }
+
+        while (!candidate_set.empty()) {
+            std::pair<dist_t, tableint> current_node_pair = candidate_set.top();
+            if ((-current_node_pair.first) > lowerBound) {
+                break;
+            }
+            candidate_set.pop();
+
+            int *data = (int *) get_linklist0(current_node_pair.second);
+            size_t size = getListCount((linklistsizeint*)data);
+#ifdef USE_SSE
+            _mm_prefetch((char *) (visited_array + *(data + 1)), _MM_HINT_T0);
+            _mm_prefetch((char *) (data + 2), _MM_HINT_T0);
+#endif
+            for (size_t j = 1; j <= size; j++) {
+                tableint candidate_id = *(data + j);
+                if (visited_array[candidate_id] == visited_array_tag) continue;
+                if (!is_filtered(candidate_id)) {
+                    try_add(candidate_id);
+                    continue;
+                }
+
+                // neighbour-of-neighbour expansion through the filtered node
+                visited_array[candidate_id] = visited_array_tag;
+                int *hop_data = (int *) get_linklist0(candidate_id);
+                size_t hop_size = getListCount((linklistsizeint*)hop_data);
+#ifdef USE_SSE
+                _mm_prefetch((char *) (visited_array + *(hop_data + 1)), _MM_HINT_T0);
+#endif
+                for (size_t h = 1; h <= hop_size; h++) {
+                    tableint hop_id = *(hop_data + h);
+                    if (visited_array[hop_id] == visited_array_tag || is_filtered(hop_id)) continue;
+                    try_add(hop_id);
+                }
+            }
+        }
+
+        visited_list_pool_->releaseVisitedList(vl);
+        return top_candidates;
+    }
+
     std::vector<tableint>
     getNeighborsByHeuristic2 (
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> &top_candidates,
@@ -894,11 +989,35 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return cur_c;
     };
 
+    // Exhaustive scan over the rows passing the bitset, used when so few rows pass that walking the graph
+    // would either visit most of it or lose recall.
     std::priority_queue<std::pair<dist_t, labeltype >>
-    searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+    searchKnnBF(const void *query_data, size_t k, const faiss::BitsetView bitset) const {
         std::priority_queue<std::pair<dist_t, labeltype >> result;
-        if (cur_element_count == 0) return result;
+        const uint8_t *blocks = bitset.data();
+        for (tableint id = 0; id < cur_element_count; ++id) {
+            if ((int64_t)id < bitset.size()) {
+                // skip whole bytes of filtered rows at once
+                if ((id & 7) == 0 && blocks[id >> 3] == 0xFF && (int64_t)id + 8 <= bitset.size()) {
+                    id += 7;
+                    continue;
+                }
+                if (bitset.test((faiss::ConcurrentBitset::id_type_t)(id))) continue;
+            }
+            dist_t dist = fstdistfunc_(query_data, getDataByInternalId(id), dist_func_param_);
+            if (result.size() < k) {
+                result.emplace(dist, id);
+            } else if (dist < result.top().first) {
+                result.pop();
+                result.emplace(dist, id);
+            }
+        }
+        return result;
+    };
 
+    // Greedy descent through the upper layers, returns the entry point of the base layer.
+    tableint
+    searchUpperLayers(const void *query_data, StatisticsInfo &stats) const {
         tableint currObj = enterpoint_node_;
         dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
 
@@ -928,9 +1047,81 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
                 }
             }
         }
+        return currObj;
+    };
+
+    // Range search: all rows passing the bitset with distance < radius, unsorted. The ef nearest rows found by
+    // the regular walk seed a breadth-first expansion that follows neighbours as long as they are within radius,
+    // filtered rows within radius are expanded but not reported.
+    std::vector<std::pair<dist_t, labeltype>>
+    searchRange(const void *query_data, dist_t radius, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        std::vector<std::pair<dist_t, labeltype>> result;
+        if (cur_element_count == 0) return result;
+
+        tableint currObj = searchUpperLayers(query_data, stats);
+        auto seeds = searchBaseLayerST<false>(currObj, query_data, ef_, bitset, stats);
+
+        VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+        vl_type *visited_array = vl->mass;
+        vl_type visited_array_tag = vl->curV;
+
+        auto is_filtered = [&](tableint id) {
+            return (int64_t)id < bitset.size() && bitset.test((faiss::ConcurrentBitset::id_type_t)(id));
+        };
+        std::vector<tableint> frontier;
+        auto visit = [&](tableint id, dist_t dist) {
+            visited_array[id] = visited_array_tag;
+            if (dist < radius) {
+                frontier.push_back(id);
+                if (!is_filtered(id)) {
+                    result.emplace_back(dist, id);
+                }
+            }
+        };
+
+        while (!seeds.empty()) {
+            visit(seeds.top().second, seeds.top().first);
+            seeds.pop();
+        }
+        while (!frontier.empty()) {
+            tableint node = frontier.back();
+            frontier.pop_back();
+            int *data = (int *) get_linklist0(node);
+            size_t size = getListCount((linklistsizeint*)data);
+#ifdef USE_SSE
+            _mm_prefetch((char *) (visited_array + *(data + 1)), _MM_HINT_T0);
+#endif
+            for (size_t j = 1; j <= size; j++) {
+                tableint candidate_id = *(data + j);
+                if (visited_array[candidate_id] == visited_array_tag) continue;
+                visit(candidate_id, fstdistfunc_(query_data, getDataByInternalId(candidate_id), dist_func_param_));
+            }
+        }
+
+        visited_list_pool_->releaseVisitedList(vl);
+        return result;
+    };
+
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        return searchKnn(query_data, k, bitset, stats, false);
+    };
+
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats,
+              bool expand_filtered) const {
+        std::priority_queue<std::pair<dist_t, labeltype >> result;
+        if (cur_element_count == 0) return result;
+
+        tableint currObj = searchUpperLayers(query_data, stats);
 
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
-        if (!bitset.empty()) {
+        if (!bitset.empty() && expand_filtered) {
+            std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
+                top_candidates1 = searchBaseLayerExpandST(currObj, query_data, std::max(ef_, k), bitset, stats);
+            top_candidates.swap(top_candidates1);
+        }
+        else if (!bitset.empty()) {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
                 top_candidates1 = searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset, stats);
             top_candidates.swap(top_candidates1);
@@ -0,0 +1,114 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <faiss/Clustering.h>
+#include <faiss/IndexFlat.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr int64_t dim = 32;
+constexpr int64_t nb = 20000;
+constexpr int64_t nlist = 64;
+
+// points around 2 * nlist gaussian centers
+std::vector<float>
+GenMixture() {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist;
+    std::vector<float> centers(2 * nlist * dim);
+    for (auto& x : centers) {
+        x = 4 * dist(rng);
+    }
+    std::vector<float> data(nb * dim);
+    for (int64_t i = 0; i < nb; ++i) {
+        auto center = centers.data() + (i % (2 * nlist)) * dim;
+        for (int64_t j = 0; j < dim; ++j) {
+            data[i * dim + j] = center[j] + dist(rng);
+        }
+    }
+    return data;
+}
+
+// sum of the squared distances of all the points to their nearest centroid
+double
+Objective(const std::vector<float>& data, const std::vector<float>& centroids) {
+    faiss::IndexFlatL2 index(dim);
+    index.add(centroids.size() / dim, centroids.data());
+    std::vector<float> distances(nb);
+    std::vector<faiss::Index::idx_t> labels(nb);
+    index.search(nb, data.data(), 1, distances.data(), labels.data());
+    double obj = 0;
+    for (auto d : distances) {
+        obj += d;
+    }
+    return obj;
+}
+}  // namespace
+
+TEST(ClusteringTest, prune_assign_same_as_lloyd) {
+    auto data = GenMixture();
+    std::vector<float> centroids[2];
+    for (int prune = 0; prune < 2; ++prune) {
+        faiss::ClusteringParameters cp;
+        cp.niter = 10;
+        cp.max_points_per_centroid = nb;
+        cp.prune_assign = prune;
+        faiss::Clustering clus(dim, nlist, cp);
+        faiss::IndexFlatL2 index(dim);
+        clus.train(nb, data.data(), index);
+        centroids[prune] = clus.centroids;
+    }
+    for (size_t i = 0; i < centroids[0].size(); ++i) {
+        ASSERT_NEAR(centroids[0][i], centroids[1][i], 1e-3 * std::max(1.0f, std::abs(centroids[0][i])));
+    }
+}
+
+TEST(ClusteringTest, kmeans_parallel_mini_batch) {
+    auto data = GenMixture();
+
+    faiss::ClusteringParameters cp;
+    cp.niter = 10;
+    cp.max_points_per_centroid = nb;
+    faiss::Clustering lloyd(dim, nlist, cp);
+    faiss::IndexFlatL2 lloyd_index(dim);
+    lloyd.train(nb, data.data(), lloyd_index);
+    auto lloyd_obj = Objective(data, lloyd.centroids);
+
+    // k-means|| seeding on a stratified sample, then mini-batch iterations
+    faiss::clustering_type = faiss::ClusteringType::K_MEANS_PARALLEL;
+    faiss::kmeans_mini_batch_size = 2048;
+    cp.niter = 20;
+    cp.max_points_per_centroid = 128;
+    faiss::Clustering fast(dim, nlist, cp);
+    faiss::IndexFlatL2 fast_index(dim);
+    fast.train(nb, data.data(), fast_index);
+    faiss::clustering_type = faiss::ClusteringType::K_MEANS;
+    faiss::kmeans_mini_batch_size = 0;
+
+    ASSERT_EQ(fast.centroids.size(), nlist * dim);
+    ASSERT_EQ(fast_index.ntotal, nlist);
+    EXPECT_LT(Objective(data, fast.centroids), 1.1 * lloyd_obj);
+
+    // k-means|| alone with the full iterations
+    faiss::clustering_type = faiss::ClusteringType::K_MEANS_PARALLEL;
+    cp.niter = 10;
+    cp.max_points_per_centroid = nb;
+    faiss::Clustering seeded(dim, nlist, cp);
+    faiss::IndexFlatL2 seeded_index(dim);
+    seeded.train(nb, data.data(), seeded_index);
+    faiss::clustering_type = faiss::ClusteringType::K_MEANS;
+    EXPECT_LT(Objective(data, seeded.centroids), 1.05 * lloyd_obj);
+}
@@ -12,9 +12,11 @@
 #include <gtest/gtest.h>
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include <iostream>
 #include <random>
+#include <set>
 #include "knowhere/common/Exception.h"
 #include "unittest/utils.h"
 
@@ -152,6 +154,71 @@ TEST_P(HNSWTest, HNSW_delete) {
     */
 }
 
+TEST_P(HNSWTest, HNSW_filter_ratio) {
+    assert(!xb.empty());
+
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+
+    // pass ratio 1/100 takes the brute force path, 1/10 the expanded graph walk, 1/2 the plain walk
+    for (auto step : {100, 10, 2}) {
+        faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+        for (auto i = 0; i < nb; ++i) {
+            if (i % step != 0) {
+                bitset->set(i);
+            }
+        }
+
+        auto result = index_->Query(query_dataset, conf, bitset);
+        auto res_ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        for (int64_t i = 0; i < nq; i++) {
+            for (int64_t j = 0; j < k; j++) {
+                auto id = res_ids[i * k + j];
+                ASSERT_NE(id, -1);
+                ASSERT_EQ(id % step, 0);
+            }
+        }
+        // query 0 is base vector 0, which passes for every step
+        ASSERT_EQ(res_ids[0], 0);
+        ReleaseQueryResult(result);
+    }
+}
+
+TEST_P(HNSWTest, HNSW_range) {
+    assert(!xb.empty());
+
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+
+    // take the distance of the k-th neighbour as radius, so the k - 1 closer neighbours fall into the range
+    auto knn = index_->Query(query_dataset, conf, nullptr);
+    auto knn_ids = knn->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto knn_dis = knn->Get<float*>(milvus::knowhere::meta::DISTANCE);
+
+    for (int64_t i = 0; i < nq; i++) {
+        auto range_conf = conf;
+        range_conf[milvus::knowhere::IndexParams::range_search_radius] = knn_dis[i * k + k - 1];
+        auto qd = milvus::knowhere::GenDataset(1, dim, xq.data() + i * dim);
+        auto result = index_->QueryByRange(qd, range_conf, nullptr);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto distances = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto lims = result->Get<size_t*>(milvus::knowhere::meta::LIMS);
+
+        std::set<int64_t> actual(ids + lims[0], ids + lims[1]);
+        for (int64_t j = 0; j < k - 1; j++) {
+            ASSERT_TRUE(actual.count(knn_ids[i * k + j]));
+        }
+        for (auto j = lims[0]; j < lims[1]; ++j) {
+            ASSERT_LT(distances[j], knn_dis[i * k + k - 1]);
+        }
+        free(ids);
+        free(distances);
+        free(lims);
+    }
+    ReleaseQueryResult(knn);
+}
+
 /*
 TEST_P(HNSWTest, HNSW_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
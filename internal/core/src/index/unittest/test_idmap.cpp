@@ -14,6 +14,7 @@
 #include <fiu-control.h>
 #include <fiu/fiu-local.h>
 #include <iostream>
+#include <set>
 #include <thread>
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 
@@ -456,6 +457,51 @@ TEST_P(IDMAPTest, idmap_dynamic_result_set) {
     }
 }
 
+TEST_P(IDMAPTest, idmap_query_by_range) {
+    // the radius of QueryByRange is in the unit of the reported distances, i.e. squared for L2
+    auto rds = radius * radius;
+    milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                  {milvus::knowhere::IndexParams::range_search_radius, rds},
+                                  {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, milvus::knowhere::Config());
+
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nb; i += 2) {
+        bitset->set(i);
+    }
+
+    auto result = index_->QueryByRange(query_dataset, conf, bitset);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto distances = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto lims = result->Get<size_t*>(milvus::knowhere::meta::LIMS);
+
+    for (auto i = 0; i < nq; ++i) {
+        const float* pq = xq.data() + i * dim;
+        std::set<int64_t> expected;
+        for (auto j = 1; j < nb; j += 2) {
+            const float* pb = xb.data() + j * dim;
+            float dist = 0;
+            for (auto d = 0; d < dim; ++d) {
+                dist += (pq[d] - pb[d]) * (pq[d] - pb[d]);
+            }
+            if (dist < rds) {
+                expected.insert(j);
+            }
+        }
+        std::set<int64_t> actual(ids + lims[i], ids + lims[i + 1]);
+        ASSERT_EQ(actual, expected);
+        for (auto j = lims[i]; j < lims[i + 1]; ++j) {
+            ASSERT_LT(distances[j], rds);
+        }
+    }
+
+    free(ids);
+    free(distances);
+    free(lims);
+}
+
 #ifdef MILVUS_GPU_VERSION
 TEST_P(IDMAPTest, idmap_copy) {
     ASSERT_TRUE(!xb.empty());
@@ -11,8 +11,11 @@
 
 #include <gtest/gtest.h>
 
+#include <faiss/IndexIVF.h>
 #include <fiu-control.h>
 #include <fiu/fiu-local.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <thread>
 
@@ -217,6 +220,149 @@ TEST_P(IVFTest, ivf_serialize) {
     }
 }
 
+TEST_P(IVFTest, ivf_packed_lists) {
+    fiu_init(0);
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+    auto binaryset = index_->Serialize(conf_);
+
+    // a loaded index reads its lists into the packed read-only layout, and writes them back unchanged
+    for (int i = 0; i < 2; ++i) {
+        index_->Load(binaryset);
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+        auto rol = dynamic_cast<faiss::ReadOnlyArrayInvertedLists*>(ivf_index->invlists);
+        ASSERT_NE(rol, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(rol->get_all_codes()) % 64, 0);
+        // the row offsets fit in 32 bits
+        EXPECT_TRUE(rol->compact);
+        EXPECT_EQ(rol->get_all_ids(), nullptr);
+        EXPECT_EQ(index_->Count(), nb);
+
+        auto packed_result = index_->Query(query_dataset, conf_, nullptr);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto packed_ids = packed_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        for (int64_t j = 0; j < nq * k; ++j) {
+            EXPECT_EQ(ids[j], packed_ids[j]);
+        }
+        ReleaseQueryResult(packed_result);
+        binaryset = index_->Serialize(conf_);
+    }
+    ReleaseQueryResult(result);
+}
+
+TEST_P(IVFTest, ivf_mmap) {
+    fiu_init(0);
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto binaryset = index_->Serialize(conf_);
+    index_->Load(binaryset);
+
+    auto mmap_index = IndexFactory(index_type_, index_mode_);
+    mmap_index->SetIndexMode(milvus::knowhere::IndexMode::MODE_MMAP);
+    mmap_index->Load(binaryset);
+    EXPECT_EQ(mmap_index->Count(), nb);
+    EXPECT_EQ(mmap_index->Dim(), dim);
+    ASSERT_ANY_THROW(mmap_index->Serialize(conf_));
+
+    // the mapped lists hold the same codes, so the results are identical
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+    auto mmap_result = mmap_index->Query(query_dataset, conf_, nullptr);
+    AssertAnns(mmap_result, nq, conf_[milvus::knowhere::meta::TOPK]);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto mmap_ids = mmap_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(ids[i], mmap_ids[i]);
+    }
+    ReleaseQueryResult(result);
+    ReleaseQueryResult(mmap_result);
+}
+
+TEST_P(IVFTest, ivf_list_major) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+
+    // IVF_SQ8 decodes the lists and computes the distances with sgemm, so they agree up to rounding
+    for (auto& filter : {faiss::ConcurrentBitsetPtr(nullptr), bitset}) {
+        ivf_index->list_major_ratio = 0;
+        auto result = index_->Query(query_dataset, conf_, filter);
+        ivf_index->list_major_ratio = 0.01;
+        auto list_major_result = index_->Query(query_dataset, conf_, filter);
+
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto dis = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto list_major_ids = list_major_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto list_major_dis = list_major_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            EXPECT_EQ(ids[i], list_major_ids[i]);
+            EXPECT_NEAR(dis[i], list_major_dis[i], 1e-3 * std::max(1.0f, std::abs(dis[i])));
+        }
+        ReleaseQueryResult(result);
+        ReleaseQueryResult(list_major_result);
+    }
+}
+
+TEST_P(IVFTest, ivf_adaptive) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+    ASSERT_TRUE(ivf_index->has_list_radii());
+
+    conf_[milvus::knowhere::IndexParams::nprobe] = 32;
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+
+    // the bound only skips the lists that cannot improve the top k
+    auto bound_conf = conf_;
+    bound_conf[milvus::knowhere::IndexParams::adaptive_bound] = true;
+    auto bound_result = index_->Query(query_dataset, bound_conf, nullptr);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dis = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto bound_ids = bound_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto bound_dis = bound_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(ids[i], bound_ids[i]);
+        EXPECT_FLOAT_EQ(dis[i], bound_dis[i]);
+    }
+
+    // the queries are base vectors, found in the first list
+    auto patience_conf = bound_conf;
+    patience_conf[milvus::knowhere::IndexParams::adaptive_patience] = 1;
+    auto patience_result = index_->Query(query_dataset, patience_conf, nullptr);
+    AssertAnns(patience_result, nq, k);
+
+    // stale radii are not used
+    ivf_index->add(1, xb.data());
+    ASSERT_FALSE(ivf_index->has_list_radii());
+    ivf_index->compute_list_radii();
+    ASSERT_TRUE(ivf_index->has_list_radii());
+
+    ReleaseQueryResult(result);
+    ReleaseQueryResult(bound_result);
+    ReleaseQueryResult(patience_result);
+}
+
 TEST_P(IVFTest, ivf_slice) {
     fiu_init(0);
     {
@@ -11,8 +11,11 @@
 
 #include <gtest/gtest.h>
 
+#include <faiss/IndexIVF.h>
 #include <fiu-control.h>
 #include <fiu/fiu-local.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <thread>
 
@@ -164,4 +167,129 @@ TEST_P(IVFNMCPUTest, ivf_slice) {
     auto result = index_->Query(query_dataset, conf_, nullptr);
     AssertAnns(result, nq, k);
     ReleaseQueryResult(result);
+
+    // the packed lists of the loaded index serialize back to the same index
+    bs = index_->Serialize(conf_);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+    result = index_->Query(query_dataset, conf_, nullptr);
+    AssertAnns(result, nq, k);
+    ReleaseQueryResult(result);
+}
+
+TEST_P(IVFNMCPUTest, ivf_adaptive) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+
+    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
+    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
+    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
+    bptr->size = dim * rows * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+
+    // the radii come from the arranged data
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+    ASSERT_TRUE(ivf_index->has_list_radii());
+
+    conf_[milvus::knowhere::IndexParams::nprobe] = 32;
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+    auto bound_conf = conf_;
+    bound_conf[milvus::knowhere::IndexParams::adaptive_bound] = true;
+    auto bound_result = index_->Query(query_dataset, bound_conf, nullptr);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto bound_ids = bound_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(ids[i], bound_ids[i]);
+    }
+    ReleaseQueryResult(result);
+    ReleaseQueryResult(bound_result);
+}
+
+TEST_P(IVFNMCPUTest, ivf_mmap) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+
+    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
+    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
+    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
+    bptr->size = dim * rows * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+
+    auto mmap_index = IndexFactoryNM(index_type_, index_mode_);
+    mmap_index->SetIndexMode(milvus::knowhere::IndexMode::MODE_MMAP);
+    mmap_index->Load(bs);
+    ASSERT_ANY_THROW(mmap_index->Serialize(conf_));
+
+    // the arranged data is mapped along with the ids, so the results are identical
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+    auto mmap_result = mmap_index->Query(query_dataset, conf_, nullptr);
+    AssertAnns(mmap_result, nq, k);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto mmap_ids = mmap_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(ids[i], mmap_ids[i]);
+    }
+    ReleaseQueryResult(result);
+    ReleaseQueryResult(mmap_result);
+}
+
+TEST_P(IVFNMCPUTest, ivf_list_major) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    milvus::knowhere::BinarySet bs = index_->Serialize(conf_);
+
+    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
+    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
+    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
+    bptr->size = dim * rows * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_->index_.get());
+
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+
+    // the list-major search computes the distances of the arranged vectors with sgemm, so they only agree
+    // up to rounding
+    for (auto& filter : {faiss::ConcurrentBitsetPtr(nullptr), bitset}) {
+        ivf_index->list_major_ratio = 0;
+        auto result = index_->Query(query_dataset, conf_, filter);
+        ivf_index->list_major_ratio = 0.01;
+        auto list_major_result = index_->Query(query_dataset, conf_, filter);
+
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto dis = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto list_major_ids = list_major_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto list_major_dis = list_major_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            EXPECT_EQ(ids[i], list_major_ids[i]);
+            EXPECT_NEAR(dis[i], list_major_dis[i], 1e-3 * std::max(1.0f, std::abs(dis[i])));
+        }
+        ReleaseQueryResult(result);
+        ReleaseQueryResult(list_major_result);
+    }
 }
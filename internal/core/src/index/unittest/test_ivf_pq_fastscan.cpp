@@ -0,0 +1,183 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <faiss/BlockInvertedLists.h>
+#include <faiss/FaissHook.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexIVFPQFastScan.h>
+#include <faiss/impl/PQ4FastScan.h>
+#include <faiss/impl/PQ4FastScan_avx.h>
+#include <faiss/impl/PQ4FastScan_avx512.h>
+#include <faiss/utils/ConcurrentBitset.h>
+#include <random>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/IndexType.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+
+#include "unittest/Helper.h"
+#include "unittest/utils.h"
+
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+class IVFPQFastScanTest : public DataGen, public TestWithParam<std::string> {
+ protected:
+    void
+    SetUp() override {
+        Generate(dim, nb, nq);
+        index_ = IndexFactory(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN,
+                              milvus::knowhere::IndexMode::MODE_CPU);
+        conf_ = ParamGenerator::GetInstance().Gen(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN);
+        conf_[milvus::knowhere::Metric::TYPE] = GetParam();
+    }
+
+ protected:
+    milvus::knowhere::Config conf_;
+    milvus::knowhere::IVFPtr index_ = nullptr;
+};
+
+INSTANTIATE_TEST_CASE_P(IVFPQFastScanParameters,
+                        IVFPQFastScanTest,
+                        Values(milvus::knowhere::Metric::L2, milvus::knowhere::Metric::IP));
+
+TEST_P(IVFPQFastScanTest, ivfpq_fastscan_basic) {
+    // null faiss index
+    ASSERT_ANY_THROW(index_->AddWithoutIds(base_dataset, conf_));
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+    index_->UpdateIndexSize();
+    EXPECT_GT(index_->IndexSize(), nb * (dim / 32 + sizeof(int64_t)));
+
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+    if (GetParam() == milvus::knowhere::Metric::L2) {
+        AssertAnns(result, nq, k);
+    }
+    ReleaseQueryResult(result);
+
+    // filtered out ids are never returned
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+    result = index_->Query(query_dataset, conf_, bitset);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_GE(ids[i], nq);
+    }
+    ReleaseQueryResult(result);
+}
+
+// the quantized tables only filter the candidates, so the distances match a plain IVFPQ with the same
+// quantizers and 4-bit codes
+TEST_P(IVFPQFastScanTest, ivfpq_fastscan_same_as_ivfpq) {
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto fast_scan = dynamic_cast<faiss::IndexIVFPQFastScan*>(index_->index_.get());
+    ASSERT_NE(fast_scan, nullptr);
+    ASSERT_NE(dynamic_cast<faiss::BlockInvertedLists*>(fast_scan->invlists), nullptr);
+
+    auto quantizer = dynamic_cast<faiss::IndexFlat*>(fast_scan->quantizer);
+    faiss::IndexFlat ref_quantizer(dim, fast_scan->metric_type);
+    ref_quantizer.add(quantizer->ntotal, quantizer->xb.data());
+    faiss::IndexIVFPQ ref(&ref_quantizer, dim, fast_scan->nlist, fast_scan->pq.M, 4, fast_scan->metric_type);
+    ref.pq = fast_scan->pq;
+    ref.is_trained = true;
+    ref.precompute_table();
+    ref.add(nb, xb.data());
+
+    auto nprobe = conf_[milvus::knowhere::IndexParams::nprobe].get<int64_t>();
+    fast_scan->nprobe = ref.nprobe = nprobe;
+    std::vector<float> distances(nq * k), ref_distances(nq * k);
+    std::vector<int64_t> labels(nq * k), ref_labels(nq * k);
+    fast_scan->search(nq, xq.data(), k, distances.data(), labels.data());
+    ref.search(nq, xq.data(), k, ref_distances.data(), ref_labels.data());
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_NEAR(distances[i], ref_distances[i], 1e-3 * std::max(1.0f, std::abs(ref_distances[i])));
+    }
+
+    // the codes read back as the ProductQuantizer packed them
+    std::vector<float> recons(dim), ref_recons(dim);
+    fast_scan->make_direct_map();
+    fast_scan->reconstruct(labels[0], recons.data());
+    ref.make_direct_map();
+    ref.reconstruct(labels[0], ref_recons.data());
+    EXPECT_EQ(recons, ref_recons);
+}
+
+TEST_P(IVFPQFastScanTest, ivfpq_fastscan_serialize) {
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto result = index_->Query(query_dataset, conf_, nullptr);
+
+    auto binaryset = index_->Serialize(conf_);
+    auto new_index = std::make_shared<milvus::knowhere::IVFPQFastScan>();
+    new_index->Load(binaryset);
+    EXPECT_EQ(new_index->Count(), nb);
+    EXPECT_EQ(new_index->Dim(), dim);
+    ASSERT_NE(dynamic_cast<faiss::BlockInvertedLists*>(
+                  dynamic_cast<faiss::IndexIVF*>(new_index->index_.get())->invlists),
+              nullptr);
+
+    auto new_result = new_index->Query(query_dataset, conf_, nullptr);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto new_ids = new_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], new_ids[i]);
+    }
+    ReleaseQueryResult(result);
+    ReleaseQueryResult(new_result);
+}
+
+TEST(IVFPQFastScanKernelTest, accumulate) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (size_t M2 : {2, 4, 6, 16, 34}) {
+        const size_t nblocks = 3;
+        std::vector<uint8_t> blocks(nblocks * M2 * 16), lut(M2 * 16);
+        for (auto& b : blocks) {
+            b = byte(rng);
+        }
+        for (auto& l : lut) {
+            l = byte(rng);
+        }
+        std::vector<uint16_t> expected(nblocks * faiss::PQ4_BLOCK_SIZE, 0);
+        for (size_t b = 0; b < nblocks; b++) {
+            for (size_t i = 0; i < faiss::PQ4_BLOCK_SIZE; i++) {
+                for (size_t m = 0; m < M2; m++) {
+                    auto code = faiss::pq4_get_code(blocks.data() + b * M2 * 16, m, i);
+                    expected[b * faiss::PQ4_BLOCK_SIZE + i] += lut[m * 16 + code];
+                }
+            }
+        }
+
+        std::vector<faiss::pq4_accumulate_func_ptr> kernels{faiss::pq4_accumulate_sse};
+        if (faiss::support_avx2()) {
+            kernels.push_back(faiss::pq4_accumulate_avx);
+        }
+        if (faiss::support_avx512()) {
+            kernels.push_back(faiss::pq4_accumulate_avx512);
+        }
+        for (auto kernel : kernels) {
+            std::vector<uint16_t> out(nblocks * faiss::PQ4_BLOCK_SIZE);
+            kernel(nblocks, M2, blocks.data(), lut.data(), out.data());
+            ASSERT_EQ(out, expected);
+        }
+    }
+}
@@ -38,6 +38,11 @@ TEST_F(KnowhereTest, KNOWHERE_RESOURCE_TEST) {
 
     KnowhereConfig::SetClusteringType(KnowhereConfig::ClusteringType::K_MEANS);
     KnowhereConfig::SetClusteringType(KnowhereConfig::ClusteringType::K_MEANS_PLUS_PLUS);
+    KnowhereConfig::SetClusteringType(KnowhereConfig::ClusteringType::K_MEANS_PARALLEL);
+    KnowhereConfig::SetClusteringType(KnowhereConfig::ClusteringType::K_MEANS);
+
+    KnowhereConfig::SetClusteringMiniBatchSize(4096);
+    KnowhereConfig::SetClusteringMiniBatchSize(0);
 
     KnowhereConfig::SetStatisticsLevel(0);
 
@@ -25,6 +25,7 @@
 #include <google/protobuf/text_format.h>
 #include "query/PlanProto.h"
 #include "query/generated/ShowPlanNodeVisitor.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus::query {
 
@@ -200,9 +201,21 @@ Parser::ParseVecNode(const Json& out_body) {
 
     auto& vec_info = iter.value();
     Assert(vec_info.is_object());
-    auto topK = vec_info["topk"];
-    AssertInfo(topK > 0, "topK must greater than 0");
-    AssertInfo(topK < 16384, "topK is too large");
+    auto& search_params = vec_info.at("params");
+    std::optional<float> radius;
+    if (search_params.contains(knowhere::IndexParams::range_search_radius)) {
+        radius = search_params[knowhere::IndexParams::range_search_radius].get<float>();
+    }
+    int64_t topK = 0;
+    if (radius.has_value()) {
+        // topk is an optional cap of a range search
+        topK = vec_info.value("topk", int64_t(0));
+        AssertInfo(topK >= 0, "topK must not be negative");
+    } else {
+        topK = vec_info["topk"];
+        AssertInfo(topK > 0, "topK must greater than 0");
+        AssertInfo(topK < 16384, "topK is too large");
+    }
 
     auto field_offset = schema.get_offset(field_name);
 
@@ -211,13 +224,16 @@ Parser::ParseVecNode(const Json& out_body) {
         auto data_type = field_meta.get_data_type();
         if (data_type == DataType::VECTOR_FLOAT) {
             return std::make_unique<FloatVectorANNS>();
+        } else if (data_type == DataType::VECTOR_INT8) {
+            return std::make_unique<Int8VectorANNS>();
         } else {
             return std::make_unique<BinaryVectorANNS>();
         }
     }();
     vec_node->query_info_.topK_ = topK;
     vec_node->query_info_.metric_type_ = GetMetricType(vec_info.at("metric_type"));
-    vec_node->query_info_.search_params_ = vec_info.at("params");
+    vec_node->query_info_.search_params_ = search_params;
+    vec_node->query_info_.radius_ = radius;
     vec_node->query_info_.field_offset_ = field_offset;
     vec_node->placeholder_tag_ = vec_info.at("query");
     auto tag = vec_node->placeholder_tag_;
@@ -36,6 +36,13 @@ struct QueryInfo {
     MetricType metric_type_;
     std::string deprecated_metric_type_;  // TODO: use enum
     nlohmann::json search_params_;
+    // set for range search: hits within radius_ in the unit of the reported distances,
+    // and topK_ caps the hits per query (0 for no cap)
+    std::optional<float> radius_;
+
+    // decided per segment by ExecPlanNodeVisitor
+    SearchStrategy search_strategy_ = SearchStrategy::INDEX;
+    double pass_ratio_ = 1.0;
 };
 
 struct VectorPlanNode : PlanNode {
@@ -56,4 +63,10 @@ struct BinaryVectorANNS : VectorPlanNode {
     accept(PlanNodeVisitor&) override;
 };
 
+struct Int8VectorANNS : VectorPlanNode {
+ public:
+    void
+    accept(PlanNodeVisitor&) override;
+};
+
 }  // namespace milvus::query
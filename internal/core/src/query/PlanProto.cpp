@@ -17,6 +17,7 @@
 #include <query/generated/ExtractInfoPlanNodeVisitor.h>
 #include "query/generated/ExtractInfoExprVisitor.h"
 #include "common/Types.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus::query {
 namespace planpb = milvus::proto::plan;
@@ -99,10 +100,18 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
     query_info.metric_type_ = GetMetricType(query_info_proto.metric_type());
     query_info.topK_ = query_info_proto.topk();
     query_info.search_params_ = json::parse(query_info_proto.search_params());
+    if (query_info.search_params_.contains(knowhere::IndexParams::range_search_radius)) {
+        // range search, topk turns into an optional cap
+        query_info.radius_ = query_info.search_params_[knowhere::IndexParams::range_search_radius].get<float>();
+        AssertInfo(query_info.topK_ >= 0, "topK must not be negative");
+    }
 
     auto plan_node = [&]() -> std::unique_ptr<VectorPlanNode> {
         if (anns_proto.is_binary()) {
             return std::make_unique<BinaryVectorANNS>();
+        } else if (schema[field_offset].get_data_type() == DataType::VECTOR_INT8) {
+            // the proto has no int8 flag, the field type tells
+            return std::make_unique<Int8VectorANNS>();
         } else {
             return std::make_unique<FloatVectorANNS>();
         }
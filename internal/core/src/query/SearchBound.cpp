@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/SearchBound.h"
+#include <algorithm>
+#include <cmath>
+#include <faiss/FaissHook.h>
+#include <faiss/utils/distances.h>
+#include "exceptions/EasyAssert.h"
+#include "query/SubQueryResult.h"
+
+namespace milvus::query {
+
+SearchBound::SearchBound(int64_t num_queries, int64_t topk, MetricType metric_type)
+    : num_queries_(num_queries),
+      topk_(topk),
+      metric_type_(metric_type),
+      bounds_(std::make_unique<std::atomic<float>[]>(num_queries)) {
+    for (int64_t i = 0; i < num_queries; ++i) {
+        bounds_[i].store(SubQueryResult::init_value(metric_type), std::memory_order_relaxed);
+    }
+}
+
+bool
+SearchBound::is_worse(float a, float b) const {
+    return SubQueryResult::is_descending(metric_type_) ? a < b : a > b;
+}
+
+void
+SearchBound::update(const QueryResult& result) {
+    if (!result.result_lims_.empty() || topk_ <= 0) {
+        return;
+    }
+    AssertInfo(result.num_queries_ == num_queries_ && result.topK_ == topk_, "search bound mismatch");
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        auto kth = qn * topk_ + topk_ - 1;
+        if (result.internal_seg_offsets_[kth] == -1) {
+            continue;
+        }
+        auto distance = result.result_distances_[kth];
+        auto current = bounds_[qn].load(std::memory_order_relaxed);
+        while (is_worse(current, distance) &&
+               !bounds_[qn].compare_exchange_weak(current, distance, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+void
+SearchBound::prune(QueryResult& result) const {
+    if (!result.result_lims_.empty()) {
+        return;
+    }
+    AssertInfo(result.num_queries_ == num_queries_ && result.topK_ == topk_, "search bound mismatch");
+    auto init_value = SubQueryResult::init_value(metric_type_);
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        auto bound = get(qn);
+        // hits are sorted best first, so the pruned ones form the tail and the order is kept
+        for (auto i = qn * topk_; i < (qn + 1) * topk_; ++i) {
+            if (result.internal_seg_offsets_[i] != -1 && is_worse(result.result_distances_[i], bound)) {
+                result.internal_seg_offsets_[i] = -1;
+                result.result_distances_[i] = init_value;
+            }
+        }
+    }
+}
+
+float
+VectorBoundingBall::best_distance(const float* query, MetricType metric_type) const {
+    auto dim = centroid_.size();
+    if (metric_type == MetricType::METRIC_L2) {
+        auto center_distance = std::sqrt(faiss::fvec_L2sqr(query, centroid_.data(), dim));
+        auto gap = std::max(0.0f, center_distance - radius_);
+        return gap * gap;
+    }
+    Assert(metric_type == MetricType::METRIC_INNER_PRODUCT);
+    auto query_norm = std::sqrt(faiss::fvec_norm_L2sqr(query, dim));
+    return faiss::fvec_inner_product(query, centroid_.data(), dim) + query_norm * radius_;
+}
+
+VectorBoundingBall
+ComputeBoundingBall(const float* vectors, int64_t dim, int64_t count) {
+    VectorBoundingBall ball;
+    ball.centroid_.resize(dim, 0);
+    if (count == 0) {
+        return ball;
+    }
+    std::vector<double> sum(dim, 0);
+    for (int64_t i = 0; i < count; ++i) {
+        for (int64_t d = 0; d < dim; ++d) {
+            sum[d] += vectors[i * dim + d];
+        }
+    }
+    for (int64_t d = 0; d < dim; ++d) {
+        ball.centroid_[d] = sum[d] / count;
+    }
+    float max_distance = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        max_distance = std::max(max_distance, faiss::fvec_L2sqr(vectors + i * dim, ball.centroid_.data(), dim));
+    }
+    // absorb the rounding of the float centroid
+    ball.radius_ = std::sqrt(max_distance) * (1 + 1e-5f);
+    return ball;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "common/Types.h"
+
+namespace milvus::query {
+
+// topk threshold of one search request, shared by all the segments it searches.
+// the k-th distance of any segment's topk bounds the global k-th distance,
+// so segments searched later can drop candidates worse than it before reduce.
+// distances are in the unit of the search, not negated as in segment_c.
+class SearchBound {
+ public:
+    SearchBound(int64_t num_queries, int64_t topk, MetricType metric_type);
+
+    int64_t
+    get_num_queries() const {
+        return num_queries_;
+    }
+
+    int64_t
+    get_topk() const {
+        return topk_;
+    }
+
+    MetricType
+    get_metric_type() const {
+        return metric_type_;
+    }
+
+    // the best known k-th distance of a query
+    float
+    get(int64_t query) const {
+        return bounds_[query].load(std::memory_order_relaxed);
+    }
+
+    // whether distance a is strictly worse than b
+    bool
+    is_worse(float a, float b) const;
+
+    // tighten the bounds with a topk result whose queries have k hits
+    void
+    update(const QueryResult& result);
+
+    // invalidate hits worse than the bounds, the result keeps its topk layout with -1 padding
+    void
+    prune(QueryResult& result) const;
+
+ private:
+    int64_t num_queries_;
+    int64_t topk_;
+    MetricType metric_type_;
+    std::unique_ptr<std::atomic<float>[]> bounds_;
+};
+
+// smallest ball containing the vectors of a field, gives the best distance a query can reach in it
+struct VectorBoundingBall {
+    std::vector<float> centroid_;
+    float radius_ = 0;
+
+    // the best possible distance from query to the vectors in the ball
+    float
+    best_distance(const float* query, MetricType metric_type) const;
+};
+
+VectorBoundingBall
+ComputeBoundingBall(const float* vectors, int64_t dim, int64_t count);
+
+}  // namespace milvus::query
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "SearchBruteForce.h"
+#include <algorithm>
 #include <vector>
 #include <common/Types.h>
 #include <boost/dynamic_bitset.hpp>
@@ -18,6 +19,7 @@
 
 #include <faiss/utils/distances.h>
 #include <faiss/utils/BinaryDistance.h>
+#include "knowhere/index/vector_index/helpers/DynamicResultSet.h"
 
 namespace milvus::query {
 
@@ -107,6 +109,30 @@ FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
     }
 }
 
+SubQueryResult
+Int8SearchBruteForce(const dataset::QueryDataset& query_dataset,
+                     const void* chunk_data_raw,
+                     int64_t size_per_chunk,
+                     const faiss::BitsetView& bitset) {
+    auto metric_type = query_dataset.metric_type;
+    auto num_queries = query_dataset.num_queries;
+    auto topk = query_dataset.topk;
+    auto dim = query_dataset.dim;
+    SubQueryResult sub_qr(num_queries, topk, metric_type);
+    auto query_data = reinterpret_cast<const int8_t*>(query_dataset.query_data);
+    auto chunk_data = reinterpret_cast<const int8_t*>(chunk_data_raw);
+
+    if (metric_type == MetricType::METRIC_L2) {
+        faiss::float_maxheap_array_t buf{(size_t)num_queries, (size_t)topk, sub_qr.get_labels(), sub_qr.get_values()};
+        faiss::knn_L2sqr_int8(query_data, chunk_data, dim, num_queries, size_per_chunk, &buf, bitset);
+    } else {
+        AssertInfo(metric_type == MetricType::METRIC_INNER_PRODUCT, "int8 vector only supports L2 and IP");
+        faiss::float_minheap_array_t buf{(size_t)num_queries, (size_t)topk, sub_qr.get_labels(), sub_qr.get_values()};
+        faiss::knn_inner_product_int8(query_data, chunk_data, dim, num_queries, size_per_chunk, &buf, bitset);
+    }
+    return sub_qr;
+}
+
 SubQueryResult
 BinarySearchBruteForce(const dataset::QueryDataset& query_dataset,
                        const void* chunk_data_raw,
@@ -118,4 +144,156 @@ BinarySearchBruteForce(const dataset::QueryDataset& query_dataset,
     return BinarySearchBruteForceFast(query_dataset.metric_type, query_dataset.dim, chunk_data, size_per_chunk,
                                       query_dataset.topk, query_dataset.num_queries, query_data, bitset);
 }
+
+// rows gathered per block, bounds the temporary copy
+constexpr int64_t GATHER_BLOCK_SIZE = 16 * 1024;
+
+template <typename Search>
+static SubQueryResult
+SearchBruteForceOnOffsets(const dataset::QueryDataset& query_dataset,
+                          const char* chunk_data,
+                          int64_t element_sizeof,
+                          const int64_t* offsets,
+                          int64_t offset_count,
+                          Search search) {
+    SubQueryResult final_qr(query_dataset.num_queries, query_dataset.topk, query_dataset.metric_type);
+    std::vector<char> gathered(std::min(offset_count, GATHER_BLOCK_SIZE) * element_sizeof);
+    for (int64_t block_begin = 0; block_begin < offset_count; block_begin += GATHER_BLOCK_SIZE) {
+        auto block_size = std::min(offset_count - block_begin, GATHER_BLOCK_SIZE);
+        auto block_offsets = offsets + block_begin;
+        for (int64_t i = 0; i < block_size; ++i) {
+            memcpy(gathered.data() + i * element_sizeof, chunk_data + block_offsets[i] * element_sizeof,
+                   element_sizeof);
+        }
+
+        auto sub_qr = search(query_dataset, gathered.data(), block_size, BitsetView());
+
+        // convert block position to chunk offset
+        for (auto& x : sub_qr.mutable_labels()) {
+            if (x != -1) {
+                x = block_offsets[x];
+            }
+        }
+        final_qr.merge(sub_qr);
+    }
+    return final_qr;
+}
+
+SubQueryResult
+FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
+                      const void* chunk_data_raw,
+                      const int64_t* offsets,
+                      int64_t offset_count) {
+    auto element_sizeof = query_dataset.dim * sizeof(float);
+    auto search = [](const dataset::QueryDataset& dataset, const void* data, int64_t size, const BitsetView& bitset) {
+        return FloatSearchBruteForce(dataset, data, size, bitset);
+    };
+    return SearchBruteForceOnOffsets(query_dataset, reinterpret_cast<const char*>(chunk_data_raw), element_sizeof,
+                                     offsets, offset_count, search);
+}
+
+SubQueryResult
+Int8SearchBruteForce(const dataset::QueryDataset& query_dataset,
+                     const void* chunk_data_raw,
+                     const int64_t* offsets,
+                     int64_t offset_count) {
+    auto element_sizeof = query_dataset.dim * sizeof(int8_t);
+    auto search = [](const dataset::QueryDataset& dataset, const void* data, int64_t size, const BitsetView& bitset) {
+        return Int8SearchBruteForce(dataset, data, size, bitset);
+    };
+    return SearchBruteForceOnOffsets(query_dataset, reinterpret_cast<const char*>(chunk_data_raw), element_sizeof,
+                                     offsets, offset_count, search);
+}
+
+SubQueryResult
+BinarySearchBruteForce(const dataset::QueryDataset& query_dataset,
+                       const void* chunk_data_raw,
+                       const int64_t* offsets,
+                       int64_t offset_count) {
+    auto element_sizeof = query_dataset.dim / 8;
+    auto search = [](const dataset::QueryDataset& dataset, const void* data, int64_t size, const BitsetView& bitset) {
+        return BinarySearchBruteForce(dataset, data, size, bitset);
+    };
+    return SearchBruteForceOnOffsets(query_dataset, reinterpret_cast<const char*>(chunk_data_raw), element_sizeof,
+                                     offsets, offset_count, search);
+}
+
+SubQueryResult
+FloatSearchRefine(const dataset::QueryDataset& query_dataset,
+                  const void* chunk_data_raw,
+                  const int64_t* candidate_offsets,
+                  int64_t num_candidates) {
+    auto metric_type = query_dataset.metric_type;
+    auto num_queries = query_dataset.num_queries;
+    auto topk = query_dataset.topk;
+    auto dim = query_dataset.dim;
+    auto query_data = reinterpret_cast<const float*>(query_dataset.query_data);
+    auto chunk_data = reinterpret_cast<const float*>(chunk_data_raw);
+
+    std::vector<float> distances(num_queries * num_candidates);
+    if (metric_type == MetricType::METRIC_L2) {
+        faiss::fvec_L2sqr_by_idx(distances.data(), query_data, chunk_data, candidate_offsets, dim, num_queries,
+                                 num_candidates);
+    } else {
+        faiss::fvec_inner_products_by_idx(distances.data(), query_data, chunk_data, candidate_offsets, dim,
+                                          num_queries, num_candidates);
+    }
+
+    SubQueryResult sub_qr(num_queries, topk, metric_type);
+    auto is_desc = SubQueryResult::is_descending(metric_type);
+    std::vector<int64_t> order;
+    for (int64_t qn = 0; qn < num_queries; ++qn) {
+        auto offsets = candidate_offsets + qn * num_candidates;
+        auto dis = distances.data() + qn * num_candidates;
+        order.clear();
+        for (int64_t i = 0; i < num_candidates; ++i) {
+            if (offsets[i] != -1) {
+                order.push_back(i);
+            }
+        }
+        auto keep = std::min<int64_t>(order.size(), topk);
+        auto cmp = [&](int64_t a, int64_t b) { return is_desc ? dis[a] > dis[b] : dis[a] < dis[b]; };
+        std::partial_sort(order.begin(), order.begin() + keep, order.end(), cmp);
+        for (int64_t i = 0; i < keep; ++i) {
+            sub_qr.get_labels()[qn * topk + i] = offsets[order[i]];
+            sub_qr.get_values()[qn * topk + i] = dis[order[i]];
+        }
+    }
+    return sub_qr;
+}
+
+// entries per result buffer of the faiss range search
+constexpr size_t RANGE_SEARCH_BUFFER_SIZE = 16 * 1024;
+
+RangeSubQueryResult
+FloatRangeSearchBruteForce(const dataset::QueryDataset& query_dataset,
+                           float radius,
+                           const void* chunk_data_raw,
+                           int64_t size_per_chunk,
+                           const faiss::BitsetView& bitset) {
+    auto metric_type = query_dataset.metric_type;
+    auto num_queries = query_dataset.num_queries;
+    auto dim = query_dataset.dim;
+    auto query_data = reinterpret_cast<const float*>(query_dataset.query_data);
+    auto chunk_data = reinterpret_cast<const float*>(chunk_data_raw);
+
+    std::vector<faiss::RangeSearchPartialResult*> partial_results;
+    if (metric_type == MetricType::METRIC_L2) {
+        faiss::range_search_L2sqr(query_data, chunk_data, dim, num_queries, size_per_chunk, radius, partial_results,
+                                  RANGE_SEARCH_BUFFER_SIZE, bitset);
+    } else {
+        faiss::range_search_inner_product(query_data, chunk_data, dim, num_queries, size_per_chunk, radius,
+                                          partial_results, RANGE_SEARCH_BUFFER_SIZE, bitset);
+    }
+    faiss::RangeSearchResult result(num_queries);
+    knowhere::MergeRangeSearchPartialResults(partial_results, result);
+
+    RangeSubQueryResult sub_qr(num_queries, metric_type);
+    auto total = result.lims[num_queries];
+    std::copy_n(result.lims, num_queries + 1, sub_qr.mutable_lims().data());
+    sub_qr.mutable_labels().assign(result.labels, result.labels + total);
+    sub_qr.mutable_values().assign(result.distances, result.distances + total);
+    return sub_qr;
+}
+
 }  // namespace milvus::query
@@ -30,4 +30,47 @@ FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
                       int64_t size_per_chunk,
                       const faiss::BitsetView& bitset);
 
+// int8 vectors, distances are computed exactly in int32 and returned as float
+SubQueryResult
+Int8SearchBruteForce(const dataset::QueryDataset& query_dataset,
+                     const void* chunk_data_raw,
+                     int64_t size_per_chunk,
+                     const faiss::BitsetView& bitset);
+
+// exact search over the rows at chunk offsets only: they are gathered into contiguous blocks
+// and searched without a bitset, labels are mapped back to chunk offsets
+SubQueryResult
+BinarySearchBruteForce(const dataset::QueryDataset& query_dataset,
+                       const void* chunk_data_raw,
+                       const int64_t* offsets,
+                       int64_t offset_count);
+
+SubQueryResult
+FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
+                      const void* chunk_data_raw,
+                      const int64_t* offsets,
+                      int64_t offset_count);
+
+SubQueryResult
+Int8SearchBruteForce(const dataset::QueryDataset& query_dataset,
+                     const void* chunk_data_raw,
+                     const int64_t* offsets,
+                     int64_t offset_count);
+
+// exact re-ranking of approximate candidates: distances to the rows at the candidate chunk offsets
+// (num_candidates per query, -1 for none) are recomputed on raw vectors, and the best topk are kept
+SubQueryResult
+FloatSearchRefine(const dataset::QueryDataset& query_dataset,
+                  const void* chunk_data_raw,
+                  const int64_t* candidate_offsets,
+                  int64_t num_candidates);
+
+// all rows within radius of the queries: L2 distance < radius, or inner product > radius
+RangeSubQueryResult
+FloatRangeSearchBruteForce(const dataset::QueryDataset& query_dataset,
+                           float radius,
+                           const void* chunk_data_raw,
+                           int64_t size_per_chunk,
+                           const faiss::BitsetView& bitset);
+
 }  // namespace milvus::query
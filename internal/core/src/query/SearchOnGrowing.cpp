@@ -18,6 +18,8 @@
 #include "utils/tools.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnIndex.h"
+#include "query/SearchStrategy.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus::query {
 Status
@@ -59,11 +61,16 @@ FloatSearch(const segcore::SegmentGrowingImpl& segment,
     auto vec_ptr = record.get_field_data<FloatVector>(vecfield_offset);
 
     int current_chunk_id = 0;
+    auto brute_force_on_passed = info.search_strategy_ == SearchStrategy::BRUTE_FORCE_ON_PASSED;
 
-    if (indexing_record.is_in(vecfield_offset)) {
+    if (indexing_record.is_in(vecfield_offset) && !brute_force_on_passed) {
         auto max_indexed_id = indexing_record.get_finished_ack();
         const auto& field_indexing = indexing_record.get_vec_field_indexing(vecfield_offset);
         auto search_conf = field_indexing.get_search_params(topK);
+        if (info.search_strategy_ == SearchStrategy::WIDENED_INDEX) {
+            auto nlist = field_indexing.get_build_params()[knowhere::IndexParams::nlist].get<int64_t>();
+            search_conf = WidenSearchParams(search_conf, info.pass_ratio_, nlist);
+        }
         Assert(vec_ptr->get_size_per_chunk() == field_indexing.get_size_per_chunk());
 
         for (int chunk_id = current_chunk_id; chunk_id < max_indexed_id; ++chunk_id) {
@@ -97,7 +104,13 @@ FloatSearch(const segcore::SegmentGrowingImpl& segment,
         auto size_per_chunk = element_end - element_begin;
 
         auto sub_view = BitsetSubView(bitset, element_begin, size_per_chunk);
-        auto sub_qr = FloatSearchBruteForce(query_dataset, chunk.data(), size_per_chunk, sub_view);
+        auto sub_qr = [&] {
+            if (brute_force_on_passed) {
+                auto offsets = GetPassedOffsets(sub_view, size_per_chunk);
+                return FloatSearchBruteForce(query_dataset, chunk.data(), offsets.data(), offsets.size());
+            }
+            return FloatSearchBruteForce(query_dataset, chunk.data(), size_per_chunk, sub_view);
+        }();
 
         // convert chunk uid to segment uid
         for (auto& x : sub_qr.mutable_labels()) {
@@ -117,6 +130,58 @@ FloatSearch(const segcore::SegmentGrowingImpl& segment,
     return Status::OK();
 }
 
+// range search scans every chunk by brute force, the small chunk indexes are topk only
+Status
+FloatRangeSearch(const segcore::SegmentGrowingImpl& segment,
+                 const query::QueryInfo& info,
+                 const float* query_data,
+                 int64_t num_queries,
+                 int64_t ins_barrier,
+                 const BitsetView& bitset,
+                 QueryResult& results) {
+    auto& schema = segment.get_schema();
+    auto& record = segment.get_insert_record();
+    auto vecfield_offset = info.field_offset_;
+    auto& field = schema[vecfield_offset];
+
+    Assert(field.get_data_type() == DataType::VECTOR_FLOAT);
+    auto dim = field.get_dim();
+    auto metric_type = info.metric_type_;
+    auto radius = info.radius_.value();
+
+    RangeSubQueryResult final_qr(num_queries, metric_type);
+    dataset::QueryDataset query_dataset{metric_type, num_queries, info.topK_, dim, query_data};
+    auto vec_ptr = record.get_field_data<FloatVector>(vecfield_offset);
+    auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
+    auto max_chunk = upper_div(ins_barrier, vec_size_per_chunk);
+
+    for (int chunk_id = 0; chunk_id < max_chunk; ++chunk_id) {
+        auto& chunk = vec_ptr->get_chunk(chunk_id);
+
+        auto element_begin = chunk_id * vec_size_per_chunk;
+        auto element_end = std::min(ins_barrier, (chunk_id + 1) * vec_size_per_chunk);
+        auto size_per_chunk = element_end - element_begin;
+
+        auto sub_view = BitsetSubView(bitset, element_begin, size_per_chunk);
+        auto sub_qr = FloatRangeSearchBruteForce(query_dataset, radius, chunk.data(), size_per_chunk, sub_view);
+
+        // convert chunk uid to segment uid
+        for (auto& x : sub_qr.mutable_labels()) {
+            x += element_begin;
+        }
+        final_qr.merge(sub_qr);
+    }
+    final_qr.sort_and_limit(info.topK_);
+
+    results.result_distances_ = std::move(final_qr.mutable_values());
+    results.internal_seg_offsets_ = std::move(final_qr.mutable_labels());
+    results.result_lims_ = std::move(final_qr.mutable_lims());
+    results.topK_ = info.topK_;
+    results.num_queries_ = num_queries;
+
+    return Status::OK();
+}
+
 Status
 BinarySearch(const segcore::SegmentGrowingImpl& segment,
              const query::QueryInfo& info,
@@ -167,7 +232,71 @@ BinarySearch(const segcore::SegmentGrowingImpl& segment,
         auto nsize = element_end - element_begin;
 
         auto sub_view = BitsetSubView(bitset, element_begin, nsize);
-        auto sub_result = BinarySearchBruteForce(query_dataset, chunk.data(), nsize, sub_view);
+        auto sub_result = [&] {
+            if (info.search_strategy_ == SearchStrategy::BRUTE_FORCE_ON_PASSED) {
+                auto offsets = GetPassedOffsets(sub_view, nsize);
+                return BinarySearchBruteForce(query_dataset, chunk.data(), offsets.data(), offsets.size());
+            }
+            return BinarySearchBruteForce(query_dataset, chunk.data(), nsize, sub_view);
+        }();
+
+        // convert chunk uid to segment uid
+        for (auto& x : sub_result.mutable_labels()) {
+            if (x != -1) {
+                x += chunk_id * vec_size_per_chunk;
+            }
+        }
+        final_result.merge(sub_result);
+    }
+
+    results.result_distances_ = std::move(final_result.mutable_values());
+    results.internal_seg_offsets_ = std::move(final_result.mutable_labels());
+    results.topK_ = topK;
+    results.num_queries_ = num_queries;
+
+    return Status::OK();
+}
+
+Status
+Int8Search(const segcore::SegmentGrowingImpl& segment,
+           const query::QueryInfo& info,
+           const int8_t* query_data,
+           int64_t num_queries,
+           int64_t ins_barrier,
+           const faiss::BitsetView& bitset,
+           QueryResult& results) {
+    auto& schema = segment.get_schema();
+    auto& record = segment.get_insert_record();
+    auto metric_type = info.metric_type_;
+    auto vecfield_offset = info.field_offset_;
+    auto& field = schema[vecfield_offset];
+
+    Assert(field.get_data_type() == DataType::VECTOR_INT8);
+    auto dim = field.get_dim();
+    auto topK = info.topK_;
+
+    query::dataset::QueryDataset query_dataset{metric_type, num_queries, topK, dim, query_data};
+
+    auto vec_ptr = record.get_field_data<Int8Vector>(vecfield_offset);
+
+    // int8 fields have no small index, every chunk is searched by brute force
+    auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
+    auto max_chunk = upper_div(ins_barrier, vec_size_per_chunk);
+    SubQueryResult final_result(num_queries, topK, metric_type);
+    for (int chunk_id = 0; chunk_id < max_chunk; ++chunk_id) {
+        auto& chunk = vec_ptr->get_chunk(chunk_id);
+        auto element_begin = chunk_id * vec_size_per_chunk;
+        auto element_end = std::min(ins_barrier, (chunk_id + 1) * vec_size_per_chunk);
+        auto nsize = element_end - element_begin;
+
+        auto sub_view = BitsetSubView(bitset, element_begin, nsize);
+        auto sub_result = [&] {
+            if (info.search_strategy_ == SearchStrategy::BRUTE_FORCE_ON_PASSED) {
+                auto offsets = GetPassedOffsets(sub_view, nsize);
+                return Int8SearchBruteForce(query_dataset, chunk.data(), offsets.data(), offsets.size());
+            }
+            return Int8SearchBruteForce(query_dataset, chunk.data(), nsize, sub_view);
+        }();
 
         // convert chunk uid to segment uid
         for (auto& x : sub_result.mutable_labels()) {
@@ -198,9 +327,16 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
     // TODO: add data_type to info
     auto data_type = segment.get_schema()[info.field_offset_].get_data_type();
     Assert(datatype_is_vector(data_type));
-    if (data_type == DataType::VECTOR_FLOAT) {
+    if (info.radius_.has_value()) {
+        AssertInfo(data_type == DataType::VECTOR_FLOAT, "range search only supports float vector");
+        auto typed_data = reinterpret_cast<const float*>(query_data);
+        FloatRangeSearch(segment, info, typed_data, num_queries, ins_barrier, bitset, results);
+    } else if (data_type == DataType::VECTOR_FLOAT) {
         auto typed_data = reinterpret_cast<const float*>(query_data);
         FloatSearch(segment, info, typed_data, num_queries, ins_barrier, bitset, results);
+    } else if (data_type == DataType::VECTOR_INT8) {
+        auto typed_data = reinterpret_cast<const int8_t*>(query_data);
+        Int8Search(segment, info, typed_data, num_queries, ins_barrier, bitset, results);
     } else {
         auto typed_data = reinterpret_cast<const uint8_t*>(query_data);
         BinarySearch(segment, info, typed_data, num_queries, ins_barrier, bitset, results);
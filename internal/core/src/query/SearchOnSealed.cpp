@@ -67,6 +67,39 @@ ReleaseQueryResult(const knowhere::DatasetPtr& result) {
     free(res_ids);
 }
 
+static void
+RangeSearchOnSealed(const segcore::SealedIndexingEntry* field_indexing,
+                    const QueryInfo& query_info,
+                    const knowhere::DatasetPtr& query_dataset,
+                    int64_t num_queries,
+                    const faiss::BitsetView& bitset,
+                    QueryResult& result) {
+    auto conf = query_info.search_params_;
+    conf[milvus::knowhere::IndexParams::range_search_radius] = query_info.radius_.value();
+    conf[milvus::knowhere::Metric::TYPE] = MetricTypeToName(field_indexing->metric_type_);
+    auto final = field_indexing->indexing_->QueryByRange(query_dataset, conf, bitset);
+
+    auto ids = final->Get<idx_t*>(knowhere::meta::IDS);
+    auto distances = final->Get<float*>(knowhere::meta::DISTANCE);
+    auto lims = final->Get<size_t*>(knowhere::meta::LIMS);
+
+    RangeSubQueryResult sub_qr(num_queries, query_info.metric_type_);
+    auto total = lims[num_queries];
+    std::copy_n(lims, num_queries + 1, sub_qr.mutable_lims().data());
+    sub_qr.mutable_labels().assign(ids, ids + total);
+    sub_qr.mutable_values().assign(distances, distances + total);
+    sub_qr.sort_and_limit(query_info.topK_);
+
+    result.internal_seg_offsets_ = std::move(sub_qr.mutable_labels());
+    result.result_distances_ = std::move(sub_qr.mutable_values());
+    result.result_lims_ = std::move(sub_qr.mutable_lims());
+    result.num_queries_ = num_queries;
+    result.topK_ = query_info.topK_;
+
+    ReleaseQueryResult(final);
+    free(lims);
+}
+
 void
 SearchOnSealed(const Schema& schema,
                const segcore::SealedIndexingRecord& record,
@@ -86,6 +119,12 @@ SearchOnSealed(const Schema& schema,
     auto field_indexing = record.get_field_indexing(field_offset);
     Assert(field_indexing->metric_type_ == query_info.metric_type_);
 
+    if (query_info.radius_.has_value()) {
+        auto ds = knowhere::GenDataset(num_queries, dim, query_data);
+        RangeSearchOnSealed(field_indexing, query_info, ds, num_queries, bitset, result);
+        return;
+    }
+
     auto final = [&] {
         auto ds = knowhere::GenDataset(num_queries, dim, query_data);
 
@@ -0,0 +1,196 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/SearchStrategy.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <faiss/IndexIVF.h>
+#include "knowhere/index/vector_index/FaissBaseIndex.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus::query {
+
+// all costs below are in units of one full-precision distance computation
+// extra cost per row of copying passing rows into a contiguous block before computing
+constexpr double GATHER_OVERHEAD = 0.25;
+// bitset words scanned per distance computation when enumerating passing rows
+constexpr double BITSET_SCAN_WIDTH = 64;
+// average out-degree assumed when estimating nodes touched by a graph index
+constexpr double GRAPH_DEGREE = 32;
+// widen IVF params when the probed lists are expected to hold fewer passing rows than this many topk
+constexpr double WIDEN_CANDIDATE_FACTOR = 2;
+// widen graph params below this pass ratio
+constexpr double GRAPH_WIDEN_PASS_RATIO = 0.1;
+// upper bound of the search param scaling
+constexpr double MAX_WIDEN_FACTOR = 32;
+constexpr int64_t MAX_EF = 32768;
+constexpr int64_t MAX_SEARCH_LENGTH = 300;
+
+enum class IndexFamily { FLAT, IVF, GRAPH, OTHER };
+
+static IndexFamily
+GetIndexFamily(const knowhere::IndexType& index_type) {
+    namespace IndexEnum = knowhere::IndexEnum;
+    if (index_type.empty() || index_type == IndexEnum::INDEX_FAISS_IDMAP ||
+        index_type == IndexEnum::INDEX_FAISS_BIN_IDMAP) {
+        return IndexFamily::FLAT;
+    }
+    if (index_type.rfind("IVF", 0) == 0 || index_type.rfind("BIN_IVF", 0) == 0) {
+        return IndexFamily::IVF;
+    }
+    if (index_type == IndexEnum::INDEX_HNSW || index_type == IndexEnum::INDEX_RHNSWFlat ||
+        index_type == IndexEnum::INDEX_RHNSWPQ || index_type == IndexEnum::INDEX_RHNSWSQ ||
+        index_type == IndexEnum::INDEX_NSG || index_type == IndexEnum::INDEX_ANNOY ||
+        index_type == IndexEnum::INDEX_NGTPANNG || index_type == IndexEnum::INDEX_NGTONNG) {
+        return IndexFamily::GRAPH;
+    }
+    return IndexFamily::OTHER;
+}
+
+static int64_t
+GetIntParam(const knowhere::Config& params, const char* key, int64_t default_value) {
+    if (params.contains(key) && params[key].is_number_integer()) {
+        return params[key].get<int64_t>();
+    }
+    return default_value;
+}
+
+// nlist is usually picked around 4 * sqrt(n) when it's not known
+static double
+EffectiveNlist(const VectorSearchCostInfo& cost_info, int64_t row_count) {
+    if (cost_info.nlist > 0) {
+        return cost_info.nlist;
+    }
+    return std::max(1.0, 4 * std::sqrt(static_cast<double>(row_count)));
+}
+
+// fraction of the segment an IVF index scans with the given params
+static double
+IVFScanRatio(const VectorSearchCostInfo& cost_info, int64_t row_count) {
+    auto nlist = EffectiveNlist(cost_info, row_count);
+    auto nprobe = GetIntParam(cost_info.search_params, knowhere::IndexParams::nprobe, 1);
+    return std::min(1.0, nprobe / nlist);
+}
+
+static double
+EstimateIndexCost(const VectorSearchCostInfo& cost_info, int64_t row_count, double pass_ratio, int64_t topk) {
+    switch (GetIndexFamily(cost_info.index_type)) {
+        case IndexFamily::IVF: {
+            return row_count * IVFScanRatio(cost_info, row_count) + EffectiveNlist(cost_info, row_count);
+        }
+        case IndexFamily::GRAPH: {
+            auto ef = std::max(GetIntParam(cost_info.search_params, knowhere::IndexParams::ef, topk), topk);
+            // filtered nodes are still walked through, so the visited set grows as the pass ratio drops
+            auto cost = ef * GRAPH_DEGREE * std::log2(std::max<int64_t>(row_count, 2)) / pass_ratio;
+            return std::min(cost, static_cast<double>(row_count));
+        }
+        case IndexFamily::FLAT:
+        case IndexFamily::OTHER:
+        default: {
+            return row_count;
+        }
+    }
+}
+
+static bool
+NeedWidenParams(const VectorSearchCostInfo& cost_info, int64_t row_count, double pass_ratio, int64_t topk) {
+    switch (GetIndexFamily(cost_info.index_type)) {
+        case IndexFamily::IVF: {
+            auto passed_candidates = row_count * IVFScanRatio(cost_info, row_count) * pass_ratio;
+            return passed_candidates < topk * WIDEN_CANDIDATE_FACTOR;
+        }
+        case IndexFamily::GRAPH: {
+            return pass_ratio < GRAPH_WIDEN_PASS_RATIO;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+SearchStrategy
+ChooseSearchStrategy(const VectorSearchCostInfo& cost_info, int64_t row_count, int64_t passed_count, int64_t topk) {
+    if (row_count <= 0 || passed_count >= row_count) {
+        return SearchStrategy::INDEX;
+    }
+    auto pass_ratio = std::max(passed_count, int64_t(1)) / static_cast<double>(row_count);
+
+    if (cost_info.raw_data_available) {
+        auto brute_force_cost = passed_count * (1 + GATHER_OVERHEAD) + row_count / BITSET_SCAN_WIDTH;
+        if (brute_force_cost <= EstimateIndexCost(cost_info, row_count, pass_ratio, topk)) {
+            return SearchStrategy::BRUTE_FORCE_ON_PASSED;
+        }
+    }
+
+    if (!cost_info.index_type.empty() && NeedWidenParams(cost_info, row_count, pass_ratio, topk)) {
+        return SearchStrategy::WIDENED_INDEX;
+    }
+    return SearchStrategy::INDEX;
+}
+
+knowhere::Config
+WidenSearchParams(const knowhere::Config& search_params, double pass_ratio, int64_t nlist) {
+    auto factor = std::min(1.0 / std::max(pass_ratio, 1.0 / MAX_WIDEN_FACTOR), MAX_WIDEN_FACTOR);
+    auto widened = search_params;
+    auto scale = [&](const char* key, int64_t upper_bound) {
+        if (!widened.contains(key) || !widened[key].is_number_integer()) {
+            return;
+        }
+        auto value = widened[key].get<int64_t>();
+        if (value <= 0) {
+            return;
+        }
+        auto scaled = static_cast<int64_t>(std::ceil(value * factor));
+        widened[key] = upper_bound > 0 ? std::min(scaled, upper_bound) : scaled;
+    };
+    scale(knowhere::IndexParams::nprobe, nlist);
+    scale(knowhere::IndexParams::ef, MAX_EF);
+    scale(knowhere::IndexParams::search_k, 0);
+    scale(knowhere::IndexParams::search_length, MAX_SEARCH_LENGTH);
+    return widened;
+}
+
+int64_t
+GetIndexNlist(const knowhere::VecIndex& index) {
+    auto faiss_index = dynamic_cast<const knowhere::FaissBaseIndex*>(&index);
+    if (!faiss_index || !faiss_index->index_) {
+        return 0;
+    }
+    auto ivf = dynamic_cast<const faiss::IndexIVF*>(faiss_index->index_.get());
+    return ivf ? ivf->nlist : 0;
+}
+
+std::vector<int64_t>
+GetPassedOffsets(const BitsetView& bitset, int64_t size) {
+    std::vector<int64_t> offsets;
+    if (bitset.empty()) {
+        offsets.resize(size);
+        std::iota(offsets.begin(), offsets.end(), 0);
+        return offsets;
+    }
+    auto blocks = bitset.data();
+    for (int64_t byte_id = 0; byte_id * 8 < size; ++byte_id) {
+        auto block = blocks[byte_id];
+        if (block == 0xFF) {
+            continue;
+        }
+        auto end = std::min<int64_t>(byte_id * 8 + 8, size);
+        for (auto offset = byte_id * 8; offset < end; ++offset) {
+            if (!((block >> (offset % 8)) & 0x1)) {
+                offsets.push_back(offset);
+            }
+        }
+    }
+    return offsets;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,51 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <vector>
+#include "common/Types.h"
+#include "knowhere/common/Config.h"
+#include "knowhere/index/IndexType.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus::query {
+
+// what a segment can offer for searching one vector field
+struct VectorSearchCostInfo {
+    // empty when the field is only searchable by brute force
+    knowhere::IndexType index_type;
+    // search params the index would be queried with
+    knowhere::Config search_params;
+    // 0 when unknown or not an IVF index
+    int64_t nlist = 0;
+    // whether raw vectors can be gathered by segment offset
+    bool raw_data_available = false;
+};
+
+// cost-based choice between index search with bitset, brute force over the passing rows
+// and index search with widened params, driven by the predicate pass count and topk
+SearchStrategy
+ChooseSearchStrategy(const VectorSearchCostInfo& cost_info, int64_t row_count, int64_t passed_count, int64_t topk);
+
+// scale nprobe/ef-like search params by the inverse pass ratio, so that enough passing candidates are reached
+knowhere::Config
+WidenSearchParams(const knowhere::Config& search_params, double pass_ratio, int64_t nlist);
+
+// nlist of an IVF index, 0 for other index types
+int64_t
+GetIndexNlist(const knowhere::VecIndex& index);
+
+// offsets in [0, size) whose bit is not set, i.e. rows passing the predicate
+std::vector<int64_t>
+GetPassedOffsets(const BitsetView& bitset, int64_t size);
+
+}  // namespace milvus::query
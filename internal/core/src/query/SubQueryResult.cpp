@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <numeric>
 #include "exceptions/EasyAssert.h"
 #include "query/SubQueryResult.h"
 #include "segcore/Reduce.h"
@@ -74,4 +76,61 @@ SubQueryResult::merge(const SubQueryResult& left, const SubQueryResult& right) {
     return left_copy;
 }
 
+void
+RangeSubQueryResult::merge(const RangeSubQueryResult& sub_result) {
+    Assert(num_queries_ == sub_result.num_queries_);
+    Assert(metric_type_ == sub_result.metric_type_);
+    if (sub_result.labels_.empty()) {
+        return;
+    }
+
+    auto total = labels_.size() + sub_result.labels_.size();
+    std::vector<int64_t> lims(num_queries_ + 1, 0);
+    std::vector<int64_t> labels;
+    std::vector<float> values;
+    labels.reserve(total);
+    values.reserve(total);
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        for (auto src : std::initializer_list<const RangeSubQueryResult*>{this, &sub_result}) {
+            auto begin = src->lims_[qn];
+            auto end = src->lims_[qn + 1];
+            labels.insert(labels.end(), src->labels_.begin() + begin, src->labels_.begin() + end);
+            values.insert(values.end(), src->values_.begin() + begin, src->values_.begin() + end);
+        }
+        lims[qn + 1] = labels.size();
+    }
+    lims_ = std::move(lims);
+    labels_ = std::move(labels);
+    values_ = std::move(values);
+}
+
+void
+RangeSubQueryResult::sort_and_limit(int64_t limit) {
+    auto is_desc = SubQueryResult::is_descending(metric_type_);
+    std::vector<int64_t> lims(num_queries_ + 1, 0);
+    std::vector<int64_t> labels;
+    std::vector<float> values;
+    std::vector<int64_t> order;
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        auto begin = lims_[qn];
+        auto count = lims_[qn + 1] - begin;
+        auto keep = limit > 0 ? std::min(count, limit) : count;
+
+        order.resize(count);
+        std::iota(order.begin(), order.end(), begin);
+        auto cmp = [&](int64_t a, int64_t b) {
+            return is_desc ? values_[a] > values_[b] : values_[a] < values_[b];
+        };
+        std::partial_sort(order.begin(), order.begin() + keep, order.end(), cmp);
+        for (int64_t i = 0; i < keep; ++i) {
+            labels.push_back(labels_[order[i]]);
+            values.push_back(values_[order[i]]);
+        }
+        lims[qn + 1] = labels.size();
+    }
+    lims_ = std::move(lims);
+    labels_ = std::move(labels);
+    values_ = std::move(values);
+}
+
 }  // namespace milvus::query
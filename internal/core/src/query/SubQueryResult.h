@@ -95,4 +95,62 @@ class SubQueryResult {
     std::vector<float> values_;
 };
 
+// hits of a range search, variable length per query: hits of query i are [lims[i], lims[i + 1])
+class RangeSubQueryResult {
+ public:
+    RangeSubQueryResult(int64_t num_queries, MetricType metric_type)
+        : metric_type_(metric_type), num_queries_(num_queries), lims_(num_queries + 1, 0) {
+    }
+
+ public:
+    int64_t
+    get_num_queries() const {
+        return num_queries_;
+    }
+    MetricType
+    get_metric_type() const {
+        return metric_type_;
+    }
+
+    auto&
+    mutable_lims() {
+        return lims_;
+    }
+    auto&
+    mutable_labels() {
+        return labels_;
+    }
+    auto&
+    mutable_values() {
+        return values_;
+    }
+    const auto&
+    get_lims() const {
+        return lims_;
+    }
+    const auto&
+    get_labels() const {
+        return labels_;
+    }
+    const auto&
+    get_values() const {
+        return values_;
+    }
+
+    // append the hits of sub_result to the hits of the same query
+    void
+    merge(const RangeSubQueryResult& sub_result);
+
+    // order the hits of each query from the best to the worst, and keep at most limit of them (0 for no limit)
+    void
+    sort_and_limit(int64_t limit);
+
+ private:
+    MetricType metric_type_;
+    int64_t num_queries_;
+    std::vector<int64_t> lims_;
+    std::vector<int64_t> labels_;
+    std::vector<float> values_;
+};
+
 }  // namespace milvus::query
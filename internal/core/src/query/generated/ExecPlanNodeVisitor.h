@@ -16,6 +16,7 @@
 #include "query/PlanImpl.h"
 #include "segcore/SegmentGrowing.h"
 #include <utility>
+#include "query/SearchBound.h"
 #include "PlanNodeVisitor.h"
 
 namespace milvus::query {
@@ -27,12 +28,19 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     void
     visit(BinaryVectorANNS& node) override;
 
+    void
+    visit(Int8VectorANNS& node) override;
+
  public:
     using RetType = QueryResult;
     ExecPlanNodeVisitor(const segcore::SegmentInterface& segment,
                         Timestamp timestamp,
-                        const PlaceholderGroup& placeholder_group)
-        : segment_(segment), timestamp_(timestamp), placeholder_group_(placeholder_group) {
+                        const PlaceholderGroup& placeholder_group,
+                        SearchBound* search_bound = nullptr)
+        : segment_(segment),
+          timestamp_(timestamp),
+          placeholder_group_(placeholder_group),
+          search_bound_(search_bound) {
     }
     // using RetType = nlohmann::json;
 
@@ -56,6 +64,7 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     const segcore::SegmentInterface& segment_;
     Timestamp timestamp_;
     const PlaceholderGroup& placeholder_group_;
+    SearchBound* search_bound_;
 
     std::optional<RetType> ret_;
 };
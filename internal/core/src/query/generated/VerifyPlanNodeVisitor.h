@@ -27,6 +27,9 @@ class VerifyPlanNodeVisitor : public PlanNodeVisitor {
     void
     visit(BinaryVectorANNS& node) override;
 
+    void
+    visit(Int8VectorANNS& node) override;
+
  public:
     using RetType = QueryResult;
     VerifyPlanNodeVisitor() = default;
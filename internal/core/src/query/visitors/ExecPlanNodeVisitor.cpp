@@ -13,11 +13,13 @@
 #include "query/PlanImpl.h"
 #include "segcore/SegmentGrowing.h"
 #include <utility>
+#include "query/SearchBound.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/generated/ExecExprVisitor.h"
 #include "query/SearchOnGrowing.h"
 #include "query/SearchOnSealed.h"
+#include "query/SearchStrategy.h"
 
 namespace milvus::query {
 
@@ -30,8 +32,12 @@ class ExecPlanNodeVisitor : PlanNodeVisitor {
     using RetType = QueryResult;
     ExecPlanNodeVisitor(const segcore::SegmentInterface& segment,
                         Timestamp timestamp,
-                        const PlaceholderGroup& placeholder_group)
-        : segment_(segment), timestamp_(timestamp), placeholder_group_(placeholder_group) {
+                        const PlaceholderGroup& placeholder_group,
+                        SearchBound* search_bound = nullptr)
+        : segment_(segment),
+          timestamp_(timestamp),
+          placeholder_group_(placeholder_group),
+          search_bound_(search_bound) {
     }
     // using RetType = nlohmann::json;
 
@@ -55,12 +61,39 @@ class ExecPlanNodeVisitor : PlanNodeVisitor {
     const segcore::SegmentInterface& segment_;
     Timestamp timestamp_;
     const PlaceholderGroup& placeholder_group_;
+    SearchBound* search_bound_;
 
     std::optional<RetType> ret_;
 };
 }  // namespace impl
 #endif
 
+// whether any query may find a hit within the search bound, judged by the bounding ball of the segment
+template <typename EmbeddedType>
+static bool
+CanReachSearchBound(const segcore::SegmentInternalInterface& segment,
+                    const QueryInfo& query_info,
+                    const EmbeddedType* query_data,
+                    int64_t num_queries,
+                    const SearchBound& search_bound) {
+    if constexpr (!std::is_same_v<EmbeddedType, float>) {
+        return true;
+    } else {
+        auto ball = segment.get_vector_bounding_ball(query_info.field_offset_);
+        if (!ball) {
+            return true;
+        }
+        auto dim = ball->centroid_.size();
+        for (int64_t i = 0; i < num_queries; ++i) {
+            auto best_distance = ball->best_distance(query_data + i * dim, query_info.metric_type_);
+            if (!search_bound.is_worse(best_distance, search_bound.get(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
 template <typename VectorType>
 void
 ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
@@ -84,7 +117,33 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
         view = BitsetView(bitset_holder.data(), bitset_holder.size() * 8);
     }
 
-    segment->vector_search(row_count, node.query_info_, src_data, num_queries, view, ret);
+    auto query_info = node.query_info_;
+    // the cost model assumes topk bounded results, range search keeps the default strategy
+    if (!view.empty() && !query_info.radius_.has_value()) {
+        // padding bits of the assembled bitset are set, so they count as filtered rows
+        auto passed_count = view.size() - static_cast<int64_t>(view.count_1());
+        auto cost_info = segment->get_vector_search_cost_info(query_info);
+        query_info.search_strategy_ = ChooseSearchStrategy(cost_info, row_count, passed_count, query_info.topK_);
+        query_info.pass_ratio_ = row_count == 0 ? 1.0 : static_cast<double>(passed_count) / row_count;
+    }
+
+    // the bound only applies to topk search
+    auto search_bound = query_info.radius_.has_value() ? nullptr : search_bound_;
+    if (search_bound && !CanReachSearchBound(*segment, query_info, src_data, num_queries, *search_bound)) {
+        ret = QueryResult(num_queries, query_info.topK_);
+        std::fill(ret.internal_seg_offsets_.begin(), ret.internal_seg_offsets_.end(), -1);
+        std::fill(ret.result_distances_.begin(), ret.result_distances_.end(),
+                  SubQueryResult::init_value(query_info.metric_type_));
+        ret_ = ret;
+        return;
+    }
+
+    segment->vector_search(row_count, query_info, src_data, num_queries, view, ret);
+    ret.search_strategy_ = query_info.search_strategy_;
+    if (search_bound) {
+        search_bound->prune(ret);
+        search_bound->update(ret);
+    }
 
     ret_ = ret;
 }
@@ -99,4 +158,9 @@ ExecPlanNodeVisitor::visit(BinaryVectorANNS& node) {
     VectorVisitorImpl<BinaryVector>(node);
 }
 
+void
+ExecPlanNodeVisitor::visit(Int8VectorANNS& node) {
+    VectorVisitorImpl<Int8Vector>(node);
+}
+
 }  // namespace milvus::query
@@ -93,4 +93,26 @@ ShowPlanNodeVisitor::visit(BinaryVectorANNS& node) {
     ret_ = json_body;
 }
 
+void
+ShowPlanNodeVisitor::visit(Int8VectorANNS& node) {
+    assert(!ret_);
+    auto& info = node.query_info_;
+    Json json_body{
+        {"node_type", "Int8VectorANNS"},                       //
+        {"metric_type", MetricTypeToName(info.metric_type_)},  //
+        {"field_offset_", info.field_offset_.get()},           //
+        {"topK", info.topK_},                                  //
+        {"search_params", info.search_params_},                //
+        {"placeholder_tag", node.placeholder_tag_},            //
+    };
+    if (node.predicate_.has_value()) {
+        ShowExprVisitor expr_show;
+        Assert(node.predicate_.value());
+        json_body["predicate"] = expr_show.call_child(node.predicate_->operator*());
+    } else {
+        json_body["predicate"] = "None";
+    }
+    ret_ = json_body;
+}
+
 }  // namespace milvus::query
@@ -39,6 +39,7 @@ InferIndexType(const Json& search_params) {
     // hnsw/rhnsw/*pq/*sq -> ef
     // annoy -> search_k
     // ngtpanng / ngtonng -> max_search_edges / epsilon
+    // idmap -> range_search_radius only
     static const std::map<std::string, knowhere::IndexType> key_list = [] {
         std::map<std::string, knowhere::IndexType> list;
         namespace ip = knowhere::IndexParams;
@@ -58,6 +59,9 @@ InferIndexType(const Json& search_params) {
             return key_list.at(key);
         }
     }
+    if (search_params.contains(knowhere::IndexParams::range_search_radius)) {
+        return knowhere::IndexEnum::INDEX_FAISS_IDMAP;
+    }
     PanicCodeInfo(ErrorCodeEnum::IllegalArgument, "failed to infer index type");
 }
 
@@ -108,4 +112,9 @@ VerifyPlanNodeVisitor::visit(BinaryVectorANNS& node) {
     }
 }
 
+void
+VerifyPlanNodeVisitor::visit(Int8VectorANNS& node) {
+    // int8 vectors have no index, the search params are not used
+}
+
 }  // namespace milvus::query
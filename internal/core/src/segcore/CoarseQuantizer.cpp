@@ -0,0 +1,79 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/CoarseQuantizer.h"
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+#include <mutex>
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+bool
+matches(const CoarseQuantizerPtr& quantizer, int64_t dim, MetricType metric_type, int64_t nlist) {
+    auto& index = quantizer->index_;
+    return index->d == dim && index->metric_type == metric_type && index->ntotal == nlist;
+}
+}  // namespace
+
+CoarseQuantizerPtr
+CoarseQuantizerPool::get(FieldOffset field_offset) const {
+    std::shared_lock lck(mutex_);
+    auto iter = quantizers_.find(field_offset);
+    return iter == quantizers_.end() ? nullptr : iter->second;
+}
+
+CoarseQuantizerPtr
+CoarseQuantizerPool::get_or_train(FieldOffset field_offset,
+                                  int64_t dim,
+                                  MetricType metric_type,
+                                  int64_t nlist,
+                                  int64_t num_rows,
+                                  const float* data) {
+    auto current = get(field_offset);
+    if (current && matches(current, dim, metric_type, nlist)) {
+        return current;
+    }
+
+    // trained under the lock, so concurrent chunks of the field train it once
+    std::unique_lock lck(mutex_);
+    auto iter = quantizers_.find(field_offset);
+    if (iter != quantizers_.end() && matches(iter->second, dim, metric_type, nlist)) {
+        return iter->second;
+    }
+    AssertInfo(num_rows >= nlist, "too few rows to train the coarse quantizer");
+    // the same training as knowhere::IVF::Train
+    auto index = std::make_shared<faiss::IndexFlat>(dim, metric_type);
+    faiss::IndexIVFFlat ivf(index.get(), dim, nlist, metric_type);
+    ivf.train(num_rows, data);
+    return publish_locked(field_offset, index);
+}
+
+CoarseQuantizerPtr
+CoarseQuantizerPool::publish(
+    FieldOffset field_offset, int64_t dim, MetricType metric_type, int64_t nlist, const float* centroids) {
+    auto index = std::make_shared<faiss::IndexFlat>(dim, metric_type);
+    index->add(nlist, centroids);
+    std::unique_lock lck(mutex_);
+    return publish_locked(field_offset, index);
+}
+
+CoarseQuantizerPtr
+CoarseQuantizerPool::publish_locked(FieldOffset field_offset, std::shared_ptr<faiss::Index> index) {
+    auto quantizer = std::make_shared<CoarseQuantizer>();
+    quantizer->version_ = ++last_version_;
+    quantizer->index_ = std::move(index);
+    quantizers_[field_offset] = quantizer;
+    return quantizer;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <faiss/Index.h>
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// trained IVF centroids of a vector field, shared by the chunk indexes of all the segments of a collection.
+// a published version never changes, so indexes built on the same version have the same lists
+struct CoarseQuantizer {
+    int64_t version_;
+    std::shared_ptr<faiss::Index> index_;  // IndexFlat with the centroids
+};
+
+using CoarseQuantizerPtr = std::shared_ptr<const CoarseQuantizer>;
+
+// one per collection, the current version of each vector field
+class CoarseQuantizerPool {
+ public:
+    // nullptr if the field has none yet
+    CoarseQuantizerPtr
+    get(FieldOffset field_offset) const;
+
+    // the current version if it has this dim, metric type and nlist,
+    // otherwise trained on the given vectors and published as the next version
+    CoarseQuantizerPtr
+    get_or_train(FieldOffset field_offset,
+                 int64_t dim,
+                 MetricType metric_type,
+                 int64_t nlist,
+                 int64_t num_rows,
+                 const float* data);
+
+    // publishes already trained centroids, size nlist * dim, as the next version.
+    // the indexes built on the previous versions keep them
+    CoarseQuantizerPtr
+    publish(FieldOffset field_offset, int64_t dim, MetricType metric_type, int64_t nlist, const float* centroids);
+
+ private:
+    CoarseQuantizerPtr
+    publish_locked(FieldOffset field_offset, std::shared_ptr<faiss::Index> index);
+
+ private:
+    mutable std::shared_mutex mutex_;
+    int64_t last_version_ = 0;
+    std::map<FieldOffset, CoarseQuantizerPtr> quantizers_;
+};
+
+using CoarseQuantizerPoolPtr = std::shared_ptr<CoarseQuantizerPool>;
+
+}  // namespace milvus::segcore
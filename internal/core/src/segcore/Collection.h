@@ -12,6 +12,7 @@
 #pragma once
 
 #include "common/Schema.h"
+#include "segcore/CoarseQuantizer.h"
 #include <string>
 #include <memory>
 
@@ -35,10 +36,17 @@ class Collection {
         return collection_name_;
     }
 
+    // shared by the growing segments of the collection
+    const CoarseQuantizerPoolPtr&
+    get_coarse_quantizer_pool() {
+        return coarse_quantizer_pool_;
+    }
+
  private:
     std::string collection_name_;
     std::string schema_proto_;
     SchemaPtr schema_;
+    CoarseQuantizerPoolPtr coarse_quantizer_pool_ = std::make_shared<CoarseQuantizerPool>();
 };
 
 using CollectionPtr = std::unique_ptr<Collection>;
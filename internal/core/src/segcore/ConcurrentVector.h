@@ -107,8 +107,12 @@ class ConcurrentVectorImpl : public VectorBase {
     ConcurrentVectorImpl&
     operator=(const ConcurrentVectorImpl&) = delete;
 
-    using TraitType =
-        std::conditional_t<is_scalar, Type, std::conditional_t<std::is_same_v<Type, float>, FloatVector, BinaryVector>>;
+    using TraitType = std::conditional_t<
+        is_scalar,
+        Type,
+        std::conditional_t<std::is_same_v<Type, float>,
+                           FloatVector,
+                           std::conditional_t<std::is_same_v<Type, int8_t>, Int8Vector, BinaryVector>>>;
 
  public:
     explicit ConcurrentVectorImpl(ssize_t dim, int64_t size_per_chunk)
@@ -246,6 +250,14 @@ class ConcurrentVector<FloatVector> : public ConcurrentVectorImpl<float, false>
     }
 };
 
+template <>
+class ConcurrentVector<Int8Vector> : public ConcurrentVectorImpl<int8_t, false> {
+ public:
+    ConcurrentVector(int64_t dim, int64_t size_per_chunk)
+        : ConcurrentVectorImpl<int8_t, false>::ConcurrentVectorImpl(dim, size_per_chunk) {
+    }
+};
+
 template <>
 class ConcurrentVector<BinaryVector> : public ConcurrentVectorImpl<uint8_t, false> {
  public:
@@ -13,6 +13,7 @@
 #include <thread>
 #include <knowhere/index/vector_index/IndexIVF.h>
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
+#include <knowhere/index/vector_index/helpers/IndexParameter.h>
 #include <string>
 #include "common/SystemProperty.h"
 
@@ -28,12 +29,22 @@ VectorFieldIndexing::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const Vec
     assert(ack_end <= num_chunk);
     auto conf = get_build_params();
     data_.grow_to_at_least(ack_end);
+    quantizers_.grow_to_at_least(ack_end);
     for (int chunk_id = ack_beg; chunk_id < ack_end; chunk_id++) {
         const auto& chunk = source->get_chunk(chunk_id);
         // build index for chunk
         auto indexing = std::make_unique<knowhere::IVF>();
         auto dataset = knowhere::GenDataset(source->get_size_per_chunk(), dim, chunk.data());
-        indexing->Train(dataset, conf);
+        if (coarse_quantizer_pool_) {
+            // the first chunk of the field trains the centroids for the whole collection
+            auto quantizer = coarse_quantizer_pool_->get_or_train(
+                field_offset_, dim, field_meta_.get_metric_type().value(), conf[knowhere::IndexParams::nlist].get<int64_t>(),
+                source->get_size_per_chunk(), chunk.data());
+            indexing->InitWithQuantizer(quantizer->index_, conf);
+            quantizers_[chunk_id] = quantizer;
+        } else {
+            indexing->Train(dataset, conf);
+        }
         indexing->AddWithoutIds(dataset, conf);
         data_[chunk_id] = std::move(indexing);
     }
@@ -115,10 +126,14 @@ ScalarFieldIndexing<T>::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const
 }
 
 std::unique_ptr<FieldIndexing>
-CreateIndex(const FieldMeta& field_meta, const SegcoreConfig& segcore_config) {
+CreateIndex(const FieldMeta& field_meta,
+            const SegcoreConfig& segcore_config,
+            FieldOffset field_offset,
+            const CoarseQuantizerPoolPtr& coarse_quantizer_pool) {
     if (field_meta.is_vector()) {
         if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-            return std::make_unique<VectorFieldIndexing>(field_meta, segcore_config);
+            return std::make_unique<VectorFieldIndexing>(field_meta, segcore_config, field_offset,
+                                                         coarse_quantizer_pool);
         } else {
             // TODO
             PanicInfo("unsupported");
@@ -20,6 +20,7 @@
 #include <knowhere/index/vector_index/IndexIVF.h>
 #include <knowhere/index/structured_index_simple/StructuredIndexSort.h>
 #include "segcore/SegcoreConfig.h"
+#include "segcore/CoarseQuantizer.h"
 
 namespace milvus::segcore {
 
@@ -77,7 +78,15 @@ class ScalarFieldIndexing : public FieldIndexing {
 
 class VectorFieldIndexing : public FieldIndexing {
  public:
-    using FieldIndexing::FieldIndexing;
+    // with a coarse quantizer pool, the chunk indexes use the shared centroids of the field instead of training
+    VectorFieldIndexing(const FieldMeta& field_meta,
+                        const SegcoreConfig& segcore_config,
+                        FieldOffset field_offset,
+                        CoarseQuantizerPoolPtr coarse_quantizer_pool)
+        : FieldIndexing(field_meta, segcore_config),
+          field_offset_(field_offset),
+          coarse_quantizer_pool_(std::move(coarse_quantizer_pool)) {
+    }
 
     void
     BuildIndexRange(int64_t ack_beg, int64_t ack_end, const VectorBase* vec_base) override;
@@ -95,17 +104,31 @@ class VectorFieldIndexing : public FieldIndexing {
     knowhere::Config
     get_search_params(int top_k) const;
 
+    // the shared centroids the chunk index was built on, nullptr if it trained its own
+    CoarseQuantizerPtr
+    get_chunk_quantizer(int64_t chunk_id) const {
+        return quantizers_.at(chunk_id);
+    }
+
  private:
+    FieldOffset field_offset_;
+    CoarseQuantizerPoolPtr coarse_quantizer_pool_;
     tbb::concurrent_vector<std::unique_ptr<knowhere::VecIndex>> data_;
+    tbb::concurrent_vector<CoarseQuantizerPtr> quantizers_;
 };
 
 std::unique_ptr<FieldIndexing>
-CreateIndex(const FieldMeta& field_meta, const SegcoreConfig& segcore_config);
+CreateIndex(const FieldMeta& field_meta,
+            const SegcoreConfig& segcore_config,
+            FieldOffset field_offset,
+            const CoarseQuantizerPoolPtr& coarse_quantizer_pool);
 
 class IndexingRecord {
  public:
-    explicit IndexingRecord(const Schema& schema, const SegcoreConfig& segcore_config)
-        : schema_(schema), segcore_config_(segcore_config) {
+    explicit IndexingRecord(const Schema& schema,
+                            const SegcoreConfig& segcore_config,
+                            CoarseQuantizerPoolPtr coarse_quantizer_pool = nullptr)
+        : schema_(schema), segcore_config_(segcore_config), coarse_quantizer_pool_(std::move(coarse_quantizer_pool)) {
         Initialize();
     }
 
@@ -121,13 +144,17 @@ class IndexingRecord {
                 if (field.get_data_type() == DataType::VECTOR_BINARY) {
                     continue;
                 }
+                // int8 vectors are searched by brute force only
+                if (field.get_data_type() == DataType::VECTOR_INT8) {
+                    continue;
+                }
                 // flat should be skipped
                 if (!field.get_metric_type().has_value()) {
                     continue;
                 }
             }
 
-            field_indexings_.try_emplace(offset, CreateIndex(field, segcore_config_));
+            field_indexings_.try_emplace(offset, CreateIndex(field, segcore_config_, offset, coarse_quantizer_pool_));
         }
         assert(offset_id == schema_.size());
     }
@@ -173,6 +200,7 @@ class IndexingRecord {
  private:
     const Schema& schema_;
     const SegcoreConfig& segcore_config_;
+    CoarseQuantizerPoolPtr coarse_quantizer_pool_;
 
  private:
     // control info
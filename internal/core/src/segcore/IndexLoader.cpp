@@ -0,0 +1,211 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/IndexLoader.h"
+
+#include <faiss/IndexBinaryFlat.h>
+#include <faiss/IndexBinaryIVF.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVF.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "exceptions/EasyAssert.h"
+#include "knowhere/index/vector_index/FaissBaseBinaryIndex.h"
+#include "knowhere/index/vector_index/FaissBaseIndex.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_offset_index/OffsetBaseIndex.h"
+#include "segcore/ResidencyManager.h"
+
+namespace milvus::segcore {
+
+constexpr int64_t PAGE_SIZE = 4096;
+constexpr int64_t COPY_BLOCK_SIZE = 16 << 20;
+
+LoadIndexStage
+LoadIndexFuture::stage() const {
+    std::lock_guard lck(mutex_);
+    return stage_;
+}
+
+bool
+LoadIndexFuture::finished() const {
+    auto current = stage();
+    return current == LoadIndexStage::DONE || current == LoadIndexStage::FAILED;
+}
+
+void
+LoadIndexFuture::Wait() const {
+    std::unique_lock lck(mutex_);
+    cond_.wait(lck, [&] { return stage_ == LoadIndexStage::DONE || stage_ == LoadIndexStage::FAILED; });
+}
+
+bool
+LoadIndexFuture::WaitFor(int64_t timeout_ms) const {
+    std::unique_lock lck(mutex_);
+    return cond_.wait_for(lck, std::chrono::milliseconds(timeout_ms),
+                          [&] { return stage_ == LoadIndexStage::DONE || stage_ == LoadIndexStage::FAILED; });
+}
+
+std::string
+LoadIndexFuture::error() const {
+    std::lock_guard lck(mutex_);
+    return error_;
+}
+
+void
+LoadIndexFuture::set_stage(LoadIndexStage stage) {
+    {
+        std::lock_guard lck(mutex_);
+        stage_ = stage;
+    }
+    cond_.notify_all();
+}
+
+void
+LoadIndexFuture::set_failed(const std::string& error) {
+    {
+        std::lock_guard lck(mutex_);
+        stage_ = LoadIndexStage::FAILED;
+        error_ = error;
+    }
+    cond_.notify_all();
+}
+
+knowhere::VecIndexPtr
+LoadVecIndex(const std::map<std::string, std::string>& index_params, const knowhere::BinarySet& binary_set) {
+    AssertInfo(index_params.count("index_type"), "index_type not found in index params");
+    auto mode = knowhere::IndexMode::MODE_CPU;
+    if (index_params.count("index_mode") && index_params.at("index_mode") == "MMAP") {
+        mode = knowhere::IndexMode::MODE_MMAP;
+    } else if (index_params.count("index_mode") && index_params.at("index_mode") != "CPU") {
+        mode = knowhere::IndexMode::MODE_GPU;
+    }
+    auto index = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(index_params.at("index_type"), mode);
+    AssertInfo(index != nullptr, "unsupported index type " + index_params.at("index_type"));
+    index->Load(binary_set);
+    return index;
+}
+
+// one read per page is enough to fault it in
+static int64_t
+TouchPages(const void* data, int64_t size) {
+    if (data == nullptr) {
+        return 0;
+    }
+    auto bytes = reinterpret_cast<const volatile uint8_t*>(data);
+    int64_t sum = 0;
+    for (int64_t offset = 0; offset < size; offset += PAGE_SIZE) {
+        sum += bytes[offset];
+    }
+    if (size > 0) {
+        sum += bytes[size - 1];
+    }
+    return sum;
+}
+
+static void
+TouchInvertedLists(const faiss::InvertedLists* invlists, bool with_codes) {
+    if (invlists == nullptr) {
+        return;
+    }
+    auto nlist = static_cast<int64_t>(invlists->nlist);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t list_no = 0; list_no < nlist; ++list_no) {
+        auto list_size = invlists->list_size(list_no);
+        if (list_size == 0) {
+            continue;
+        }
+        if (with_codes) {
+            faiss::InvertedLists::ScopedCodes codes(invlists, list_no);
+            TouchPages(codes.get(), list_size * invlists->code_size);
+        }
+        faiss::InvertedLists::ScopedIds ids(invlists, list_no);
+        TouchPages(ids.get(), list_size * sizeof(faiss::InvertedLists::idx_t));
+    }
+}
+
+static void
+TouchFaissIndex(const faiss::Index* index, bool with_codes) {
+    if (auto ivf = dynamic_cast<const faiss::IndexIVF*>(index)) {
+        TouchFaissIndex(ivf->quantizer, true);
+        TouchInvertedLists(ivf->invlists, with_codes);
+    } else if (auto flat = dynamic_cast<const faiss::IndexFlat*>(index)) {
+        TouchPages(flat->xb.data(), flat->xb.size() * sizeof(float));
+    }
+}
+
+static void
+TouchFaissBinaryIndex(const faiss::IndexBinary* index) {
+    if (auto ivf = dynamic_cast<const faiss::IndexBinaryIVF*>(index)) {
+        TouchFaissBinaryIndex(ivf->quantizer);
+        TouchInvertedLists(ivf->invlists, true);
+    } else if (auto flat = dynamic_cast<const faiss::IndexBinaryFlat*>(index)) {
+        TouchPages(flat->xb.data(), flat->xb.size());
+    }
+}
+
+void
+WarmUpVecIndex(const knowhere::VecIndex& index) {
+    // other index types are walked by their first searches
+    if (index.index_mode() == knowhere::IndexMode::MODE_MMAP) {
+        // faulting in all mapped lists would defeat the mapping, search prefetches the probed lists
+        return;
+    }
+    if (auto faiss_index = dynamic_cast<const knowhere::FaissBaseIndex*>(&index)) {
+        TouchFaissIndex(faiss_index->index_.get(), true);
+    } else if (auto offset_index = dynamic_cast<const knowhere::OffsetBaseIndex*>(&index)) {
+        // the inverted lists of the offset indexes keep no codes, their raw data is copied in by Load
+        TouchFaissIndex(offset_index->index_.get(), false);
+    } else if (auto binary_index = dynamic_cast<const knowhere::FaissBaseBinaryIndex*>(&index)) {
+        TouchFaissBinaryIndex(binary_index->index_.get());
+    }
+}
+
+std::string
+KeepIndexFile(const knowhere::BinarySet& binary_set) {
+    auto& residency_manager = ResidencyManager::GetInstance();
+    if (residency_manager.budget() == 0) {
+        return "";
+    }
+    auto index_file = residency_manager.SpillFile(residency_manager.NextName("load_index"));
+    WriteBinarySet(index_file, binary_set);
+    return index_file;
+}
+
+knowhere::BinarySet
+CopyBinarySet(const knowhere::BinarySet& binary_set) {
+    struct Block {
+        const uint8_t* src;
+        uint8_t* dst;
+        int64_t size;
+    };
+    knowhere::BinarySet copy;
+    std::vector<Block> blocks;
+    for (auto& [name, binary] : binary_set.binary_map_) {
+        std::shared_ptr<uint8_t[]> data(new uint8_t[binary->size]);
+        for (int64_t offset = 0; offset < binary->size; offset += COPY_BLOCK_SIZE) {
+            auto size = std::min(COPY_BLOCK_SIZE, binary->size - offset);
+            blocks.push_back({binary->data.get() + offset, data.get() + offset, size});
+        }
+        copy.Append(name, data, binary->size);
+    }
+    // an index is a few large binaries, split them so all threads copy
+#pragma omp parallel for
+    for (int64_t i = 0; i < static_cast<int64_t>(blocks.size()); ++i) {
+        memcpy(blocks[i].dst, blocks[i].src, blocks[i].size);
+    }
+    return copy;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "knowhere/common/BinarySet.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus::segcore {
+
+enum class LoadIndexStage : int {
+    PENDING = 0,
+    DESERIALIZING = 1,
+    WARMING_UP = 2,
+    SWAPPING = 3,
+    DONE = 4,
+    FAILED = 5,
+};
+
+// completion handle of a background index load
+class LoadIndexFuture {
+ public:
+    LoadIndexStage
+    stage() const;
+
+    // true when the load is done or failed
+    bool
+    finished() const;
+
+    // blocks until the load is done or failed
+    void
+    Wait() const;
+
+    // false on timeout
+    bool
+    WaitFor(int64_t timeout_ms) const;
+
+    // set when the load failed
+    std::string
+    error() const;
+
+    void
+    set_stage(LoadIndexStage stage);
+
+    void
+    set_failed(const std::string& error);
+
+ private:
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cond_;
+    LoadIndexStage stage_ = LoadIndexStage::PENDING;
+    std::string error_;
+};
+
+using LoadIndexFuturePtr = std::shared_ptr<LoadIndexFuture>;
+
+// creates the index named by the index_type and index_mode params and loads the binaries into it
+knowhere::VecIndexPtr
+LoadVecIndex(const std::map<std::string, std::string>& index_params, const knowhere::BinarySet& binary_set);
+
+// touches every page of the index data, so the first searches don't pay for page faults
+void
+WarmUpVecIndex(const knowhere::VecIndex& index);
+
+// writes the binaries to a spill file when the ResidencyManager has a budget, empty otherwise
+std::string
+KeepIndexFile(const knowhere::BinarySet& binary_set);
+
+// deep copy, the binaries handed over by the caller may not outlive the call
+knowhere::BinarySet
+CopyBinarySet(const knowhere::BinarySet& binary_set);
+
+}  // namespace milvus::segcore
@@ -22,6 +22,9 @@ InsertRecord::InsertRecord(const Schema& schema, int64_t size_per_chunk) : uids_
             } else if (field.get_data_type() == DataType::VECTOR_BINARY) {
                 this->append_field_data<BinaryVector>(field.get_dim(), size_per_chunk);
                 continue;
+            } else if (field.get_data_type() == DataType::VECTOR_INT8) {
+                this->append_field_data<Int8Vector>(field.get_dim(), size_per_chunk);
+                continue;
             } else {
                 PanicInfo("unsupported");
             }
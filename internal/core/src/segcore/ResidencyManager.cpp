@@ -0,0 +1,203 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/ResidencyManager.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+constexpr const char* DEFAULT_SPILL_PATH = "/tmp/milvus/residency";
+
+static void
+CreateDirectories(const std::string& path) {
+    for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+        auto dir = path.substr(0, pos);
+        AssertInfo(mkdir(dir.c_str(), 0755) == 0 || errno == EEXIST, "failed to create directory " + dir);
+        if (pos == std::string::npos) {
+            break;
+        }
+    }
+}
+
+ResidentSlot::~ResidentSlot() {
+    if (!resident_) {
+        ResidencyManager::GetInstance().Erase(key_);
+        std::remove(spill_file_.c_str());
+    }
+}
+
+ResidentDataPtr
+ResidentSlot::Pin() {
+    if (resident_) {
+        return resident_;
+    }
+    auto& manager = ResidencyManager::GetInstance();
+    if (auto data = manager.Get(key_)) {
+        return data;
+    }
+
+    std::lock_guard lck(mutex_);
+    // evicted but still pinned by a running query, or reloaded by another thread meanwhile
+    auto data = weak_.lock();
+    if (!data) {
+        data = loader_(spill_file_);
+        AssertInfo(data, "failed to reload " + key_);
+        manager.reloads_++;
+        weak_ = data;
+    }
+    manager.Insert(key_, data);
+    return data;
+}
+
+ResidencyManager&
+ResidencyManager::GetInstance() {
+    static ResidencyManager manager;
+    return manager;
+}
+
+ResidencyManager::ResidencyManager() : spill_path_(DEFAULT_SPILL_PATH) {
+    // one shard: evictions follow the CLOCK order of all segments instead of going round-robin over shards
+    cache_ = std::make_unique<cache::Cache<cache::DataObjPtr>>(std::numeric_limits<int64_t>::max(), 1UL << 32,
+                                                                "[RESIDENCY]", cache::CachePolicyType::CLOCK, 1);
+    // evict only down to the budget, each item is large and reloading it is expensive
+    cache_->set_freemem_percent(1.0);
+}
+
+void
+ResidencyManager::SetBudget(int64_t budget) {
+    AssertInfo(budget >= 0, "residency budget must not be negative");
+    budget_ = budget;
+    cache_->set_capacity(budget > 0 ? budget : std::numeric_limits<int64_t>::max());
+}
+
+void
+ResidencyManager::SetSpillPath(const std::string& spill_path) {
+    std::lock_guard lck(spill_path_mutex_);
+    spill_path_ = spill_path;
+}
+
+std::string
+ResidencyManager::NextName(const std::string& prefix) {
+    return prefix + "_" + std::to_string(next_id_++);
+}
+
+std::string
+ResidencyManager::SpillFile(const std::string& name) {
+    std::lock_guard lck(spill_path_mutex_);
+    CreateDirectories(spill_path_);
+    // the pid keeps processes sharing a spill path apart
+    return spill_path_ + "/" + std::to_string(getpid()) + "_" + name;
+}
+
+ResidentSlotPtr
+ResidencyManager::Register(const std::string& name,
+                           ResidentDataPtr data,
+                           const ResidentSaver& saver,
+                           ResidentLoader loader) {
+    Assert(data);
+    auto slot = ResidentSlotPtr(new ResidentSlot());
+    slot->key_ = name;
+    if (budget() == 0 || !saver) {
+        slot->resident_ = std::move(data);
+        return slot;
+    }
+
+    slot->spill_file_ = SpillFile(name);
+    saver(slot->spill_file_);
+    slot->loader_ = std::move(loader);
+    slot->weak_ = data;
+    Insert(name, data);
+    return slot;
+}
+
+ResidencyStatistics
+ResidencyManager::GetStatistics() const {
+    auto cache_statistics = cache_->statistics();
+    ResidencyStatistics statistics;
+    statistics.budget = budget();
+    statistics.usage = cache_->usage();
+    statistics.hits = cache_statistics.hits;
+    statistics.misses = cache_statistics.misses;
+    statistics.evictions = cache_statistics.evictions;
+    statistics.reloads = reloads_.load();
+    return statistics;
+}
+
+ResidentDataPtr
+ResidencyManager::Get(const std::string& key) {
+    return std::static_pointer_cast<ResidentData>(cache_->get(key));
+}
+
+void
+ResidencyManager::Insert(const std::string& key, const ResidentDataPtr& data) {
+    cache_->insert(key, data);
+}
+
+void
+ResidencyManager::Erase(const std::string& key) {
+    cache_->erase(key);
+}
+
+int64_t
+GetSpillFileSize(const std::string& file) {
+    struct stat file_stat;
+    AssertInfo(stat(file.c_str(), &file_stat) == 0, "failed to stat spill file " + file);
+    return file_stat.st_size;
+}
+
+void
+WriteBinarySet(const std::string& file, const knowhere::BinarySet& binary_set) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    AssertInfo(out.good(), "failed to open spill file " + file);
+    int64_t count = binary_set.binary_map_.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (auto& [name, binary] : binary_set.binary_map_) {
+        int64_t name_size = name.size();
+        out.write(reinterpret_cast<const char*>(&name_size), sizeof(name_size));
+        out.write(name.data(), name_size);
+        out.write(reinterpret_cast<const char*>(&binary->size), sizeof(binary->size));
+        out.write(reinterpret_cast<const char*>(binary->data.get()), binary->size);
+    }
+    AssertInfo(out.good(), "failed to write spill file " + file);
+}
+
+knowhere::BinarySet
+ReadBinarySet(const std::string& file) {
+    std::ifstream in(file, std::ios::binary);
+    AssertInfo(in.good(), "failed to open spill file " + file);
+    knowhere::BinarySet binary_set;
+    int64_t count = 0;
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    for (int64_t i = 0; i < count; ++i) {
+        int64_t name_size = 0;
+        in.read(reinterpret_cast<char*>(&name_size), sizeof(name_size));
+        std::string name(name_size, '\0');
+        in.read(name.data(), name_size);
+        int64_t size = 0;
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::shared_ptr<uint8_t[]> data(new uint8_t[size]);
+        in.read(reinterpret_cast<char*>(data.get()), size);
+        binary_set.Append(name, data, size);
+    }
+    AssertInfo(in.good(), "failed to read spill file " + file);
+    return binary_set;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,149 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cache/Cache.h"
+#include "cache/DataObj.h"
+#include "common/Types.h"
+#include "knowhere/common/BinarySet.h"
+#include "knowhere/index/Index.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus::segcore {
+
+// what a sealed segment holds for one field: the raw column with its scalar index, or the vector index
+struct ResidentData : public cache::DataObj {
+    aligned_vector<char> column_;
+    std::unique_ptr<knowhere::Index> scalar_index_;
+    knowhere::VecIndexPtr vec_index_;
+    int64_t size_ = 0;
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+};
+
+using ResidentDataPtr = std::shared_ptr<ResidentData>;
+// writes the data to the spill file, and reads it back after an eviction
+using ResidentSaver = std::function<void(const std::string& spill_file)>;
+using ResidentLoader = std::function<ResidentDataPtr(const std::string& spill_file)>;
+
+struct ResidencyStatistics {
+    int64_t budget = 0;
+    int64_t usage = 0;
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+    // misses that found the data released and read it back from its spill file
+    int64_t reloads = 0;
+};
+
+// one piece of a sealed segment registered with the ResidencyManager
+class ResidentSlot {
+ public:
+    ~ResidentSlot();
+
+    // the data, read back from the spill file if it was evicted. a reload only blocks the pins of this slot.
+    // the data stays in memory while the returned pointer lives, even if the manager evicts it meanwhile.
+    ResidentDataPtr
+    Pin();
+
+ private:
+    friend class ResidencyManager;
+    ResidentSlot() = default;
+
+ private:
+    std::string key_;
+    std::string spill_file_;
+    ResidentLoader loader_;
+    // set when the data can't be evicted: no budget, or nothing to reload it from
+    ResidentDataPtr resident_;
+    std::weak_ptr<ResidentData> weak_;
+    std::mutex mutex_;
+};
+
+using ResidentSlotPtr = std::unique_ptr<ResidentSlot>;
+
+// keeps the indexes and columns of all sealed segments within a memory budget. data beyond the budget is
+// evicted in CLOCK order and reloaded from a local spill file on its next access.
+class ResidencyManager {
+ public:
+    static ResidencyManager&
+    GetInstance();
+
+    // budget in bytes, 0 keeps everything resident. only applies to data registered afterwards.
+    void
+    SetBudget(int64_t budget);
+
+    void
+    SetSpillPath(const std::string& spill_path);
+
+    int64_t
+    budget() const {
+        return budget_.load();
+    }
+
+    // hands the data of a segment field over. with a budget, the saver writes it to a spill file and the
+    // data becomes evictable, a null saver keeps it resident.
+    ResidentSlotPtr
+    Register(const std::string& name, ResidentDataPtr data, const ResidentSaver& saver, ResidentLoader loader);
+
+    // unique name for the slots of one segment or for a spill file
+    std::string
+    NextName(const std::string& prefix);
+
+    // local file to spill the data of a slot name into
+    std::string
+    SpillFile(const std::string& name);
+
+    ResidencyStatistics
+    GetStatistics() const;
+
+ private:
+    ResidencyManager();
+
+    ResidentDataPtr
+    Get(const std::string& key);
+
+    void
+    Insert(const std::string& key, const ResidentDataPtr& data);
+
+    void
+    Erase(const std::string& key);
+
+ private:
+    friend class ResidentSlot;
+    std::atomic<int64_t> budget_{0};
+    std::string spill_path_;
+    std::mutex spill_path_mutex_;
+    std::atomic<int64_t> next_id_{0};
+    std::atomic<int64_t> reloads_{0};
+    std::unique_ptr<cache::Cache<cache::DataObjPtr>> cache_;
+};
+
+int64_t
+GetSpillFileSize(const std::string& file);
+
+// spill file format of vector indexes
+void
+WriteBinarySet(const std::string& file, const knowhere::BinarySet& binary_set);
+
+knowhere::BinarySet
+ReadBinarySet(const std::string& file);
+
+}  // namespace milvus::segcore
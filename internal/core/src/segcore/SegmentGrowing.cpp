@@ -20,8 +20,10 @@ TestABI() {
 }
 
 std::unique_ptr<SegmentGrowing>
-CreateGrowingSegment(SchemaPtr schema, const SegcoreConfig& segcore_config) {
-    auto segment = std::make_unique<SegmentGrowingImpl>(schema, segcore_config);
+CreateGrowingSegment(SchemaPtr schema,
+                     const SegcoreConfig& segcore_config,
+                     CoarseQuantizerPoolPtr coarse_quantizer_pool) {
+    auto segment = std::make_unique<SegmentGrowingImpl>(schema, segcore_config, std::move(coarse_quantizer_pool));
     return segment;
 }
 
@@ -20,6 +20,7 @@
 #include "query/Plan.h"
 #include "common/LoadInfo.h"
 #include "segcore/SegmentInterface.h"
+#include "segcore/CoarseQuantizer.h"
 
 namespace milvus {
 namespace segcore {
@@ -95,12 +96,14 @@ class SegmentGrowing : public SegmentInternalInterface {
 using SegmentGrowingPtr = std::unique_ptr<SegmentGrowing>;
 
 SegmentGrowingPtr
-CreateGrowingSegment(SchemaPtr schema, const SegcoreConfig& segcore_config);
+CreateGrowingSegment(SchemaPtr schema,
+                     const SegcoreConfig& segcore_config,
+                     CoarseQuantizerPoolPtr coarse_quantizer_pool = nullptr);
 
 inline SegmentGrowingPtr
-CreateGrowingSegment(SchemaPtr schema) {
+CreateGrowingSegment(SchemaPtr schema, CoarseQuantizerPoolPtr coarse_quantizer_pool = nullptr) {
     auto seg_conf = SegcoreConfig::default_config();
-    return CreateGrowingSegment(schema, seg_conf);
+    return CreateGrowingSegment(schema, seg_conf, std::move(coarse_quantizer_pool));
 }
 
 }  // namespace segcore
@@ -286,6 +286,30 @@ SegmentGrowingImpl::vector_search(int64_t vec_count,
         SearchOnGrowing(*this, vec_count, query_info, query_data, query_count, bitset, output);
     }
 }
+query::VectorSearchCostInfo
+SegmentGrowingImpl::get_vector_search_cost_info(const query::QueryInfo& query_info) const {
+    auto field_offset = query_info.field_offset_;
+    query::VectorSearchCostInfo cost_info;
+    auto& sealed_indexing = this->get_sealed_indexing_record();
+    if (sealed_indexing.is_ready(field_offset)) {
+        auto& indexing = *sealed_indexing.get_field_indexing(field_offset)->indexing_;
+        cost_info.index_type = indexing.index_type();
+        cost_info.search_params = query_info.search_params_;
+        cost_info.nlist = query::GetIndexNlist(indexing);
+        return cost_info;
+    }
+
+    cost_info.raw_data_available = true;
+    if (indexing_record_.is_in(field_offset) && indexing_record_.get_finished_ack() > 0) {
+        auto& field_indexing = indexing_record_.get_vec_field_indexing(field_offset);
+        auto& chunk_indexing = *field_indexing.get_chunk_indexing(0);
+        cost_info.index_type = chunk_indexing.index_type();
+        cost_info.search_params = field_indexing.get_search_params(query_info.topK_);
+        cost_info.nlist = query::GetIndexNlist(chunk_indexing);
+    }
+    return cost_info;
+}
+
 void
 SegmentGrowingImpl::bulk_subscript(FieldOffset field_offset,
                                    const int64_t* seg_offsets,
@@ -299,6 +323,8 @@ SegmentGrowingImpl::bulk_subscript(FieldOffset field_offset,
             bulk_subscript_impl<FloatVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output);
         } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
             bulk_subscript_impl<BinaryVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output);
+        } else if (field_meta.get_data_type() == DataType::VECTOR_INT8) {
+            bulk_subscript_impl<Int8Vector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output);
         } else {
             PanicInfo("logical error");
         }
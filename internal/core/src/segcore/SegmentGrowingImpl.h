@@ -157,13 +157,17 @@ class SegmentGrowingImpl : public SegmentGrowing {
 
  public:
     friend std::unique_ptr<SegmentGrowing>
-    CreateGrowingSegment(SchemaPtr schema, const SegcoreConfig& segcore_config);
+    CreateGrowingSegment(SchemaPtr schema,
+                         const SegcoreConfig& segcore_config,
+                         CoarseQuantizerPoolPtr coarse_quantizer_pool);
 
-    explicit SegmentGrowingImpl(SchemaPtr schema, const SegcoreConfig& segcore_config)
+    explicit SegmentGrowingImpl(SchemaPtr schema,
+                                const SegcoreConfig& segcore_config,
+                                CoarseQuantizerPoolPtr coarse_quantizer_pool = nullptr)
         : segcore_config_(segcore_config),
           schema_(std::move(schema)),
           record_(*schema_, segcore_config.get_size_per_chunk()),
-          indexing_record_(*schema_, segcore_config_) {
+          indexing_record_(*schema_, segcore_config_, std::move(coarse_quantizer_pool)) {
     }
 
     void
@@ -174,6 +178,15 @@ class SegmentGrowingImpl : public SegmentGrowing {
                   const BitsetView& bitset,
                   QueryResult& output) const override;
 
+    query::VectorSearchCostInfo
+    get_vector_search_cost_info(const query::QueryInfo& query_info) const override;
+
+    // not maintained while chunks are still growing
+    const query::VectorBoundingBall*
+    get_vector_bounding_ball(FieldOffset field_offset) const override {
+        return nullptr;
+    }
+
  public:
     std::shared_ptr<DeletedRecord::TmpBitmap>
     get_deleted_bitmap(int64_t del_barrier, Timestamp query_timestamp, int64_t insert_barrier, bool force = false);
@@ -11,13 +11,14 @@
 
 #include "segcore/SegmentInterface.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
+#include "query/SubQueryResult.h"
 namespace milvus::segcore {
 class Naive;
 
 void
 SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, QueryResult& results) const {
-    std::shared_lock lck(mutex_);
     AssertInfo(plan, "empty plan");
+    auto pinned = pin(plan);
     auto size = results.result_distances_.size();
     Assert(results.internal_seg_offsets_.size() == size);
     // Assert(results.result_offsets_.size() == size);
@@ -75,13 +76,43 @@ QueryResult
 SegmentInternalInterface::Search(const query::Plan* plan,
                                  const query::PlaceholderGroup** placeholder_groups,
                                  const Timestamp* timestamps,
-                                 int64_t num_groups) const {
-    std::shared_lock lck(mutex_);
+                                 int64_t num_groups,
+                                 query::SearchBound* search_bound) const {
+    auto pinned = pin(plan);
     check_search(plan);
     Assert(num_groups == 1);
-    query::ExecPlanNodeVisitor visitor(*this, timestamps[0], *placeholder_groups[0]);
+    query::ExecPlanNodeVisitor visitor(*this, timestamps[0], *placeholder_groups[0], search_bound);
     auto results = visitor.get_moved_result(*plan->plan_node_);
     return results;
 }
 
+std::optional<float>
+SegmentInternalInterface::GetBestPossibleDistance(const query::Plan* plan,
+                                                  const query::PlaceholderGroup& placeholder_group) const {
+    AssertInfo(plan, "empty plan");
+    auto pinned = pin(nullptr);
+    auto node = dynamic_cast<const query::FloatVectorANNS*>(plan->plan_node_.get());
+    if (!node) {
+        return std::nullopt;
+    }
+    auto& query_info = node->query_info_;
+    auto ball = get_vector_bounding_ball(query_info.field_offset_);
+    if (!ball) {
+        return std::nullopt;
+    }
+    Assert(placeholder_group.size() == 1);
+    auto& ph = placeholder_group.at(0);
+    auto query_data = ph.get_blob<float>();
+    auto dim = ball->centroid_.size();
+    auto is_desc = query::SubQueryResult::is_descending(query_info.metric_type_);
+    std::optional<float> best;
+    for (int64_t i = 0; i < ph.num_of_queries_; ++i) {
+        auto distance = ball->best_distance(query_data + i * dim, query_info.metric_type_);
+        if (!best.has_value() || (is_desc ? distance > best.value() : distance < best.value())) {
+            best = distance;
+        }
+    }
+    return best;
+}
+
 }  // namespace milvus::segcore
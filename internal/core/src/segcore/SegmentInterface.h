@@ -18,6 +18,8 @@
 #include <knowhere/index/vector_index/VecIndex.h>
 #include "common/SystemProperty.h"
 #include "query/PlanNode.h"
+#include "query/SearchStrategy.h"
+#include "query/SearchBound.h"
 
 namespace milvus::segcore {
 
@@ -29,11 +31,18 @@ class SegmentInterface {
     virtual void
     FillTargetEntry(const query::Plan* plan, QueryResult& results) const = 0;
 
+    // with search_bound, hits worse than the topk already found in other segments are dropped
     virtual QueryResult
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_groups[],
            const Timestamp timestamps[],
-           int64_t num_groups) const = 0;
+           int64_t num_groups,
+           query::SearchBound* search_bound = nullptr) const = 0;
+
+    // best distance the queries can reach in the segment, for searching promising segments first,
+    // nullopt when it's not known
+    virtual std::optional<float>
+    GetBestPossibleDistance(const query::Plan* plan, const query::PlaceholderGroup& placeholder_group) const = 0;
 
     virtual int64_t
     GetMemoryUsageInBytes() const = 0;
@@ -74,7 +83,11 @@ class SegmentInternalInterface : public SegmentInterface {
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_groups[],
            const Timestamp timestamps[],
-           int64_t num_groups) const override;
+           int64_t num_groups,
+           query::SearchBound* search_bound = nullptr) const override;
+
+    std::optional<float>
+    GetBestPossibleDistance(const query::Plan* plan, const query::PlaceholderGroup& placeholder_group) const override;
 
     void
     FillTargetEntry(const query::Plan* plan, QueryResult& results) const override;
@@ -88,6 +101,14 @@ class SegmentInternalInterface : public SegmentInterface {
                   const BitsetView& bitset,
                   QueryResult& output) const = 0;
 
+    // index and raw data available for searching a vector field, used to choose the search strategy
+    virtual query::VectorSearchCostInfo
+    get_vector_search_cost_info(const query::QueryInfo& query_info) const = 0;
+
+    // bounding ball of the vectors of a field, nullptr when not available
+    virtual const query::VectorBoundingBall*
+    get_vector_bounding_ball(FieldOffset field_offset) const = 0;
+
     // count of chunk that has index available
     virtual int64_t
     num_chunk_index(FieldOffset field_offset) const = 0;
@@ -120,8 +141,13 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual void
     check_search(const query::Plan* plan) const = 0;
 
- protected:
-    mutable std::shared_mutex mutex_;
+    // keeps what the plan reads alive and unchanged while the returned handle lives, for segments that may
+    // swap or evict it. the handle must be released on the thread that took it, without a plan it only
+    // keeps the segment state.
+    virtual std::shared_ptr<void>
+    pin(const query::Plan* plan) const {
+        return nullptr;
+    }
 };
 
 }  // namespace milvus::segcore
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "SegmentInterface.h"
+#include "IndexLoader.h"
 #include "common/LoadInfo.h"
 
 namespace milvus::segcore {
@@ -20,6 +21,10 @@ class SegmentSealed : public SegmentInternalInterface {
  public:
     virtual void
     LoadIndex(const LoadIndexInfo& info) = 0;
+    // deserializes and warms up the index in the background, then swaps it in, replacing any index
+    // of the field. searches keep running meanwhile, on the old index or on the raw data.
+    virtual LoadIndexFuturePtr
+    LoadIndexAsync(const LoadIndexInfo& info, knowhere::BinarySet binary_set) = 0;
     virtual void
     LoadFieldData(const LoadFieldDataInfo& info) = 0;
     virtual void
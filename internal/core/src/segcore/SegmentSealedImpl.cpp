@@ -13,6 +13,11 @@
 #include "query/SearchOnSealed.h"
 #include "query/ScalarIndex.h"
 #include "query/SearchBruteForce.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
 namespace milvus::segcore {
 
 static inline void
@@ -25,9 +30,80 @@ get_bit(const boost::dynamic_bitset<>& bitset, FieldOffset field_offset) {
     return bitset[field_offset.get()];
 }
 
+static void
+WriteColumn(const std::string& file, const aligned_vector<char>& column) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    AssertInfo(out.good(), "failed to open spill file " + file);
+    out.write(column.data(), column.size());
+    AssertInfo(out.good(), "failed to write spill file " + file);
+}
+
+static aligned_vector<char>
+ReadColumn(const std::string& file) {
+    aligned_vector<char> column(GetSpillFileSize(file));
+    std::ifstream in(file, std::ios::binary);
+    AssertInfo(in.good(), "failed to open spill file " + file);
+    in.read(column.data(), column.size());
+    AssertInfo(in.good(), "failed to read spill file " + file);
+    return column;
+}
+
+// a scalar index holds a sorted copy of the values along with their offsets
+static int64_t
+EstimateColumnSize(const FieldMeta& field_meta, int64_t row_count) {
+    auto size = field_meta.get_sizeof() * row_count;
+    if (!field_meta.is_vector()) {
+        size += (field_meta.get_sizeof() + sizeof(size_t)) * row_count;
+    }
+    return size;
+}
+
+static std::string
+SlotName(const std::string& segment_name, FieldOffset field_offset, const char* kind) {
+    return segment_name + "_field_" + std::to_string(field_offset.get()) + "_" + kind;
+}
+
 void
 SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
-    // NOTE: lock only when data is ready to avoid starvation
+    load_index(info, false);
+}
+
+LoadIndexFuturePtr
+SegmentSealedImpl::LoadIndexAsync(const LoadIndexInfo& info, knowhere::BinarySet binary_set) {
+    auto future = std::make_shared<LoadIndexFuture>();
+    {
+        std::lock_guard lck(pending_loads_mutex_);
+        ++pending_loads_;
+    }
+    std::thread([this, load_info = info, binary_set = std::move(binary_set), future]() mutable {
+        try {
+            future->set_stage(LoadIndexStage::DESERIALIZING);
+            load_info.index = LoadVecIndex(load_info.index_params, binary_set);
+            load_info.index_file = KeepIndexFile(binary_set);
+            binary_set = knowhere::BinarySet();
+
+            future->set_stage(LoadIndexStage::WARMING_UP);
+            WarmUpVecIndex(*load_info.index);
+
+            future->set_stage(LoadIndexStage::SWAPPING);
+            load_index(load_info, true);
+            future->set_stage(LoadIndexStage::DONE);
+        } catch (std::exception& e) {
+            if (!load_info.index_file.empty()) {
+                std::remove(load_info.index_file.c_str());
+            }
+            future->set_failed(e.what());
+        }
+        std::lock_guard lck(pending_loads_mutex_);
+        --pending_loads_;
+        pending_loads_cond_.notify_all();
+    }).detach();
+    return future;
+}
+
+void
+SegmentSealedImpl::load_index(const LoadIndexInfo& info, bool replace) {
+    // NOTE: publish only when data is ready, searches never wait for a load
     auto field_id = FieldId(info.field_id);
     auto field_offset = schema_->get_offset(field_id);
 
@@ -35,24 +111,48 @@ SegmentSealedImpl::LoadIndex(const LoadIndexInfo& info) {
     auto metric_type_str = info.index_params.at("metric_type");
     auto row_count = info.index->Count();
     Assert(row_count > 0);
-
-    std::unique_lock lck(mutex_);
-    Assert(!get_bit(vecindex_ready_bitset_, field_offset));
-    if (row_count_opt_.has_value()) {
-        AssertInfo(row_count_opt_.value() == row_count, "load data has different row count from other columns");
-    } else {
-        row_count_opt_ = row_count;
+    AssertInfo(replace || !snapshot()->index_slots_[field_offset.get()], "index already exists");
+
+    // the index can only be evicted when the loader kept a copy of its binaries
+    auto data = std::make_shared<ResidentData>();
+    data->vec_index_ = info.index;
+    ResidentSaver saver;
+    if (!info.index_file.empty()) {
+        data->size_ = GetSpillFileSize(info.index_file);
+        saver = [&](const std::string& spill_file) {
+            AssertInfo(std::rename(info.index_file.c_str(), spill_file.c_str()) == 0,
+                       "failed to move index file " + info.index_file);
+        };
     }
-    Assert(!vecindexs_.is_ready(field_offset));
-    vecindexs_.append_field_indexing(field_offset, GetMetricType(metric_type_str), info.index);
-
-    set_bit(vecindex_ready_bitset_, field_offset, true);
-    lck.unlock();
+    auto index_type = info.index->index_type();
+    auto index_mode = info.index->index_mode();
+    auto loader = [index_type, index_mode](const std::string& spill_file) {
+        auto binary_set = ReadBinarySet(spill_file);
+        auto data = std::make_shared<ResidentData>();
+        data->vec_index_ = knowhere::VecIndexFactory::GetInstance().CreateVecIndex(index_type, index_mode);
+        data->vec_index_->Load(binary_set);
+        data->size_ = GetSpillFileSize(spill_file);
+        return data;
+    };
+    // a replaced index keeps its slot until its last search is done, slot names must not collide
+    auto& residency_manager = ResidencyManager::GetInstance();
+    auto index_slot = std::make_shared<IndexSlot>();
+    index_slot->slot_ = residency_manager.Register(
+        residency_manager.NextName(SlotName(residency_name_, field_offset, "index")), std::move(data), saver,
+        std::move(loader));
+    index_slot->metric_type_ = GetMetricType(metric_type_str);
+
+    update_snapshot([&](Snapshot& snapshot) {
+        update_row_count(snapshot, row_count);
+        auto& current = snapshot.index_slots_[field_offset.get()];
+        AssertInfo(replace || !current, "index already exists");
+        current = std::move(index_slot);
+    });
 }
 
 void
 SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
-    // NOTE: lock only when data is ready to avoid starvation
+    // NOTE: publish only when data is ready, searches never wait for a load
     Assert(info.row_count > 0);
     auto field_id = FieldId(info.field_id);
     Assert(info.blob);
@@ -66,12 +166,12 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         aligned_vector<idx_t> vec_data(info.row_count);
         std::copy_n(src_ptr, info.row_count, vec_data.data());
 
-        // write data under lock
-        std::unique_lock lck(mutex_);
-        update_row_count(info.row_count);
-        AssertInfo(row_ids_.empty(), "already exists");
-        row_ids_ = std::move(vec_data);
-        ++system_ready_count_;
+        auto row_ids = std::make_shared<const aligned_vector<idx_t>>(std::move(vec_data));
+        update_snapshot([&](Snapshot& snapshot) {
+            update_row_count(snapshot, info.row_count);
+            AssertInfo(!snapshot.row_ids_, "already exists");
+            snapshot.row_ids_ = std::move(row_ids);
+        });
 
     } else {
         // prepare data
@@ -89,22 +189,43 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         if (!field_meta.is_vector()) {
             index = query::generate_scalar_index(span, field_meta.get_data_type());
         }
-
-        // write data under lock
-        std::unique_lock lck(mutex_);
-        update_row_count(info.row_count);
-        AssertInfo(field_datas_[field_offset.get()].empty(), "field data already exists");
-
-        if (field_meta.is_vector()) {
-            AssertInfo(!vecindexs_.is_ready(field_offset), "field data can't be loaded when indexing exists");
-            field_datas_[field_offset.get()] = std::move(vec_data);
-        } else {
-            AssertInfo(!scalar_indexings_[field_offset.get()], "scalar indexing not cleared");
-            field_datas_[field_offset.get()] = std::move(vec_data);
-            scalar_indexings_[field_offset.get()] = std::move(index);
+        std::shared_ptr<const query::VectorBoundingBall> ball;
+        if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+            ball = std::make_shared<const query::VectorBoundingBall>(query::ComputeBoundingBall(
+                reinterpret_cast<const float*>(vec_data.data()), field_meta.get_dim(), info.row_count));
         }
 
-        set_bit(field_data_ready_bitset_, field_offset, true);
+        AssertInfo(!snapshot()->column_slots_[field_offset.get()], "field data already exists");
+        // raw vectors may be kept along with the index, for refine and brute force
+        auto data = std::make_shared<ResidentData>();
+        data->column_ = std::move(vec_data);
+        data->scalar_index_ = std::move(index);
+        data->size_ = EstimateColumnSize(field_meta, info.row_count);
+        auto saver = [&](const std::string& spill_file) { WriteColumn(spill_file, data->column_); };
+        auto loader = [schema = schema_, field_offset, row_count = info.row_count](const std::string& spill_file) {
+            auto& field_meta = schema->operator[](field_offset);
+            auto data = std::make_shared<ResidentData>();
+            data->column_ = ReadColumn(spill_file);
+            if (!field_meta.is_vector()) {
+                auto span = SpanBase(data->column_.data(), row_count, field_meta.get_sizeof());
+                data->scalar_index_ = query::generate_scalar_index(span, field_meta.get_data_type());
+            }
+            data->size_ = EstimateColumnSize(field_meta, row_count);
+            return data;
+        };
+        auto& residency_manager = ResidencyManager::GetInstance();
+        std::shared_ptr<ResidentSlot> slot = residency_manager.Register(
+            residency_manager.NextName(SlotName(residency_name_, field_offset, "data")), data, saver,
+            std::move(loader));
+        data.reset();
+
+        update_snapshot([&](Snapshot& snapshot) {
+            update_row_count(snapshot, info.row_count);
+            AssertInfo(!snapshot.column_slots_[field_offset.get()], "field data already exists");
+            snapshot.column_slots_[field_offset.get()] = std::move(slot);
+            snapshot.vector_bounding_balls_[field_offset.get()] = std::move(ball);
+            set_bit(snapshot.field_data_ready_bitset_, field_offset, true);
+        });
     }
 }
 
@@ -125,34 +246,98 @@ SegmentSealedImpl::size_per_chunk() const {
 
 SpanBase
 SegmentSealedImpl::chunk_data_impl(FieldOffset field_offset, int64_t chunk_id) const {
-    std::shared_lock lck(mutex_);
-    Assert(get_bit(field_data_ready_bitset_, field_offset));
+    auto snapshot = this->snapshot();
+    Assert(get_bit(snapshot->field_data_ready_bitset_, field_offset));
     auto& field_meta = schema_->operator[](field_offset);
     auto element_sizeof = field_meta.get_sizeof();
-    SpanBase base(field_datas_[field_offset.get()].data(), row_count_opt_.value(), element_sizeof);
+    // pinned by the search that asks for it
+    auto data = snapshot->column_slots_[field_offset.get()]->Pin();
+    SpanBase base(data->column_.data(), snapshot->row_count_opt_.value(), element_sizeof);
     return base;
 }
 
 const knowhere::Index*
 SegmentSealedImpl::chunk_index_impl(FieldOffset field_offset, int64_t chunk_id) const {
     // TODO: support scalar index
-    auto ptr = scalar_indexings_[field_offset.get()].get();
+    auto ptr = snapshot()->column_slots_[field_offset.get()]->Pin()->scalar_index_.get();
     Assert(ptr);
     return ptr;
 }
 
+// makes the snapshot current on the thread until the search is done, then restores what was pinned before
+struct SegmentSealedImpl::SnapshotPin {
+    PinnedSnapshot previous_;
+    std::vector<ResidentDataPtr> resident_;
+
+    ~SnapshotPin() {
+        pinned_snapshot_ = std::move(previous_);
+    }
+};
+
+thread_local SegmentSealedImpl::PinnedSnapshot SegmentSealedImpl::pinned_snapshot_;
+
+SegmentSealedImpl::SnapshotPtr
+SegmentSealedImpl::snapshot() const {
+    if (pinned_snapshot_.segment_ == this) {
+        return pinned_snapshot_.snapshot_;
+    }
+    return std::atomic_load(&snapshot_);
+}
+
+void
+SegmentSealedImpl::update_snapshot(const std::function<void(Snapshot&)>& update) {
+    // declared first, so a replaced snapshot is released after the lock
+    SnapshotPtr current;
+    std::lock_guard lck(update_mutex_);
+    current = std::atomic_load(&snapshot_);
+    auto next = std::make_shared<Snapshot>(*current);
+    update(*next);
+    current = std::atomic_exchange(&snapshot_, SnapshotPtr(std::move(next)));
+}
+
+std::shared_ptr<void>
+SegmentSealedImpl::pin(const query::Plan* plan) const {
+    auto snapshot = this->snapshot();
+    auto pinned = std::make_shared<SnapshotPin>();
+    auto pin_field = [&](FieldOffset field_offset) {
+        if (auto& slot = snapshot->column_slots_[field_offset.get()]) {
+            pinned->resident_.emplace_back(slot->Pin());
+        }
+        if (auto& index_slot = snapshot->index_slots_[field_offset.get()]) {
+            pinned->resident_.emplace_back(index_slot->slot_->Pin());
+        }
+    };
+    if (plan != nullptr) {
+        if (plan->extra_info_opt_.has_value()) {
+            auto& involved_fields = plan->extra_info_opt_->involved_fields_;
+            for (auto i = involved_fields.find_first(); i != involved_fields.npos;
+                 i = involved_fields.find_next(i)) {
+                pin_field(FieldOffset(i));
+            }
+        }
+        for (auto field_offset : plan->target_entries_) {
+            pin_field(field_offset);
+        }
+        auto key_offset_opt = schema_->get_primary_key_offset();
+        if (key_offset_opt.has_value()) {
+            pin_field(key_offset_opt.value());
+        }
+    }
+    pinned->previous_ = std::move(pinned_snapshot_);
+    pinned_snapshot_ = PinnedSnapshot{this, std::move(snapshot)};
+    return pinned;
+}
+
 int64_t
 SegmentSealedImpl::GetMemoryUsageInBytes() const {
     // TODO: add estimate for index
-    std::shared_lock lck(mutex_);
-    auto row_count = row_count_opt_.value_or(0);
+    auto row_count = snapshot()->row_count_opt_.value_or(0);
     return schema_->get_total_sizeof() * row_count;
 }
 
 int64_t
 SegmentSealedImpl::get_row_count() const {
-    std::shared_lock lck(mutex_);
-    return row_count_opt_.value_or(0);
+    return snapshot()->row_count_opt_.value_or(0);
 }
 
 const Schema&
@@ -160,6 +345,18 @@ SegmentSealedImpl::get_schema() const {
     return *schema_;
 }
 
+// candidates fetched from the index per topk when they are re-ranked on raw vectors, 1 for no refine
+static int64_t
+GetRefineFactor(const query::QueryInfo& query_info) {
+    auto& search_params = query_info.search_params_;
+    if (!search_params.contains(knowhere::IndexParams::refine_factor)) {
+        return 1;
+    }
+    auto refine_factor = search_params[knowhere::IndexParams::refine_factor].get<int64_t>();
+    AssertInfo(refine_factor >= 1, "refine_factor must be at least 1");
+    return refine_factor;
+}
+
 void
 SegmentSealedImpl::vector_search(int64_t vec_count,
                                  query::QueryInfo query_info,
@@ -171,30 +368,47 @@ SegmentSealedImpl::vector_search(int64_t vec_count,
     auto& field_meta = schema_->operator[](field_offset);
 
     Assert(field_meta.is_vector());
-    if (get_bit(vecindex_ready_bitset_, field_offset)) {
-        Assert(vecindexs_.is_ready(field_offset));
-        query::SearchOnSealed(*schema_, vecindexs_, query_info, query_data, query_count, bitset, output);
-    } else if (get_bit(field_data_ready_bitset_, field_offset)) {
-        query::dataset::QueryDataset dataset;
-        dataset.query_data = query_data;
-        dataset.num_queries = query_count;
-        // if(field_meta.is)
-        dataset.metric_type = query_info.metric_type_;
-        dataset.topk = query_info.topK_;
-        dataset.dim = field_meta.get_dim();
-
-        Assert(get_bit(field_data_ready_bitset_, field_offset));
-        Assert(row_count_opt_.has_value());
-        auto row_count = row_count_opt_.value();
-        auto chunk_data = field_datas_[field_offset.get()].data();
-
-        auto sub_qr = [&] {
-            if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-                return query::FloatSearchBruteForce(dataset, chunk_data, row_count, bitset);
-            } else {
-                return query::BinarySearchBruteForce(dataset, chunk_data, row_count, bitset);
-            }
-        }();
+    auto snapshot = this->snapshot();
+    auto& index_slot = snapshot->index_slots_[field_offset.get()];
+    auto index_ready = index_slot != nullptr;
+    auto field_data_ready = get_bit(snapshot->field_data_ready_bitset_, field_offset);
+    if (!index_ready && !field_data_ready) {
+        PanicInfo("Field Data is not loaded");
+    }
+
+    query::dataset::QueryDataset dataset;
+    dataset.query_data = query_data;
+    dataset.num_queries = query_count;
+    dataset.metric_type = query_info.metric_type_;
+    dataset.topk = query_info.topK_;
+    dataset.dim = field_meta.get_dim();
+    auto column_data = field_data_ready ? snapshot->column_slots_[field_offset.get()]->Pin() : nullptr;
+    auto chunk_data = column_data ? column_data->column_.data() : nullptr;
+
+    auto brute_force_on_passed =
+        field_data_ready && query_info.search_strategy_ == SearchStrategy::BRUTE_FORCE_ON_PASSED;
+    if (index_ready && !brute_force_on_passed) {
+        auto index_data = index_slot->slot_->Pin();
+        SealedIndexingRecord vecindexs;
+        vecindexs.append_field_indexing(field_offset, index_slot->metric_type_, index_data->vec_index_);
+        if (query_info.search_strategy_ == SearchStrategy::WIDENED_INDEX) {
+            auto& indexing = *index_data->vec_index_;
+            query_info.search_params_ = query::WidenSearchParams(query_info.search_params_, query_info.pass_ratio_,
+                                                                 query::GetIndexNlist(indexing));
+        }
+        auto refine_factor = GetRefineFactor(query_info);
+        if (refine_factor == 1 || !field_data_ready || query_info.radius_.has_value() ||
+            field_meta.get_data_type() != DataType::VECTOR_FLOAT) {
+            query::SearchOnSealed(*schema_, vecindexs, query_info, query_data, query_count, bitset, output);
+            return;
+        }
+
+        // two phase search: approximate candidates from the index, exact distances from the raw vectors
+        query_info.topK_ *= refine_factor;
+        QueryResult candidates;
+        query::SearchOnSealed(*schema_, vecindexs, query_info, query_data, query_count, bitset, candidates);
+        auto sub_qr =
+            query::FloatSearchRefine(dataset, chunk_data, candidates.internal_seg_offsets_.data(), query_info.topK_);
 
         QueryResult results;
         results.result_distances_ = std::move(sub_qr.mutable_values());
@@ -203,9 +417,78 @@ SegmentSealedImpl::vector_search(int64_t vec_count,
         results.num_queries_ = dataset.num_queries;
 
         output = std::move(results);
-    } else {
-        PanicInfo("Field Data is not loaded");
+        return;
+    }
+
+    Assert(snapshot->row_count_opt_.has_value());
+    auto row_count = snapshot->row_count_opt_.value();
+
+    if (query_info.radius_.has_value()) {
+        AssertInfo(field_meta.get_data_type() == DataType::VECTOR_FLOAT, "range search only supports float vector");
+        auto sub_qr =
+            query::FloatRangeSearchBruteForce(dataset, query_info.radius_.value(), chunk_data, row_count, bitset);
+        sub_qr.sort_and_limit(query_info.topK_);
+
+        QueryResult results;
+        results.result_distances_ = std::move(sub_qr.mutable_values());
+        results.internal_seg_offsets_ = std::move(sub_qr.mutable_labels());
+        results.result_lims_ = std::move(sub_qr.mutable_lims());
+        results.topK_ = dataset.topk;
+        results.num_queries_ = dataset.num_queries;
+
+        output = std::move(results);
+        return;
     }
+
+    auto sub_qr = [&] {
+        if (brute_force_on_passed) {
+            auto offsets = query::GetPassedOffsets(bitset, row_count);
+            if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+                return query::FloatSearchBruteForce(dataset, chunk_data, offsets.data(), offsets.size());
+            } else if (field_meta.get_data_type() == DataType::VECTOR_INT8) {
+                return query::Int8SearchBruteForce(dataset, chunk_data, offsets.data(), offsets.size());
+            } else {
+                return query::BinarySearchBruteForce(dataset, chunk_data, offsets.data(), offsets.size());
+            }
+        }
+        if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+            return query::FloatSearchBruteForce(dataset, chunk_data, row_count, bitset);
+        } else if (field_meta.get_data_type() == DataType::VECTOR_INT8) {
+            return query::Int8SearchBruteForce(dataset, chunk_data, row_count, bitset);
+        } else {
+            return query::BinarySearchBruteForce(dataset, chunk_data, row_count, bitset);
+        }
+    }();
+
+    QueryResult results;
+    results.result_distances_ = std::move(sub_qr.mutable_values());
+    results.internal_seg_offsets_ = std::move(sub_qr.mutable_labels());
+    results.topK_ = dataset.topk;
+    results.num_queries_ = dataset.num_queries;
+
+    output = std::move(results);
+}
+
+const query::VectorBoundingBall*
+SegmentSealedImpl::get_vector_bounding_ball(FieldOffset field_offset) const {
+    // owned by the snapshot the caller pinned
+    return snapshot()->vector_bounding_balls_[field_offset.get()].get();
+}
+
+query::VectorSearchCostInfo
+SegmentSealedImpl::get_vector_search_cost_info(const query::QueryInfo& query_info) const {
+    auto field_offset = query_info.field_offset_;
+    query::VectorSearchCostInfo cost_info;
+    auto snapshot = this->snapshot();
+    if (auto& index_slot = snapshot->index_slots_[field_offset.get()]) {
+        auto index_data = index_slot->slot_->Pin();
+        auto& indexing = *index_data->vec_index_;
+        cost_info.index_type = indexing.index_type();
+        cost_info.search_params = query_info.search_params_;
+        cost_info.nlist = query::GetIndexNlist(indexing);
+    }
+    cost_info.raw_data_available = get_bit(snapshot->field_data_ready_bitset_, field_offset);
+    return cost_info;
 }
 
 void
@@ -214,22 +497,16 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
         auto system_field_type = SystemProperty::Instance().GetSystemFieldType(field_id);
         Assert(system_field_type == SystemFieldType::RowId);
 
-        std::unique_lock lck(mutex_);
-        --system_ready_count_;
-        auto row_ids = std::move(row_ids_);
-        lck.unlock();
-
-        row_ids.clear();
+        update_snapshot([&](Snapshot& snapshot) { snapshot.row_ids_.reset(); });
     } else {
         auto field_offset = schema_->get_offset(field_id);
         auto& field_meta = schema_->operator[](field_offset);
 
-        std::unique_lock lck(mutex_);
-        set_bit(field_data_ready_bitset_, field_offset, false);
-        auto vec = std::move(field_datas_[field_offset.get()]);
-        lck.unlock();
-
-        vec.clear();
+        update_snapshot([&](Snapshot& snapshot) {
+            set_bit(snapshot.field_data_ready_bitset_, field_offset, false);
+            snapshot.column_slots_[field_offset.get()].reset();
+            snapshot.vector_bounding_balls_[field_offset.get()].reset();
+        });
     }
 }
 
@@ -240,9 +517,7 @@ SegmentSealedImpl::DropIndex(const FieldId field_id) {
     auto& field_meta = schema_->operator[](field_offset);
     Assert(field_meta.is_vector());
 
-    std::unique_lock lck(mutex_);
-    vecindexs_.drop_field_indexing(field_offset);
-    set_bit(vecindex_ready_bitset_, field_offset, false);
+    update_snapshot([&](Snapshot& snapshot) { snapshot.index_slots_[field_offset.get()].reset(); });
 }
 
 void
@@ -255,7 +530,13 @@ SegmentSealedImpl::check_search(const query::Plan* plan) const {
     }
 
     auto& request_fields = plan->extra_info_opt_.value().involved_fields_;
-    auto field_ready_bitset = field_data_ready_bitset_ | vecindex_ready_bitset_;
+    auto snapshot = this->snapshot();
+    auto field_ready_bitset = snapshot->field_data_ready_bitset_;
+    for (int64_t i = 0; i < schema_->size(); ++i) {
+        if (snapshot->index_slots_[i]) {
+            field_ready_bitset.set(i);
+        }
+    }
     Assert(request_fields.size() == field_ready_bitset.size());
     auto absent_fields = request_fields - field_ready_bitset;
 
@@ -267,20 +548,29 @@ SegmentSealedImpl::check_search(const query::Plan* plan) const {
 }
 
 SegmentSealedImpl::SegmentSealedImpl(SchemaPtr schema)
-    : schema_(schema),
-      field_datas_(schema->size()),
-      field_data_ready_bitset_(schema->size()),
-      vecindex_ready_bitset_(schema->size()),
-      scalar_indexings_(schema->size()) {
+    : schema_(schema), residency_name_(ResidencyManager::GetInstance().NextName("segment")) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->field_data_ready_bitset_.resize(schema->size());
+    snapshot->column_slots_.resize(schema->size());
+    snapshot->index_slots_.resize(schema->size());
+    snapshot->vector_bounding_balls_.resize(schema->size());
+    snapshot_ = std::move(snapshot);
 }
+
+SegmentSealedImpl::~SegmentSealedImpl() {
+    std::unique_lock lck(pending_loads_mutex_);
+    pending_loads_cond_.wait(lck, [&] { return pending_loads_ == 0; });
+}
+
 void
 SegmentSealedImpl::bulk_subscript(SystemFieldType system_type,
                                   const int64_t* seg_offsets,
                                   int64_t count,
                                   void* output) const {
-    Assert(is_system_field_ready());
+    auto row_ids = snapshot()->row_ids_;
+    Assert(row_ids != nullptr);
     Assert(system_type == SystemFieldType::RowId);
-    bulk_subscript_impl<int64_t>(row_ids_.data(), seg_offsets, count, output);
+    bulk_subscript_impl<int64_t>(row_ids->data(), seg_offsets, count, output);
 }
 template <typename T>
 void
@@ -319,9 +609,11 @@ SegmentSealedImpl::bulk_subscript(FieldOffset field_offset,
                                   const int64_t* seg_offsets,
                                   int64_t count,
                                   void* output) const {
-    Assert(get_bit(field_data_ready_bitset_, field_offset));
+    auto snapshot = this->snapshot();
+    Assert(get_bit(snapshot->field_data_ready_bitset_, field_offset));
     auto& field_meta = schema_->operator[](field_offset);
-    auto src_vec = field_datas_[field_offset.get()].data();
+    auto data = snapshot->column_slots_[field_offset.get()]->Pin();
+    auto src_vec = data->column_.data();
     switch (field_meta.get_data_type()) {
         case DataType::BOOL: {
             bulk_subscript_impl<bool>(src_vec, seg_offsets, count, output);
@@ -353,7 +645,8 @@ SegmentSealedImpl::bulk_subscript(FieldOffset field_offset,
         }
 
         case DataType::VECTOR_FLOAT:
-        case DataType::VECTOR_BINARY: {
+        case DataType::VECTOR_BINARY:
+        case DataType::VECTOR_INT8: {
             bulk_subscript_impl(field_meta.get_sizeof(), src_vec, seg_offsets, count, output);
             break;
         }
@@ -366,20 +659,18 @@ SegmentSealedImpl::bulk_subscript(FieldOffset field_offset,
 
 bool
 SegmentSealedImpl::HasIndex(FieldId field_id) const {
-    std::shared_lock lck(mutex_);
     Assert(!SystemProperty::Instance().IsSystem(field_id));
     auto field_offset = schema_->get_offset(field_id);
-    return get_bit(vecindex_ready_bitset_, field_offset);
+    return snapshot()->index_slots_[field_offset.get()] != nullptr;
 }
 
 bool
 SegmentSealedImpl::HasFieldData(FieldId field_id) const {
-    std::shared_lock lck(mutex_);
     if (SystemProperty::Instance().IsSystem(field_id)) {
         return is_system_field_ready();
     } else {
         auto field_offset = schema_->get_offset(field_id);
-        return get_bit(field_data_ready_bitset_, field_offset);
+        return get_bit(snapshot()->field_data_ready_bitset_, field_offset);
     }
 }
 
@@ -12,16 +12,23 @@
 #pragma once
 #include "segcore/SegmentSealed.h"
 #include "SealedIndexingRecord.h"
+#include "ResidencyManager.h"
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 namespace milvus::segcore {
 class SegmentSealedImpl : public SegmentSealed {
  public:
     explicit SegmentSealedImpl(SchemaPtr schema);
+    ~SegmentSealedImpl() override;
     void
     LoadIndex(const LoadIndexInfo& info) override;
+    LoadIndexFuturePtr
+    LoadIndexAsync(const LoadIndexInfo& info, knowhere::BinarySet binary_set) override;
     void
     LoadFieldData(const LoadFieldDataInfo& info) override;
     void
@@ -76,7 +83,58 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     check_search(const query::Plan* plan) const override;
 
+    std::shared_ptr<void>
+    pin(const query::Plan* plan) const override;
+
  private:
+    // the vector index of a field with its metric type, swapped as a whole
+    struct IndexSlot {
+        ResidentSlotPtr slot_;
+        MetricType metric_type_;
+    };
+    using IndexSlotPtr = std::shared_ptr<const IndexSlot>;
+
+    // everything searches read, immutable once published. a writer changes a copy of the current snapshot
+    // and publishes it, the data it replaced is released with the last search still holding the old one.
+    struct Snapshot {
+        std::optional<int64_t> row_count_opt_;
+        boost::dynamic_bitset<> field_data_ready_bitset_;
+        std::shared_ptr<const aligned_vector<idx_t>> row_ids_;
+        // columns with their scalar indexes, and vector indexes, registered with the ResidencyManager
+        std::vector<std::shared_ptr<ResidentSlot>> column_slots_;
+        std::vector<IndexSlotPtr> index_slots_;
+        // of float vector field datas
+        std::vector<std::shared_ptr<const query::VectorBoundingBall>> vector_bounding_balls_;
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    struct PinnedSnapshot {
+        const SegmentSealedImpl* segment_ = nullptr;
+        SnapshotPtr snapshot_;
+    };
+    struct SnapshotPin;
+
+    // the snapshot pinned by the search running on this thread, the current one otherwise
+    SnapshotPtr
+    snapshot() const;
+
+    // writers are serialized, they never block searches
+    void
+    update_snapshot(const std::function<void(Snapshot&)>& update);
+
+    static void
+    update_row_count(Snapshot& snapshot, int64_t row_count) {
+        if (snapshot.row_count_opt_.has_value()) {
+            AssertInfo(snapshot.row_count_opt_.value() == row_count,
+                       "load data has different row count from other columns");
+        } else {
+            snapshot.row_count_opt_ = row_count;
+        }
+    }
+
+    void
+    load_index(const LoadIndexInfo& info, bool replace);
+
     template <typename T>
     static void
     bulk_subscript_impl(const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw);
@@ -85,15 +143,6 @@ class SegmentSealedImpl : public SegmentSealed {
     bulk_subscript_impl(
         int64_t element_sizeof, const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw);
 
-    void
-    update_row_count(int64_t row_count) {
-        if (row_count_opt_.has_value()) {
-            AssertInfo(row_count_opt_.value() == row_count, "load data has different row count from other columns");
-        } else {
-            row_count_opt_ = row_count;
-        }
-    }
-
     void
     vector_search(int64_t vec_count,
                   query::QueryInfo query_info,
@@ -102,23 +151,27 @@ class SegmentSealedImpl : public SegmentSealed {
                   const BitsetView& bitset,
                   QueryResult& output) const override;
 
+    query::VectorSearchCostInfo
+    get_vector_search_cost_info(const query::QueryInfo& query_info) const override;
+
+    const query::VectorBoundingBall*
+    get_vector_bounding_ball(FieldOffset field_offset) const override;
+
     bool
     is_system_field_ready() const {
-        return system_ready_count_ == 1;
+        return snapshot()->row_ids_ != nullptr;
     }
 
  private:
-    // segment loading state
-    boost::dynamic_bitset<> field_data_ready_bitset_;
-    boost::dynamic_bitset<> vecindex_ready_bitset_;
-    std::atomic<int> system_ready_count_ = 0;
-    // segment datas
-    // TODO: generate index for scalar
-    std::optional<int64_t> row_count_opt_;
-    std::vector<std::unique_ptr<knowhere::Index>> scalar_indexings_;
-    SealedIndexingRecord vecindexs_;
-    std::vector<aligned_vector<char>> field_datas_;
-    aligned_vector<idx_t> row_ids_;
     SchemaPtr schema_;
+    std::string residency_name_;
+    // read and replaced with atomic loads and stores
+    SnapshotPtr snapshot_;
+    std::mutex update_mutex_;
+    static thread_local PinnedSnapshot pinned_snapshot_;
+    // async index loads still running, the segment waits for them before it goes away
+    std::mutex pending_loads_mutex_;
+    std::condition_variable pending_loads_cond_;
+    int64_t pending_loads_ = 0;
 };
 }  // namespace milvus::segcore
@@ -10,10 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "index/knowhere/knowhere/common/BinarySet.h"
-#include "index/knowhere/knowhere/index/vector_index/VecIndexFactory.h"
 #include "segcore/load_index_c.h"
+#include "segcore/IndexLoader.h"
 #include "common/LoadInfo.h"
 #include "exceptions/EasyAssert.h"
+#include <cstdio>
 
 CStatus
 NewLoadIndexInfo(CLoadIndexInfo* c_load_index_info) {
@@ -35,6 +36,10 @@ NewLoadIndexInfo(CLoadIndexInfo* c_load_index_info) {
 void
 DeleteLoadIndexInfo(CLoadIndexInfo c_load_index_info) {
     auto info = (LoadIndexInfo*)c_load_index_info;
+    if (!info->index_file.empty()) {
+        // left over when the index wasn't handed to a segment
+        std::remove(info->index_file.c_str());
+    }
     delete info;
 }
 
@@ -81,20 +86,9 @@ AppendIndex(CLoadIndexInfo c_load_index_info, CBinarySet c_binary_set) {
     try {
         auto load_index_info = (LoadIndexInfo*)c_load_index_info;
         auto binary_set = (milvus::knowhere::BinarySet*)c_binary_set;
-        auto& index_params = load_index_info->index_params;
-        bool find_index_type = index_params.count("index_type") > 0 ? true : false;
-        bool find_index_mode = index_params.count("index_mode") > 0 ? true : false;
-        Assert(find_index_type == true);
-        milvus::knowhere::IndexMode mode;
-        if (find_index_mode) {
-            mode = index_params["index_mode"] == "CPU" ? milvus::knowhere::IndexMode::MODE_CPU
-                                                       : milvus::knowhere::IndexMode::MODE_GPU;
-        } else {
-            mode = milvus::knowhere::IndexMode::MODE_CPU;
-        }
-        load_index_info->index =
-            milvus::knowhere::VecIndexFactory::GetInstance().CreateVecIndex(index_params["index_type"], mode);
-        load_index_info->index->Load(*binary_set);
+        load_index_info->index = milvus::segcore::LoadVecIndex(load_index_info->index_params, *binary_set);
+        // the binaries belong to the caller, keep a local copy to reload the index from after an eviction
+        load_index_info->index_file = milvus::segcore::KeepIndexFile(*binary_set);
         auto status = CStatus();
         status.error_code = Success;
         status.error_msg = "";
@@ -150,3 +144,35 @@ AppendBinaryIndex(CBinarySet c_binary_set, void* index_binary, int64_t index_siz
         return status;
     }
 }
+
+int
+GetLoadIndexStage(CLoadIndexFuture c_load_index_future) {
+    auto future = (milvus::segcore::LoadIndexFuturePtr*)c_load_index_future;
+    return static_cast<int>((*future)->stage());
+}
+
+CStatus
+WaitLoadIndex(CLoadIndexFuture c_load_index_future, int64_t timeout_ms, bool* finished) {
+    auto future = (milvus::segcore::LoadIndexFuturePtr*)c_load_index_future;
+    if (timeout_ms < 0) {
+        (*future)->Wait();
+        *finished = true;
+    } else {
+        *finished = (*future)->WaitFor(timeout_ms);
+    }
+    auto status = CStatus();
+    if (*finished && (*future)->stage() == milvus::segcore::LoadIndexStage::FAILED) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup((*future)->error().c_str());
+        return status;
+    }
+    status.error_code = Success;
+    status.error_msg = "";
+    return status;
+}
+
+void
+DeleteLoadIndexFuture(CLoadIndexFuture c_load_index_future) {
+    auto future = (milvus::segcore::LoadIndexFuturePtr*)c_load_index_future;
+    delete future;
+}
@@ -22,6 +22,7 @@ extern "C" {
 
 typedef void* CLoadIndexInfo;
 typedef void* CBinarySet;
+typedef void* CLoadIndexFuture;
 
 CStatus
 NewLoadIndexInfo(CLoadIndexInfo* c_load_index_info);
@@ -47,6 +48,19 @@ DeleteBinarySet(CBinarySet c_binary_set);
 CStatus
 AppendBinaryIndex(CBinarySet c_binary_set, void* index_binary, int64_t index_size, const char* c_index_key);
 
+// stage of an async index load, see LoadIndexStage: 0 pending, 1 deserializing, 2 warming up, 3 swapping,
+// 4 done, 5 failed
+int
+GetLoadIndexStage(CLoadIndexFuture c_load_index_future);
+
+// waits up to timeout_ms for the load to finish, forever when negative. fails with the error of a failed load.
+CStatus
+WaitLoadIndex(CLoadIndexFuture c_load_index_future, int64_t timeout_ms, bool* finished);
+
+// the load goes on when the future is deleted before it finished
+void
+DeleteLoadIndexFuture(CLoadIndexFuture c_load_index_future);
+
 #ifdef __cplusplus
 }
 #endif
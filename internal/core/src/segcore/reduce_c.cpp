@@ -132,6 +132,74 @@ ResetSearchResult(std::vector<std::vector<int64_t>>& search_records,
     }
 }
 
+// range search results are variable length: the per query hits of all segments are merged best first,
+// up to topK_ of them when it's set, and result_lims_ of each selected segment is reset to its picked hits
+void
+ReduceRangeSearchResults(std::vector<SearchResult*>& search_results, bool* is_selected) {
+    auto num_segments = search_results.size();
+    auto num_queries = search_results[0]->num_queries_;
+    int64_t limit = search_results[0]->topK_;
+    std::vector<std::vector<int64_t>> search_records(num_segments);
+    std::vector<std::vector<int64_t>> selected_lims(num_segments, std::vector<int64_t>(num_queries + 1, 0));
+
+    int64_t loc_offset = 0;
+    std::vector<int64_t> cursors(num_segments);
+    for (int64_t qn = 0; qn < num_queries; ++qn) {
+        for (int j = 0; j < num_segments; ++j) {
+            AssertInfo(search_results[j]->result_lims_.size() == num_queries + 1, "range search result mismatch");
+            cursors[j] = search_results[j]->result_lims_[qn];
+        }
+        for (int64_t count = 0; limit <= 0 || count < limit; ++count) {
+            // distances are in descending order, see Search in segment_c.cpp
+            int best = -1;
+            for (int j = 0; j < num_segments; ++j) {
+                if (cursors[j] >= search_results[j]->result_lims_[qn + 1]) {
+                    continue;
+                }
+                if (best == -1 || search_results[j]->result_distances_[cursors[j]] >
+                                      search_results[best]->result_distances_[cursors[best]]) {
+                    best = j;
+                }
+            }
+            if (best == -1) {
+                break;
+            }
+            is_selected[best] = true;
+            search_results[best]->result_offsets_.push_back(loc_offset++);
+            search_records[best].push_back(cursors[best]++);
+        }
+        for (int j = 0; j < num_segments; ++j) {
+            selected_lims[j][qn + 1] = search_records[j].size();
+        }
+    }
+    ResetSearchResult(search_records, search_results, is_selected);
+    for (int j = 0; j < num_segments; ++j) {
+        if (is_selected[j]) {
+            search_results[j]->result_lims_ = std::move(selected_lims[j]);
+        }
+    }
+}
+
+// offsets of the hits of each query in the reorganized hits, hits of query i are [lims[i], lims[i + 1])
+std::vector<int64_t>
+GetReorganizedLims(const std::vector<SearchResult*>& search_results,
+                   bool is_range_search,
+                   int64_t total_num_queries,
+                   int64_t topk) {
+    std::vector<int64_t> lims(total_num_queries + 1, 0);
+    for (int64_t qn = 0; qn < total_num_queries; ++qn) {
+        auto count = topk;
+        if (is_range_search) {
+            count = 0;
+            for (auto search_result : search_results) {
+                count += search_result->result_lims_[qn + 1] - search_result->result_lims_[qn];
+            }
+        }
+        lims[qn + 1] = lims[qn] + count;
+    }
+    return lims;
+}
+
 CStatus
 ReduceQueryResults(CQueryResult* c_search_results, int64_t num_segments, bool* is_selected) {
     try {
@@ -139,6 +207,13 @@ ReduceQueryResults(CQueryResult* c_search_results, int64_t num_segments, bool* i
         for (int i = 0; i < num_segments; ++i) {
             search_results.push_back((SearchResult*)c_search_results[i]);
         }
+        if (!search_results[0]->result_lims_.empty()) {
+            ReduceRangeSearchResults(search_results, is_selected);
+            auto status = CStatus();
+            status.error_code = Success;
+            status.error_msg = "";
+            return status;
+        }
         auto topk = search_results[0]->topK_;
         auto num_queries = search_results[0]->num_queries_;
         std::vector<std::vector<int64_t>> search_records(num_segments);
@@ -180,9 +255,18 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
             total_num_queries += num_queries;
         }
 
-        std::vector<float> result_distances(total_num_queries * topk);
-        std::vector<int64_t> result_ids(total_num_queries * topk);
-        std::vector<std::vector<char>> row_datas(total_num_queries * topk);
+        std::vector<SearchResult*> selected_results;
+        for (int i = 0; i < num_segments; i++) {
+            if (is_selected[i]) {
+                selected_results.push_back((SearchResult*)c_search_results[i]);
+            }
+        }
+        auto is_range_search = num_segments > 0 && !((SearchResult*)c_search_results[0])->result_lims_.empty();
+        auto lims = GetReorganizedLims(selected_results, is_range_search, total_num_queries, topk);
+
+        std::vector<float> result_distances(lims[total_num_queries]);
+        std::vector<int64_t> result_ids(lims[total_num_queries]);
+        std::vector<std::vector<char>> row_datas(lims[total_num_queries]);
         std::vector<char> temp_ids;
 
         std::vector<int64_t> counts(num_segments);
@@ -207,10 +291,10 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
         for (int i = 0; i < num_segments; i++) {
             total_count += counts[i];
         }
-        AssertInfo(total_count == total_num_queries * topk,
+        AssertInfo(total_count == lims[total_num_queries],
                    "the reduces result's size less than total_num_queries*topk");
 
-        int64_t last_offset = 0;
+        int64_t last_query = 0;
         for (int i = 0; i < num_groups; i++) {
             MarshaledHitsPeerGroup& hits_peer_group = (*marshaledHits).marshaled_hits_[i];
             hits_peer_group.hits_.resize(num_queries_peer_group[i]);
@@ -218,15 +302,15 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
             std::vector<milvus::proto::milvus::Hits> hits(num_queries_peer_group[i]);
 #pragma omp parallel for
             for (int m = 0; m < num_queries_peer_group[i]; m++) {
-                for (int n = 0; n < topk; n++) {
-                    int64_t result_offset = last_offset + m * topk + n;
+                auto query = last_query + m;
+                for (int64_t result_offset = lims[query]; result_offset < lims[query + 1]; result_offset++) {
                     hits[m].add_ids(result_ids[result_offset]);
                     hits[m].add_scores(result_distances[result_offset]);
                     auto& row_data = row_datas[result_offset];
                     hits[m].add_row_data(row_data.data(), row_data.size());
                 }
             }
-            last_offset = last_offset + num_queries_peer_group[i] * topk;
+            last_query = last_query + num_queries_peer_group[i];
 
 #pragma omp parallel for
             for (int j = 0; j < num_queries_peer_group[i]; j++) {
@@ -266,9 +350,12 @@ ReorganizeSingleQueryResult(CMarshaledHits* c_marshaled_hits,
         for (int i = 0; i < num_groups; i++) {
             auto num_queries = GetNumOfQueries(c_placeholder_groups[i]);
             num_queries_peer_group.push_back(num_queries);
+            total_num_queries += num_queries;
         }
 
-        int64_t last_offset = 0;
+        auto lims = GetReorganizedLims({search_result}, !search_result->result_lims_.empty(), total_num_queries, topk);
+
+        int64_t last_query = 0;
         for (int i = 0; i < num_groups; i++) {
             MarshaledHitsPeerGroup& hits_peer_group = (*marshaledHits).marshaled_hits_[i];
             hits_peer_group.hits_.resize(num_queries_peer_group[i]);
@@ -276,8 +363,8 @@ ReorganizeSingleQueryResult(CMarshaledHits* c_marshaled_hits,
             std::vector<milvus::proto::milvus::Hits> hits(num_queries_peer_group[i]);
 #pragma omp parallel for
             for (int m = 0; m < num_queries_peer_group[i]; m++) {
-                for (int n = 0; n < topk; n++) {
-                    int64_t result_offset = last_offset + m * topk + n;
+                auto query = last_query + m;
+                for (int64_t result_offset = lims[query]; result_offset < lims[query + 1]; result_offset++) {
                     hits[m].add_scores(search_result->result_distances_[result_offset]);
                     auto& row_data = search_result->row_data_[result_offset];
                     hits[m].add_row_data(row_data.data(), row_data.size());
@@ -286,7 +373,7 @@ ReorganizeSingleQueryResult(CMarshaledHits* c_marshaled_hits,
                     hits[m].add_ids(result_id);
                 }
             }
-            last_offset = last_offset + num_queries_peer_group[i] * topk;
+            last_query = last_query + num_queries_peer_group[i];
 
 #pragma omp parallel for
             for (int j = 0; j < num_queries_peer_group[i]; j++) {
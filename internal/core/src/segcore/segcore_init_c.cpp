@@ -11,7 +11,9 @@
 
 #include "index/thirdparty/faiss/FaissHook.h"
 #include "segcore/segcore_init_c.h"
+#include "segcore/ResidencyManager.h"
 #include "knowhere/archive/KnowhereConfig.h"
+#include <algorithm>
 #include <iostream>
 #include "utils/Log.h"
 
@@ -33,3 +35,32 @@ extern "C" void
 SegcoreInit() {
     milvus::segcore::SegcoreInitImpl();
 }
+
+extern "C" void
+SegcoreSetResidencyBudget(int64_t budget, const char* spill_path) {
+    auto& manager = milvus::segcore::ResidencyManager::GetInstance();
+    if (spill_path != nullptr && spill_path[0] != '\0') {
+        manager.SetSpillPath(spill_path);
+    }
+    manager.SetBudget(std::max<int64_t>(budget, 0));
+}
+
+extern "C" void
+SegcoreSetIndexMmapPath(const char* mmap_path) {
+    if (mmap_path != nullptr && mmap_path[0] != '\0') {
+        milvus::engine::KnowhereConfig::SetMmapPath(mmap_path);
+    }
+}
+
+extern "C" CResidencyStatistics
+GetResidencyStatistics() {
+    auto statistics = milvus::segcore::ResidencyManager::GetInstance().GetStatistics();
+    CResidencyStatistics c_statistics;
+    c_statistics.budget = statistics.budget;
+    c_statistics.usage = statistics.usage;
+    c_statistics.hits = statistics.hits;
+    c_statistics.misses = statistics.misses;
+    c_statistics.evictions = statistics.evictions;
+    c_statistics.reloads = statistics.reloads;
+    return c_statistics;
+}
@@ -12,9 +12,33 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 void
 SegcoreInit();
 
+// memory budget in bytes for the indexes and columns of sealed segments, 0 keeps all of them resident.
+// data over the budget is evicted and reloaded from spill files under spill_path on its next access.
+// only applies to segment data loaded afterwards.
+void
+SegcoreSetResidencyBudget(int64_t budget, const char* spill_path);
+
+// directory the inverted lists of indexes loaded with index_mode MMAP are mapped from
+void
+SegcoreSetIndexMmapPath(const char* mmap_path);
+
+typedef struct CResidencyStatistics {
+    int64_t budget;
+    int64_t usage;
+    int64_t hits;
+    int64_t misses;
+    int64_t evictions;
+    int64_t reloads;
+} CResidencyStatistics;
+
+CResidencyStatistics
+GetResidencyStatistics();
+
 #ifdef __cplusplus
 }
 #endif
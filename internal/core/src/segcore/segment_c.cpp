@@ -33,7 +33,7 @@ NewSegment(CCollection collection, uint64_t segment_id, SegmentType seg_type) {
             std::cout << "invalid segment type" << std::endl;
             break;
         case Growing:
-            segment = milvus::segcore::CreateGrowingSegment(col->get_schema());
+            segment = milvus::segcore::CreateGrowingSegment(col->get_schema(), col->get_coarse_quantizer_pool());
             break;
         case Sealed:
         case Indexing:
@@ -62,6 +62,51 @@ DeleteQueryResult(CQueryResult query_result) {
     delete res;
 }
 
+CSearchBound
+NewSearchBound(CPlan c_plan, CPlaceholderGroup c_placeholder_group) {
+    auto plan = (milvus::query::Plan*)c_plan;
+    auto placeholder_group = (milvus::query::PlaceholderGroup*)c_placeholder_group;
+    auto& query_info = plan->plan_node_->query_info_;
+    auto num_queries = placeholder_group->at(0).num_of_queries_;
+    auto search_bound =
+        std::make_unique<milvus::query::SearchBound>(num_queries, query_info.topK_, query_info.metric_type_);
+    return (CSearchBound)search_bound.release();
+}
+
+void
+DeleteSearchBound(CSearchBound c_search_bound) {
+    auto search_bound = (milvus::query::SearchBound*)c_search_bound;
+    delete search_bound;
+}
+
+CStatus
+GetBestPossibleDistance(CSegmentInterface c_segment,
+                        CPlan c_plan,
+                        CPlaceholderGroup c_placeholder_group,
+                        bool* has_distance,
+                        float* distance) {
+    try {
+        auto segment = (milvus::segcore::SegmentInterface*)c_segment;
+        auto plan = (milvus::query::Plan*)c_plan;
+        auto placeholder_group = (milvus::query::PlaceholderGroup*)c_placeholder_group;
+        auto best = segment->GetBestPossibleDistance(plan, *placeholder_group);
+        *has_distance = best.has_value();
+        if (best.has_value()) {
+            auto metric_type = plan->plan_node_->query_info_.metric_type_;
+            *distance = metric_type == milvus::MetricType::METRIC_INNER_PRODUCT ? best.value() : -best.value();
+        }
+        auto status = CStatus();
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        auto status = CStatus();
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
+
 CStatus
 Search(CSegmentInterface c_segment,
        CPlan c_plan,
@@ -69,6 +114,17 @@ Search(CSegmentInterface c_segment,
        uint64_t* timestamps,
        int num_groups,
        CQueryResult* result) {
+    return SearchWithBound(c_segment, c_plan, c_placeholder_groups, timestamps, num_groups, nullptr, result);
+}
+
+CStatus
+SearchWithBound(CSegmentInterface c_segment,
+                CPlan c_plan,
+                CPlaceholderGroup* c_placeholder_groups,
+                uint64_t* timestamps,
+                int num_groups,
+                CSearchBound c_search_bound,
+                CQueryResult* result) {
     auto status = CStatus();
     auto query_result = std::make_unique<milvus::QueryResult>();
     try {
@@ -78,7 +134,8 @@ Search(CSegmentInterface c_segment,
         for (int i = 0; i < num_groups; ++i) {
             placeholder_groups.push_back((const milvus::query::PlaceholderGroup*)c_placeholder_groups[i]);
         }
-        *query_result = segment->Search(plan, placeholder_groups.data(), timestamps, num_groups);
+        auto search_bound = (milvus::query::SearchBound*)c_search_bound;
+        *query_result = segment->Search(plan, placeholder_groups.data(), timestamps, num_groups, search_bound);
         if (plan->plan_node_->query_info_.metric_type_ != milvus::MetricType::METRIC_INNER_PRODUCT) {
             for (auto& dis : query_result->result_distances_) {
                 dis *= -1;
@@ -260,6 +317,31 @@ UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_inde
     }
 }
 
+CStatus
+UpdateSealedSegmentIndexAsync(CSegmentInterface c_segment,
+                              CLoadIndexInfo c_load_index_info,
+                              CBinarySet c_binary_set,
+                              CLoadIndexFuture* c_load_index_future) {
+    auto status = CStatus();
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto load_index_info = (LoadIndexInfo*)c_load_index_info;
+        auto binary_set = (milvus::knowhere::BinarySet*)c_binary_set;
+        // the binaries may be go memory, they are released once this call returns
+        auto future = segment->LoadIndexAsync(*load_index_info, milvus::segcore::CopyBinarySet(*binary_set));
+        *c_load_index_future = new milvus::segcore::LoadIndexFuturePtr(std::move(future));
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
+
 CStatus
 DropFieldData(CSegmentInterface c_segment, int64_t field_id) {
     try {
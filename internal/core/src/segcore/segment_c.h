@@ -25,6 +25,7 @@ extern "C" {
 
 typedef void* CSegmentInterface;
 typedef void* CQueryResult;
+typedef void* CSearchBound;
 
 //////////////////////////////    common interfaces    //////////////////////////////
 CSegmentInterface
@@ -44,6 +45,32 @@ Search(CSegmentInterface c_segment,
        int num_groups,
        CQueryResult* result);
 
+// the search bound is shared by the segments searched for one request, they skip hits
+// that can't make the topk of the request, it must outlive the searches using it
+CSearchBound
+NewSearchBound(CPlan c_plan, CPlaceholderGroup c_placeholder_group);
+
+void
+DeleteSearchBound(CSearchBound c_search_bound);
+
+CStatus
+SearchWithBound(CSegmentInterface c_segment,
+                CPlan plan,
+                CPlaceholderGroup* placeholder_groups,
+                uint64_t* timestamps,
+                int num_groups,
+                CSearchBound c_search_bound,
+                CQueryResult* result);
+
+// best distance the queries can reach in the segment, larger is better as for the distances of Search,
+// searching segments with better ones first tightens the search bound sooner
+CStatus
+GetBestPossibleDistance(CSegmentInterface c_segment,
+                        CPlan c_plan,
+                        CPlaceholderGroup c_placeholder_group,
+                        bool* has_distance,
+                        float* distance);
+
 CStatus
 FillTargetEntry(CSegmentInterface c_segment, CPlan c_plan, CQueryResult result);
 
@@ -87,6 +114,14 @@ LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_in
 CStatus
 UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_index_info);
 
+// loads the index from a copy of the binaries in the background and swaps it in, searches keep running.
+// only the field id and index params of the load index info are used.
+CStatus
+UpdateSealedSegmentIndexAsync(CSegmentInterface c_segment,
+                              CLoadIndexInfo c_load_index_info,
+                              CBinarySet c_binary_set,
+                              CLoadIndexFuture* c_load_index_future);
+
 CStatus
 DropFieldData(CSegmentInterface c_segment, int64_t field_id);
 
@@ -57,6 +57,7 @@ enum class DataType {
 
     VECTOR_BINARY = 100,
     VECTOR_FLOAT = 101,
+    VECTOR_INT8 = 102,
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
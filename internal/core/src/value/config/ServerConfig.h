@@ -48,11 +48,13 @@ const valueEnum SimdMap{
 enum ClusteringType {
     K_MEANS = 1,
     K_MEANS_PLUS_PLUS,
+    K_MEANS_PARALLEL,
 };
 
 const valueEnum ClusteringMap{
     {"k-means", ClusteringType::K_MEANS},
     {"k-means++", ClusteringType::K_MEANS_PLUS_PLUS},
+    {"k-means||", ClusteringType::K_MEANS_PARALLEL},
 };
 
 struct ServerConfig {
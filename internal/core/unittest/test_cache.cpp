@@ -0,0 +1,167 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cache/Cache.h"
+#include "cache/DataObj.h"
+
+using namespace milvus::cache;
+
+namespace {
+class MockItem : public DataObj {
+ public:
+    explicit MockItem(int64_t size) : size_(size) {
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    int64_t size_;
+};
+
+const std::vector<CachePolicyType> policies = {CachePolicyType::LRU, CachePolicyType::CLOCK,
+                                               CachePolicyType::TINY_LFU};
+}  // namespace
+
+TEST(Cache, Basic) {
+    for (auto policy : policies) {
+        Cache<DataObjPtr> cache(1000, 1000, "[TEST]", policy, 4);
+        for (int i = 0; i < 10; ++i) {
+            cache.insert("item_" + std::to_string(i), std::make_shared<MockItem>(10));
+        }
+        ASSERT_EQ(cache.size(), 10);
+        ASSERT_EQ(cache.usage(), 100);
+        ASSERT_TRUE(cache.exists("item_3"));
+        ASSERT_NE(cache.get("item_3"), nullptr);
+        ASSERT_EQ(cache.get("missing"), nullptr);
+
+        // replacing an item accounts for the new size only
+        cache.insert("item_3", std::make_shared<MockItem>(30));
+        ASSERT_EQ(cache.usage(), 120);
+        cache.erase("item_3");
+        ASSERT_FALSE(cache.exists("item_3"));
+        ASSERT_EQ(cache.usage(), 90);
+
+        auto statistics = cache.statistics();
+        ASSERT_EQ(statistics.hits, 1);
+        ASSERT_EQ(statistics.misses, 1);
+        ASSERT_EQ(statistics.evictions, 0);
+
+        cache.clear();
+        ASSERT_EQ(cache.size(), 0);
+        ASSERT_EQ(cache.usage(), 0);
+    }
+}
+
+TEST(Cache, ByteBudget) {
+    for (auto policy : policies) {
+        Cache<DataObjPtr> cache(1000, 1000, "[TEST]", policy, 4);
+        for (int i = 0; i < 500; ++i) {
+            cache.insert("item_" + std::to_string(i), std::make_shared<MockItem>(10));
+            ASSERT_LE(cache.usage(), cache.capacity());
+        }
+        auto statistics = cache.statistics();
+        ASSERT_GT(statistics.evictions, 0);
+        ASSERT_EQ(cache.size() * 10, cache.usage());
+        // the newest item always survives its own insert
+        ASSERT_TRUE(cache.exists("item_499"));
+
+        ASSERT_FALSE(cache.reserve(2000));
+        ASSERT_TRUE(cache.reserve(500));
+        ASSERT_LE(cache.usage(), 500);
+
+        cache.set_capacity(200);
+        ASSERT_LE(cache.usage(), 200);
+    }
+}
+
+TEST(Cache, MaxCount) {
+    for (auto policy : policies) {
+        Cache<DataObjPtr> cache(1L << 30, 8, "[TEST]", policy, 1);
+        for (int i = 0; i < 100; ++i) {
+            cache.insert("item_" + std::to_string(i), std::make_shared<MockItem>(1));
+        }
+        ASSERT_EQ(cache.size(), 8);
+    }
+}
+
+TEST(Cache, LruOrder) {
+    Cache<DataObjPtr> cache(100, 100, "[TEST]", CachePolicyType::LRU, 1);
+    cache.set_freemem_percent(1.0);
+    for (int i = 0; i < 10; ++i) {
+        cache.insert("item_" + std::to_string(i), std::make_shared<MockItem>(10));
+    }
+    cache.get("item_0");
+    cache.insert("item_10", std::make_shared<MockItem>(10));
+    ASSERT_TRUE(cache.exists("item_0"));
+    ASSERT_FALSE(cache.exists("item_1"));
+}
+
+TEST(Cache, ScanResistance) {
+    auto hot_retained = [](CachePolicyType policy) {
+        Cache<DataObjPtr> cache(1000, 1000, "[TEST]", policy, 1);
+        cache.set_freemem_percent(1.0);
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 50; ++i) {
+                auto key = "hot_" + std::to_string(i);
+                if (cache.get(key) == nullptr) {
+                    cache.insert(key, std::make_shared<MockItem>(10));
+                }
+            }
+        }
+        // a scan of one-off items, five times the budget
+        for (int i = 0; i < 500; ++i) {
+            cache.insert("scan_" + std::to_string(i), std::make_shared<MockItem>(10));
+        }
+        int retained = 0;
+        for (int i = 0; i < 50; ++i) {
+            retained += cache.exists("hot_" + std::to_string(i));
+        }
+        return retained;
+    };
+
+    ASSERT_EQ(hot_retained(CachePolicyType::LRU), 0);
+    ASSERT_GE(hot_retained(CachePolicyType::TINY_LFU), 40);
+}
+
+TEST(Cache, Concurrent) {
+    for (auto policy : policies) {
+        Cache<DataObjPtr> cache(10000, 100000, "[TEST]", policy);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&cache, t] {
+                for (int i = 0; i < 5000; ++i) {
+                    auto key = "item_" + std::to_string((i * 7 + t) % 2000);
+                    if (cache.get(key) == nullptr) {
+                        cache.insert(key, std::make_shared<MockItem>(10));
+                    }
+                    if (i % 100 == 0) {
+                        cache.erase(key);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        ASSERT_LE(cache.usage(), cache.capacity());
+        ASSERT_EQ(cache.size() * 10, cache.usage());
+        auto statistics = cache.statistics();
+        ASSERT_EQ(statistics.hits + statistics.misses, 8 * 5000);
+    }
+}
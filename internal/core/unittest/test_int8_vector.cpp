@@ -0,0 +1,174 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <faiss/FaissHook.h>
+#include <faiss/utils/distances.h>
+#include <faiss/utils/distances_avx.h>
+#include <faiss/utils/distances_avx512.h>
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+// exact top k distances of every query, ties in any order
+std::vector<float>
+NaiveTopK(const int8_t* queries, const int8_t* base, int64_t num_queries, int64_t N, int64_t dim, int64_t topK, bool ip) {
+    std::vector<float> result;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::vector<float> distances(N);
+        for (int64_t i = 0; i < N; ++i) {
+            auto x = queries + q * dim;
+            auto y = base + i * dim;
+            distances[i] = ip ? faiss::i8vec_inner_product_ref(x, y, dim) : faiss::i8vec_L2sqr_ref(x, y, dim);
+        }
+        if (ip) {
+            std::partial_sort(distances.begin(), distances.begin() + topK, distances.end(), std::greater<float>());
+        } else {
+            std::partial_sort(distances.begin(), distances.begin() + topK, distances.end());
+        }
+        result.insert(result.end(), distances.begin(), distances.begin() + topK);
+    }
+    return result;
+}
+
+void
+CheckQueryResult(const QueryResult& qr,
+                 const int8_t* queries,
+                 const int8_t* base,
+                 int64_t num_queries,
+                 int64_t N,
+                 int64_t dim,
+                 int64_t topK,
+                 bool ip) {
+    auto expected = NaiveTopK(queries, base, num_queries, N, dim, topK, ip);
+    ASSERT_EQ(qr.result_distances_.size(), num_queries * topK);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        for (int64_t k = 0; k < topK; ++k) {
+            auto index = q * topK + k;
+            ASSERT_EQ(qr.result_distances_[index], expected[index]);
+            auto offset = qr.internal_seg_offsets_[index];
+            ASSERT_GE(offset, 0);
+            auto x = queries + q * dim;
+            auto y = base + offset * dim;
+            auto distance = ip ? faiss::i8vec_inner_product_ref(x, y, dim) : faiss::i8vec_L2sqr_ref(x, y, dim);
+            ASSERT_EQ(qr.result_distances_[index], distance);
+        }
+    }
+}
+
+std::string
+Int8Dsl(const std::string& metric_type) {
+    return R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "int8vec": {
+                        "metric_type": ")" +
+           metric_type + R"(",
+                        "params": {},
+                        "query": "$0",
+                        "topk": 10
+                    }
+                }
+            }
+            ]
+        }
+    })";
+}
+}  // namespace
+
+TEST(Int8Vector, Kernels) {
+    std::default_random_engine e(42);
+    for (size_t d : {1, 7, 16, 31, 64, 100, 128, 257}) {
+        std::vector<int8_t> x(d), y(d);
+        for (size_t i = 0; i < d; ++i) {
+            x[i] = e();
+            y[i] = e();
+        }
+        // the extremes, -128 * -128 overflows int16 pair sums of saturating instructions
+        x[0] = -128;
+        y[0] = -128;
+        auto ip = faiss::i8vec_inner_product_ref(x.data(), y.data(), d);
+        auto l2 = faiss::i8vec_L2sqr_ref(x.data(), y.data(), d);
+        ASSERT_EQ(faiss::i8vec_inner_product_avx(x.data(), y.data(), d), ip);
+        ASSERT_EQ(faiss::i8vec_L2sqr_avx(x.data(), y.data(), d), l2);
+        if (faiss::support_avx512()) {
+            ASSERT_EQ(faiss::i8vec_inner_product_avx512(x.data(), y.data(), d), ip);
+            ASSERT_EQ(faiss::i8vec_L2sqr_avx512(x.data(), y.data(), d), l2);
+        }
+        if (faiss::support_avx512_vnni()) {
+            ASSERT_EQ(faiss::i8vec_inner_product_avx512_vnni(x.data(), y.data(), d), ip);
+            ASSERT_EQ(faiss::i8vec_L2sqr_avx512_vnni(x.data(), y.data(), d), l2);
+        }
+    }
+}
+
+TEST(Int8Vector, GrowingSearch) {
+    int64_t N = 10000;
+    int64_t dim = 100;
+    int64_t num_queries = 5;
+    int64_t topK = 10;
+    for (auto metric_type : {MetricType::METRIC_L2, MetricType::METRIC_INNER_PRODUCT}) {
+        auto ip = metric_type == MetricType::METRIC_INNER_PRODUCT;
+        auto schema = std::make_shared<Schema>();
+        schema->AddDebugField("int8vec", DataType::VECTOR_INT8, dim, metric_type);
+        schema->AddDebugField("age", DataType::INT64);
+        auto dataset = DataGen(schema, N);
+        auto base = dataset.get_col<int8_t>(0);
+
+        auto segment = CreateGrowingSegment(schema);
+        segment->PreInsert(N);
+        segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+        auto plan = CreatePlan(*schema, Int8Dsl(ip ? "IP" : "L2"));
+        auto ph_group_raw = CreateInt8PlaceholderGroupFromBlob(num_queries, dim, base.data());
+        auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+        Timestamp time = 1000000;
+
+        auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+        CheckQueryResult(qr, base.data(), base.data(), num_queries, N, dim, topK, ip);
+
+        ASSERT_EQ(segment->num_chunk(), 1);
+        auto span = segment->chunk_data<Int8Vector>(FieldOffset(0), 0);
+        ASSERT_EQ(memcmp(span.data(), base.data(), N * dim), 0);
+    }
+}
+
+TEST(Int8Vector, SealedSearch) {
+    int64_t N = 10000;
+    int64_t dim = 100;
+    int64_t num_queries = 5;
+    int64_t topK = 10;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("int8vec", DataType::VECTOR_INT8, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto base = dataset.get_col<int8_t>(0);
+
+    auto segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *segment);
+
+    auto plan = CreatePlan(*schema, Int8Dsl("L2"));
+    auto ph_group_raw = CreateInt8PlaceholderGroupFromBlob(num_queries, dim, base.data() + dim);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+    Timestamp time = 1000000;
+
+    auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    CheckQueryResult(qr, base.data() + dim, base.data(), num_queries, N, dim, topK, false);
+    ASSERT_EQ(qr.result_distances_[0], 0);
+}
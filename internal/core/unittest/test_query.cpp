@@ -185,31 +185,31 @@ TEST(Query, ExecWithPredicateLoader) {
   [
     [
       "980486->3.149221",
+      "579754->3.634295",
       "318367->3.661235",
-      "302798->4.553688",
-      "321424->4.757450",
-      "565529->5.083780"
+      "265835->4.333358",
+      "302798->4.553688"
     ],
     [
       "233390->7.931535",
-      "238958->8.109344",
-      "230645->8.439169",
       "901939->8.658772",
-      "380328->8.731251"
+      "177727->8.746748",
+      "910826->9.308077",
+      "455326->9.358284"
     ],
     [
       "897246->3.749835",
-      "750683->3.897577",
       "857598->4.230977",
-      "299009->4.379639",
-      "440010->4.454046"
+      "440010->4.454046",
+      "249363->4.487551",
+      "135024->4.549778"
     ],
     [
+      "37641->3.783446",
+      "22628->4.719435",
       "840855->4.782170",
       "709627->5.063170",
-      "72322->5.166143",
-      "107142->5.180207",
-      "948403->5.247065"
+      "148177->5.156868"
     ],
     [
       "810401->3.926393",
@@ -327,31 +327,31 @@ TEST(Query, ExecWithPredicate) {
   [
     [
       "980486->3.149221",
+      "579754->3.634295",
       "318367->3.661235",
-      "302798->4.553688",
-      "321424->4.757450",
-      "565529->5.083780"
+      "265835->4.333358",
+      "302798->4.553688"
     ],
     [
       "233390->7.931535",
-      "238958->8.109344",
-      "230645->8.439169",
       "901939->8.658772",
-      "380328->8.731251"
+      "177727->8.746748",
+      "910826->9.308077",
+      "455326->9.358284"
     ],
     [
       "897246->3.749835",
-      "750683->3.897577",
       "857598->4.230977",
-      "299009->4.379639",
-      "440010->4.454046"
+      "440010->4.454046",
+      "249363->4.487551",
+      "135024->4.549778"
     ],
     [
+      "37641->3.783446",
+      "22628->4.719435",
       "840855->4.782170",
       "709627->5.063170",
-      "72322->5.166143",
-      "107142->5.180207",
-      "948403->5.247065"
+      "148177->5.156868"
     ],
     [
       "810401->3.926393",
@@ -552,31 +552,31 @@ TEST(Query, ExecWithoutPredicate) {
   [
     [
       "980486->3.149221",
+      "579754->3.634295",
       "318367->3.661235",
-      "302798->4.553688",
-      "321424->4.757450",
-      "565529->5.083780"
+      "265835->4.333358",
+      "302798->4.553688"
     ],
     [
       "233390->7.931535",
-      "238958->8.109344",
-      "230645->8.439169",
       "901939->8.658772",
-      "380328->8.731251"
+      "177727->8.746748",
+      "500435->9.259627",
+      "910826->9.308077"
     ],
     [
       "749862->3.398494",
-      "701321->3.632437",
       "897246->3.749835",
-      "750683->3.897577",
-      "105995->4.073595"
+      "105995->4.073595",
+      "857598->4.230977",
+      "562578->4.328190"
     ],
     [
       "138274->3.454446",
       "124548->3.783290",
-      "840855->4.782170",
-      "936719->5.026924",
-      "709627->5.063170"
+      "37641->3.783446",
+      "22628->4.719435",
+      "840855->4.782170"
     ],
     [
       "810401->3.926393",
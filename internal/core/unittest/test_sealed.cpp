@@ -12,13 +12,17 @@
 //
 // Created by mike on 12/28/20.
 //
+#include <set>
+#include <thread>
 #include "test_utils/DataGen.h"
 #include <gtest/gtest.h>
 #include <knowhere/index/vector_index/VecIndex.h>
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include <knowhere/index/vector_index/VecIndexFactory.h>
 #include <knowhere/index/vector_index/IndexIVF.h>
+#include <knowhere/index/vector_index/IndexIVFSQ.h>
 #include "segcore/SegmentSealedImpl.h"
+#include "segcore/ResidencyManager.h"
 
 using namespace milvus;
 using namespace milvus::segcore;
@@ -315,10 +319,10 @@ TEST(Sealed, LoadFieldData) {
   ],
   [
    "233390->7.931535",
-   "238958->8.109344",
    "230645->8.439169",
    "901939->8.658772",
-   "380328->8.731251"
+   "380328->8.731251",
+   "177727->8.746748"
   ],
   [
    "897246->3.749835",
@@ -346,3 +350,545 @@ TEST(Sealed, LoadFieldData) {
     )");
     ASSERT_EQ(std_json.dump(-2), json.dump(-2));
 }
+
+TEST(Sealed, SearchStrategy) {
+    VectorSearchCostInfo ivf_info;
+    ivf_info.index_type = knowhere::IndexEnum::INDEX_FAISS_IVFFLAT;
+    ivf_info.search_params = knowhere::Config{{knowhere::IndexParams::nprobe, 10}};
+    ivf_info.nlist = 100;
+    ASSERT_EQ(ChooseSearchStrategy(ivf_info, 100000, 100000, 10), SearchStrategy::INDEX);
+    ASSERT_EQ(ChooseSearchStrategy(ivf_info, 100000, 50000, 10), SearchStrategy::INDEX);
+    ASSERT_EQ(ChooseSearchStrategy(ivf_info, 100000, 50, 10), SearchStrategy::WIDENED_INDEX);
+    ivf_info.raw_data_available = true;
+    ASSERT_EQ(ChooseSearchStrategy(ivf_info, 100000, 50, 10), SearchStrategy::BRUTE_FORCE_ON_PASSED);
+
+    auto widened = WidenSearchParams(ivf_info.search_params, 0.01, ivf_info.nlist);
+    ASSERT_EQ(widened[knowhere::IndexParams::nprobe].get<int64_t>(), 100);
+
+    auto dim = 16;
+    auto topK = 5;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "counter": {
+                        "GE": 4200,
+                        "LT": 4205
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5
+                    }
+                }
+            }
+            ]
+        }
+    })";
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(0);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *segment);
+
+    Timestamp time = 1000000;
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, fakevec.data() + 4200 * dim);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+
+    auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    ASSERT_EQ(qr.search_strategy_, SearchStrategy::BRUTE_FORCE_ON_PASSED);
+    for (int i = 0; i < num_queries; ++i) {
+        auto offset = i * topK;
+        ASSERT_EQ(qr.internal_seg_offsets_[offset], 4200 + i);
+        ASSERT_EQ(qr.result_distances_[offset], 0.0);
+        for (int k = 0; k < topK; ++k) {
+            auto seg_offset = qr.internal_seg_offsets_[offset + k];
+            ASSERT_GE(seg_offset, 4200);
+            ASSERT_LT(seg_offset, 4205);
+        }
+    }
+}
+
+TEST(Sealed, RangeSearch) {
+    auto dim = 16;
+    int64_t N = 10000;
+    float radius = 12.0;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto make_dsl = [&](int64_t topk) {
+        Json vec_info = {{"metric_type", "L2"}, {"params", {{"range_search_radius", radius}}}, {"query", "$0"}};
+        if (topk > 0) {
+            vec_info["topk"] = topk;
+        }
+        Json dsl = {{"bool", {{"must", {{{"vector", {{"fakevec", vec_info}}}}}}}}};
+        return dsl.dump();
+    };
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(0);
+    auto sealed = CreateSealedSegment(schema);
+    SealedLoader(dataset, *sealed);
+    auto growing = CreateGrowingSegment(schema);
+    growing->PreInsert(N);
+    growing->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto num_queries = 5;
+    auto query_data = fakevec.data() + 4200 * dim;
+    std::vector<std::set<int64_t>> expected(num_queries);
+    for (int i = 0; i < num_queries; ++i) {
+        for (int64_t n = 0; n < N; ++n) {
+            float dis = 0;
+            for (int d = 0; d < dim; ++d) {
+                auto diff = query_data[i * dim + d] - fakevec[n * dim + d];
+                dis += diff * diff;
+            }
+            if (dis < radius) {
+                expected[i].insert(n);
+            }
+        }
+    }
+
+    Timestamp time = 1000000;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, query_data);
+    for (auto segment : {(SegmentInternalInterface*)sealed.get(), (SegmentInternalInterface*)growing.get()}) {
+        auto plan = CreatePlan(*schema, make_dsl(0));
+        auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+        auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+        ASSERT_EQ(qr.result_lims_.size(), num_queries + 1);
+        for (int i = 0; i < num_queries; ++i) {
+            std::set<int64_t> ids;
+            for (auto k = qr.result_lims_[i]; k < qr.result_lims_[i + 1]; ++k) {
+                ids.insert(qr.internal_seg_offsets_[k]);
+                ASSERT_LT(qr.result_distances_[k], radius);
+                if (k > qr.result_lims_[i]) {
+                    ASSERT_LE(qr.result_distances_[k - 1], qr.result_distances_[k]);
+                }
+            }
+            ASSERT_EQ(ids, expected[i]);
+            ASSERT_EQ(qr.internal_seg_offsets_[qr.result_lims_[i]], 4200 + i);
+        }
+
+        // topk caps the hits of each query
+        plan = CreatePlan(*schema, make_dsl(2));
+        qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+        for (int i = 0; i < num_queries; ++i) {
+            auto count = qr.result_lims_[i + 1] - qr.result_lims_[i];
+            ASSERT_EQ(count, std::min<int64_t>(2, expected[i].size()));
+        }
+    }
+}
+
+TEST(Sealed, Refine) {
+    auto dim = 16;
+    auto topK = 5;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto make_dsl = [&](int64_t refine_factor) {
+        Json params = {{"nprobe", 16}};
+        if (refine_factor > 1) {
+            params["refine_factor"] = refine_factor;
+        }
+        Json vec_info = {{"metric_type", "L2"}, {"params", params}, {"query", "$0"}, {"topk", topK}};
+        Json dsl = {{"bool", {{"must", {{{"vector", {{"fakevec", vec_info}}}}}}}}};
+        return dsl.dump();
+    };
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(0);
+    auto conf = knowhere::Config{{knowhere::meta::DIM, dim},
+                                 {knowhere::IndexParams::nlist, 16},
+                                 {knowhere::IndexParams::nbits, 8},
+                                 {knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+                                 {knowhere::meta::DEVICEID, 0}};
+    auto database = knowhere::GenDataset(N, dim, fakevec.data());
+    auto indexing = std::make_shared<knowhere::IVFSQ>();
+    indexing->Train(database, conf);
+    indexing->AddWithoutIds(database, conf);
+    LoadIndexInfo vec_info;
+    vec_info.field_id = fakevec_id.get();
+    vec_info.index = indexing;
+    vec_info.index_params["metric_type"] = milvus::knowhere::Metric::L2;
+
+    // raw vectors only, exact results
+    auto segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *segment);
+
+    Timestamp time = 1000000;
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, fakevec.data() + 4200 * dim);
+    auto plan = CreatePlan(*schema, make_dsl(1));
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+    auto ref_qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+
+    // quantized distances without refine
+    segment->LoadIndex(vec_info);
+    auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    ASSERT_NE(qr.result_distances_, ref_qr.result_distances_);
+
+    plan = CreatePlan(*schema, make_dsl(10));
+    qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    ASSERT_EQ(qr.internal_seg_offsets_, ref_qr.internal_seg_offsets_);
+    for (int i = 0; i < num_queries * topK; ++i) {
+        ASSERT_NEAR(qr.result_distances_[i], ref_qr.result_distances_[i], 1e-4);
+    }
+    for (int i = 0; i < num_queries; ++i) {
+        ASSERT_EQ(qr.internal_seg_offsets_[i * topK], 4200 + i);
+    }
+}
+
+TEST(Sealed, SearchBound) {
+    auto dim = 16;
+    auto topK = 5;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5
+                    }
+                }
+            }
+            ]
+        }
+    })";
+
+    auto dataset_a = DataGen(schema, N, 42);
+    auto dataset_b = DataGen(schema, N, 43);
+    // far away from the queries, the bounding ball alone rules it out
+    auto dataset_c = DataGen(schema, N, 44);
+    auto far_vec = dataset_c.get_mutable_col<float>(0);
+    for (int64_t i = 0; i < N * dim; ++i) {
+        far_vec[i] += 100;
+    }
+    std::vector<std::unique_ptr<SegmentSealed>> segments;
+    for (auto dataset : {&dataset_a, &dataset_b, &dataset_c}) {
+        segments.push_back(CreateSealedSegment(schema));
+        SealedLoader(*dataset, *segments.back());
+    }
+
+    Timestamp time = 1000000;
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto query_vec = dataset_b.get_col<float>(0);
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, query_vec.data() + 4200 * dim);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+
+    auto best_b = segments[1]->GetBestPossibleDistance(plan.get(), *ph_group);
+    auto best_c = segments[2]->GetBestPossibleDistance(plan.get(), *ph_group);
+    ASSERT_TRUE(best_b.has_value() && best_c.has_value());
+    ASSERT_EQ(best_b.value(), 0);
+    ASSERT_GT(best_c.value(), 0);
+
+    SearchBound search_bound(num_queries, topK, MetricType::METRIC_L2);
+    std::vector<QueryResult> bounded;
+    for (int seg = 1; seg >= 0; --seg) {
+        bounded.push_back(segments[seg]->Search(plan.get(), ph_group_arr.data(), &time, 1, &search_bound));
+    }
+    bounded.push_back(segments[2]->Search(plan.get(), ph_group_arr.data(), &time, 1, &search_bound));
+    for (auto offset : bounded[2].internal_seg_offsets_) {
+        ASSERT_EQ(offset, -1);
+    }
+
+    // bounded hits still contain the global topk
+    for (int i = 0; i < num_queries; ++i) {
+        std::vector<float> expected;
+        std::vector<float> actual;
+        for (auto& segment : segments) {
+            auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+            expected.insert(expected.end(), qr.result_distances_.begin() + i * topK,
+                            qr.result_distances_.begin() + (i + 1) * topK);
+        }
+        for (auto& qr : bounded) {
+            for (int k = i * topK; k < (i + 1) * topK; ++k) {
+                if (qr.internal_seg_offsets_[k] != -1) {
+                    actual.push_back(qr.result_distances_[k]);
+                }
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        ASSERT_GE(actual.size(), topK);
+        ASSERT_LT(actual.size(), expected.size());
+        for (int k = 0; k < topK; ++k) {
+            ASSERT_EQ(actual[k], expected[k]);
+        }
+        ASSERT_GE(search_bound.get(i), expected[topK - 1]);
+    }
+}
+
+TEST(Sealed, Residency) {
+    auto dim = 16;
+    auto topK = 5;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    Json vec_params = {{"metric_type", "L2"}, {"params", {{"nprobe", 16}}}, {"query", "$0"}, {"topk", topK}};
+    Json range = {{"range", {{"counter", {{"GE", -1000000}, {"LT", 1000000}}}}}};
+    Json dsl = {{"bool", {{"must", {range, {{"vector", {{"fakevec", vec_params}}}}}}}}};
+    auto plan = CreatePlan(*schema, dsl.dump());
+    auto conf = knowhere::Config{{knowhere::meta::DIM, dim},
+                                 {knowhere::IndexParams::nlist, 16},
+                                 {knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+                                 {knowhere::meta::DEVICEID, 0}};
+
+    int num_segments = 3;
+    std::vector<GeneratedData> datasets;
+    std::vector<knowhere::VecIndexPtr> indexings;
+    for (int i = 0; i < num_segments; ++i) {
+        datasets.push_back(DataGen(schema, N, 42 + i));
+        auto fakevec = datasets.back().get_col<float>(0);
+        auto database = knowhere::GenDataset(N, dim, fakevec.data());
+        auto indexing = std::make_shared<knowhere::IVFSQ>();
+        indexing->Train(database, conf);
+        indexing->AddWithoutIds(database, conf);
+        indexings.push_back(indexing);
+    }
+
+    Timestamp time = 1000000;
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+
+    auto& manager = ResidencyManager::GetInstance();
+    auto load = [&](int i) {
+        auto segment = CreateSealedSegment(schema);
+        SealedLoader(datasets[i], *segment);
+        LoadIndexInfo vec_info;
+        vec_info.field_id = fakevec_id.get();
+        vec_info.index = indexings[i];
+        vec_info.index_params["metric_type"] = milvus::knowhere::Metric::L2;
+        if (manager.budget() > 0) {
+            // what AppendIndex keeps of the binaries it loads
+            vec_info.index_file = manager.SpillFile(manager.NextName("test_index"));
+            WriteBinarySet(vec_info.index_file, indexings[i]->Serialize(conf));
+        }
+        segment->LoadIndex(vec_info);
+        return segment;
+    };
+
+    std::vector<QueryResult> ref_results;
+    for (int i = 0; i < num_segments; ++i) {
+        auto segment = load(i);
+        ref_results.push_back(segment->Search(plan.get(), ph_group_arr.data(), &time, 1));
+    }
+
+    // room for about one segment at a time
+    manager.SetSpillPath("/tmp/milvus_test/residency");
+    manager.SetBudget(1500 * 1000);
+    auto before = manager.GetStatistics();
+    std::vector<SegmentSealedPtr> segments;
+    for (int i = 0; i < num_segments; ++i) {
+        segments.push_back(load(i));
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < num_segments; ++i) {
+            auto qr = segments[i]->Search(plan.get(), ph_group_arr.data(), &time, 1);
+            ASSERT_EQ(qr.internal_seg_offsets_, ref_results[i].internal_seg_offsets_);
+            ASSERT_EQ(qr.result_distances_, ref_results[i].result_distances_);
+            segments[i]->FillTargetEntry(plan.get(), qr);
+            ASSERT_EQ(qr.row_data_.size(), num_queries * topK);
+            ASSERT_LE(manager.GetStatistics().usage, manager.budget());
+        }
+    }
+    auto after = manager.GetStatistics();
+    ASSERT_GT(after.hits, before.hits);
+    ASSERT_GT(after.misses, before.misses);
+    ASSERT_GT(after.evictions, before.evictions);
+    ASSERT_GT(after.reloads, before.reloads);
+
+    segments.clear();
+    ASSERT_EQ(manager.GetStatistics().usage, 0);
+    manager.SetBudget(0);
+}
+
+TEST(Sealed, LoadIndexAsync) {
+    auto dim = 16;
+    auto topK = 5;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    Json vec_params = {{"metric_type", "L2"}, {"params", {{"nprobe", 16}}}, {"query", "$0"}, {"topk", topK}};
+    Json dsl = {{"bool", {{"must", {{{"vector", {{"fakevec", vec_params}}}}}}}}};
+    auto plan = CreatePlan(*schema, dsl.dump());
+    auto conf = knowhere::Config{{knowhere::meta::DIM, dim},
+                                 {knowhere::IndexParams::nlist, 16},
+                                 {knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+                                 {knowhere::meta::DEVICEID, 0}};
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(0);
+    auto database = knowhere::GenDataset(N, dim, fakevec.data());
+    auto indexing = std::make_shared<knowhere::IVFSQ>();
+    indexing->Train(database, conf);
+    indexing->AddWithoutIds(database, conf);
+
+    Timestamp time = 1000000;
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+
+    LoadIndexInfo vec_info;
+    vec_info.field_id = fakevec_id.get();
+    vec_info.index_params["index_type"] = milvus::knowhere::IndexEnum::INDEX_FAISS_IVFSQ8;
+    vec_info.index_params["metric_type"] = milvus::knowhere::Metric::L2;
+
+    auto ref_segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *ref_segment);
+    auto brute_force_result = ref_segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    vec_info.index = indexing;
+    ref_segment->LoadIndex(vec_info);
+    auto index_result = ref_segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    vec_info.index = nullptr;
+
+    // searches go on over the raw data while the index loads
+    auto segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *segment);
+    auto future = segment->LoadIndexAsync(vec_info, indexing->Serialize(conf));
+    while (!future->finished()) {
+        auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+        ASSERT_TRUE(qr.internal_seg_offsets_ == brute_force_result.internal_seg_offsets_ ||
+                    qr.internal_seg_offsets_ == index_result.internal_seg_offsets_);
+    }
+    future->Wait();
+    ASSERT_EQ(future->stage(), LoadIndexStage::DONE);
+    ASSERT_TRUE(segment->HasIndex(fakevec_id));
+    auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    ASSERT_EQ(qr.internal_seg_offsets_, index_result.internal_seg_offsets_);
+    ASSERT_EQ(qr.result_distances_, index_result.result_distances_);
+
+    // an async load replaces the index of the field
+    future = segment->LoadIndexAsync(vec_info, indexing->Serialize(conf));
+    future->Wait();
+    ASSERT_EQ(future->stage(), LoadIndexStage::DONE);
+    qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    ASSERT_EQ(qr.internal_seg_offsets_, index_result.internal_seg_offsets_);
+
+    // a failed load leaves the index in place
+    vec_info.index_params["index_type"] = "NOT_AN_INDEX";
+    future = segment->LoadIndexAsync(vec_info, indexing->Serialize(conf));
+    ASSERT_TRUE(future->WaitFor(60 * 1000));
+    ASSERT_EQ(future->stage(), LoadIndexStage::FAILED);
+    ASSERT_FALSE(future->error().empty());
+    ASSERT_TRUE(segment->HasIndex(fakevec_id));
+
+    // the segment waits for a load still running when it goes away
+    vec_info.index_params["index_type"] = milvus::knowhere::IndexEnum::INDEX_FAISS_IVFSQ8;
+    future = segment->LoadIndexAsync(vec_info, indexing->Serialize(conf));
+    segment.reset();
+    ASSERT_TRUE(future->finished());
+}
+
+TEST(Sealed, HotSwap) {
+    auto dim = 16;
+    auto topK = 5;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto double_id = schema->AddDebugField("double", DataType::DOUBLE);
+    Json vec_params = {{"metric_type", "L2"}, {"params", {{"nprobe", 16}}}, {"query", "$0"}, {"topk", topK}};
+    Json range = {{"range", {{"counter", {{"GE", -1000000}, {"LT", 1000000}}}}}};
+    Json dsl = {{"bool", {{"must", {range, {{"vector", {{"fakevec", vec_params}}}}}}}}};
+    auto plan = CreatePlan(*schema, dsl.dump());
+    auto conf = knowhere::Config{{knowhere::meta::DIM, dim},
+                                 {knowhere::IndexParams::nlist, 16},
+                                 {knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+                                 {knowhere::meta::DEVICEID, 0}};
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(0);
+    auto database = knowhere::GenDataset(N, dim, fakevec.data());
+    auto indexing = std::make_shared<knowhere::IVFSQ>();
+    indexing->Train(database, conf);
+    indexing->AddWithoutIds(database, conf);
+
+    Timestamp time = 1000000;
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    std::vector<const PlaceholderGroup*> ph_group_arr = {ph_group.get()};
+
+    LoadIndexInfo vec_info;
+    vec_info.field_id = fakevec_id.get();
+    vec_info.index = indexing;
+    vec_info.index_params["metric_type"] = milvus::knowhere::Metric::L2;
+
+    auto segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *segment);
+    auto brute_force_result = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+    segment->LoadIndex(vec_info);
+    auto index_result = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+
+    // searches run on the snapshot they started with, while fields the plan doesn't read come and go
+    // and the vector index is dropped and loaded again
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> searchers;
+    std::atomic<int64_t> num_searches = 0;
+    for (int i = 0; i < 4; ++i) {
+        searchers.emplace_back([&] {
+            while (!stop) {
+                auto qr = segment->Search(plan.get(), ph_group_arr.data(), &time, 1);
+                ASSERT_TRUE(qr.internal_seg_offsets_ == brute_force_result.internal_seg_offsets_ ||
+                            qr.internal_seg_offsets_ == index_result.internal_seg_offsets_);
+                segment->FillTargetEntry(plan.get(), qr);
+                ASSERT_EQ(qr.row_data_.size(), num_queries * topK);
+                ++num_searches;
+            }
+        });
+    }
+    auto double_col = dataset.get_col<double>(2);
+    for (int round = 0; round < 20; ++round) {
+        segment->DropIndex(fakevec_id);
+        segment->DropFieldData(double_id);
+        LoadFieldDataInfo info;
+        info.field_id = double_id.get();
+        info.blob = double_col.data();
+        info.row_count = N;
+        segment->LoadFieldData(info);
+        segment->LoadIndex(vec_info);
+    }
+    while (num_searches < 20) {
+        std::this_thread::yield();
+    }
+    stop = true;
+    for (auto& searcher : searchers) {
+        searcher.join();
+    }
+    ASSERT_TRUE(segment->HasIndex(fakevec_id));
+    ASSERT_TRUE(segment->HasFieldData(double_id));
+}
@@ -18,6 +18,9 @@
 // #include "segment/SegmentReader.h"
 // #include "segment/SegmentWriter.h"
 #include "segcore/SegmentGrowing.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include <faiss/IndexIVF.h>
+#include <knowhere/index/vector_index/adapter/VectorAdapter.h>
 // #include "utils/Json.h"
 #include "test_utils/DataGen.h"
 #include <random>
@@ -122,3 +125,62 @@ TEST(SegmentCoreTest, SmallIndex) {
     int N = 1024 * 1024;
     auto data = DataGen(schema, N);
 }
+
+TEST(SegmentCoreTest, SharedCoarseQuantizer) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+    auto seg_conf = SegcoreConfig::default_config();
+    seg_conf.set_size_per_chunk(4096);
+    auto pool = std::make_shared<CoarseQuantizerPool>();
+    int64_t num_chunk = 3;
+    int64_t N = num_chunk * 4096;
+
+    CoarseQuantizerPtr quantizer;
+    std::vector<SegmentGrowingPtr> segments;
+    for (int seg = 0; seg < 2; ++seg) {
+        auto dataset = DataGen(schema, N, 42 + seg);
+        auto segment = CreateGrowingSegment(schema, seg_conf, pool);
+        segment->PreInsert(N);
+        segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+        auto& impl = dynamic_cast<SegmentGrowingImpl&>(*segment);
+        auto& field_indexing = impl.get_indexing_record().get_vec_field_indexing(FieldOffset(0));
+        auto vecs = dataset.get_col<float>(0);
+        for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+            // all the chunks of all the segments search with the same centroids
+            auto chunk_quantizer = field_indexing.get_chunk_quantizer(chunk_id);
+            ASSERT_NE(chunk_quantizer, nullptr);
+            if (!quantizer) {
+                quantizer = chunk_quantizer;
+            }
+            ASSERT_EQ(chunk_quantizer, quantizer);
+            auto indexing = dynamic_cast<knowhere::IVF*>(field_indexing.get_chunk_indexing(chunk_id));
+            ASSERT_NE(indexing, nullptr);
+            auto ivf = dynamic_cast<faiss::IndexIVF*>(indexing->index_.get());
+            ASSERT_EQ(ivf->quantizer, quantizer->index_.get());
+            ASSERT_EQ(ivf->ntotal, 4096);
+
+            // a row of the chunk finds itself
+            auto query = knowhere::GenDataset(1, 16, vecs.data() + chunk_id * 4096 * 16);
+            auto result = indexing->Query(query, field_indexing.get_search_params(1), nullptr);
+            auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+            EXPECT_EQ(ids[0], 0);
+            free(ids);
+            free(result->Get<float*>(knowhere::meta::DISTANCE));
+        }
+        segments.push_back(std::move(segment));
+    }
+    EXPECT_EQ(quantizer->version_, 1);
+    EXPECT_EQ(pool->get(FieldOffset(0)), quantizer);
+
+    // a new version is used by the next chunks, the built ones keep theirs
+    std::vector<float> centroids(quantizer->index_->ntotal * 16);
+    quantizer->index_->reconstruct_n(0, quantizer->index_->ntotal, centroids.data());
+    auto next = pool->publish(FieldOffset(0), 16, MetricType::METRIC_L2, quantizer->index_->ntotal, centroids.data());
+    EXPECT_EQ(next->version_, 2);
+    EXPECT_EQ(pool->get(FieldOffset(0)), next);
+    auto& impl = dynamic_cast<SegmentGrowingImpl&>(*segments[0]);
+    EXPECT_EQ(impl.get_indexing_record().get_vec_field_indexing(FieldOffset(0)).get_chunk_quantizer(0), quantizer);
+}
@@ -134,6 +134,15 @@ DataGen(SchemaPtr schema, int64_t N, uint64_t seed = 42) {
                 insert_cols(data);
                 break;
             }
+            case engine::DataType::VECTOR_INT8: {
+                auto dim = field.get_dim();
+                vector<int8_t> data(dim * N);
+                for (auto& x : data) {
+                    x = er();
+                }
+                insert_cols(data);
+                break;
+            }
             case engine::DataType::INT64: {
                 vector<int64_t> data(N);
                 // begin with counter
@@ -271,6 +280,20 @@ CreateBinaryPlaceholderGroupFromBlob(int64_t num_queries, int64_t dim, const uin
     return raw_group;
 }
 
+inline auto
+CreateInt8PlaceholderGroupFromBlob(int64_t num_queries, int64_t dim, const int8_t* ptr) {
+    namespace ser = milvus::proto::milvus;
+    ser::PlaceholderGroup raw_group;
+    auto value = raw_group.add_placeholders();
+    value->set_tag("$0");
+    // the proto has no int8 placeholder type yet, only the size of the values is checked
+    value->set_type(static_cast<ser::PlaceholderType>(DataType::VECTOR_INT8));
+    for (int i = 0; i < num_queries; ++i) {
+        value->add_values(ptr + i * dim, dim);
+    }
+    return raw_group;
+}
+
 inline json
 QueryResultToJson(const QueryResult& qr) {
     int64_t num_queries = qr.num_queries_;
@@ -0,0 +1,102 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace wrapper {
+
+// bloom filter over int64 primary keys, kept in the payload footer so a reader can rule out keys
+// without decoding any page. serialized as num_bits (uint64), num_hashes (uint32), then the bit words.
+class BloomFilter {
+ public:
+  BloomFilter() = default;
+
+  BloomFilter(int64_t expected_keys, double fpp) {
+    expected_keys = std::max<int64_t>(expected_keys, 1);
+    fpp = std::min(std::max(fpp, 1e-9), 0.5);
+    auto bits = std::ceil(-expected_keys * std::log(fpp) / (std::log(2.0) * std::log(2.0)));
+    num_bits_ = std::max<uint64_t>(64, static_cast<uint64_t>(bits));
+    num_bits_ = (num_bits_ + 63) / 64 * 64;
+    num_hashes_ = static_cast<uint32_t>(std::max(1.0, std::round(-std::log(fpp) / std::log(2.0))));
+    words_.assign(num_bits_ / 64, 0);
+  }
+
+  void Add(int64_t key) {
+    uint64_t h1, h2;
+    Hash(key, h1, h2);
+    for (uint32_t i = 0; i < num_hashes_; i++) {
+      auto bit = (h1 + i * h2) % num_bits_;
+      words_[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+  }
+
+  bool MayContain(int64_t key) const {
+    if (num_bits_ == 0) return true;
+    uint64_t h1, h2;
+    Hash(key, h1, h2);
+    for (uint32_t i = 0; i < num_hashes_; i++) {
+      auto bit = (h1 + i * h2) % num_bits_;
+      if (!(words_[bit / 64] & (uint64_t(1) << (bit % 64)))) return false;
+    }
+    return true;
+  }
+
+  std::string Serialize() const {
+    std::string out(sizeof(num_bits_) + sizeof(num_hashes_) + words_.size() * sizeof(uint64_t), '\0');
+    auto dst = &out[0];
+    std::memcpy(dst, &num_bits_, sizeof(num_bits_));
+    std::memcpy(dst + sizeof(num_bits_), &num_hashes_, sizeof(num_hashes_));
+    std::memcpy(dst + sizeof(num_bits_) + sizeof(num_hashes_), words_.data(), words_.size() * sizeof(uint64_t));
+    return out;
+  }
+
+  bool Deserialize(const std::string &in) {
+    constexpr auto header = sizeof(num_bits_) + sizeof(num_hashes_);
+    if (in.size() < header) return false;
+    uint64_t num_bits;
+    uint32_t num_hashes;
+    std::memcpy(&num_bits, in.data(), sizeof(num_bits));
+    std::memcpy(&num_hashes, in.data() + sizeof(num_bits), sizeof(num_hashes));
+    if (num_bits == 0 || num_bits % 64 || in.size() != header + num_bits / 8) return false;
+    num_bits_ = num_bits;
+    num_hashes_ = num_hashes;
+    words_.resize(num_bits / 64);
+    std::memcpy(words_.data(), in.data() + header, num_bits / 8);
+    return true;
+  }
+
+ private:
+  // two independent 64-bit mixes of the key for double hashing
+  static void Hash(int64_t key, uint64_t &h1, uint64_t &h2) {
+    auto x = static_cast<uint64_t>(key);
+    h1 = Mix(x + 0x9e3779b97f4a7c15ULL);
+    h2 = Mix(h1 ^ 0xbf58476d1ce4e5b9ULL) | 1;
+  }
+
+  static uint64_t Mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  uint64_t num_bits_ = 0;
+  uint32_t num_hashes_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+}
@@ -9,6 +9,16 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <arrow/array/concatenate.h>
+#include <parquet/column_reader.h>
+#include <parquet/exception.h>
+#include <parquet/statistics.h>
 #include "ParquetWrapper.h"
 #include "PayloadStream.h"
 
@@ -27,6 +37,10 @@ extern "C" CPayloadWriter NewPayloadWriter(int columnType) {
   p->output = nullptr;
   p->dimension = wrapper::EMPTY_DIMENSION;
   p->rows = 0;
+  p->row_group_size = wrapper::DEFAULT_ROW_GROUP_SIZE;
+  p->compression = CompressionType::UNCOMPRESSED;
+  p->dictionary = true;
+  p->bloom_filter_fpp = 0;
   switch (static_cast<ColumnType>(columnType)) {
     case ColumnType::BOOL : {
       p->columnType = ColumnType::BOOL;
@@ -270,6 +284,115 @@ extern "C" CStatus AddFloatVectorToPayload(CPayloadWriter payloadWriter, float *
   return st;
 }
 
+extern "C" CStatus SetPayloadWriterRowGroupSize(CPayloadWriter payloadWriter, int64_t rows) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadWriter *>(payloadWriter);
+  if (p->output != nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("payload has finished");
+    return st;
+  }
+  if (rows <= 0) {
+    st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+    st.error_msg = ErrorMsg("row group size must be positive");
+    return st;
+  }
+  p->row_group_size = rows;
+  return st;
+}
+
+static parquet::Compression::type ParquetCompression(CompressionType compression) {
+  switch (compression) {
+    case CompressionType::LZ4 : return parquet::Compression::LZ4;
+    case CompressionType::ZSTD : return parquet::Compression::ZSTD;
+    default: return parquet::Compression::UNCOMPRESSED;
+  }
+}
+
+extern "C" CStatus SetPayloadWriterCompression(CPayloadWriter payloadWriter, int compressionType) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadWriter *>(payloadWriter);
+  if (p->output != nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("payload has finished");
+    return st;
+  }
+  switch (compressionType) {
+    case CompressionType::UNCOMPRESSED :
+    case CompressionType::LZ4 :
+    case CompressionType::ZSTD : {
+      break;
+    }
+    default: {
+      st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+      st.error_msg = ErrorMsg("unknown compression type");
+      return st;
+    }
+  }
+  auto compression = static_cast<CompressionType>(compressionType);
+  if (!parquet::IsCodecSupported(ParquetCompression(compression))) {
+    st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+    st.error_msg = ErrorMsg("compression type is not built in");
+    return st;
+  }
+  p->compression = compression;
+  return st;
+}
+
+extern "C" CStatus SetPayloadWriterDictionary(CPayloadWriter payloadWriter, bool enable) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadWriter *>(payloadWriter);
+  if (p->output != nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("payload has finished");
+    return st;
+  }
+  p->dictionary = enable;
+  return st;
+}
+
+static std::shared_ptr<parquet::WriterProperties> PayloadWriterProperties(wrapper::PayloadWriter *p) {
+  parquet::WriterProperties::Builder builder;
+  builder.compression(ParquetCompression(p->compression));
+  if (p->columnType == ColumnType::VECTOR_BINARY || p->columnType == ColumnType::VECTOR_FLOAT) {
+    // vectors go into plain pages that read back with a memcpy, dictionary and min/max don't pay off for them
+    builder.disable_dictionary()->encoding(parquet::Encoding::PLAIN)->disable_statistics();
+  } else if (!p->dictionary) {
+    builder.disable_dictionary();
+  }
+  return builder.build();
+}
+
+extern "C" CStatus SetPayloadWriterBloomFilter(CPayloadWriter payloadWriter, double fpp) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadWriter *>(payloadWriter);
+  if (p->output != nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("payload has finished");
+    return st;
+  }
+  if (p->columnType != ColumnType::INT64) {
+    st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+    st.error_msg = ErrorMsg("bloom filter only supports int64 column");
+    return st;
+  }
+  if (!(fpp > 0 && fpp < 1)) {
+    st.error_code = static_cast<int>(ErrorCode::ILLEGAL_ARGUMENT);
+    st.error_msg = ErrorMsg("false positive rate must be in (0, 1)");
+    return st;
+  }
+  p->bloom_filter_fpp = fpp;
+  return st;
+}
+
 extern "C" CStatus FinishPayloadWriter(CPayloadWriter payloadWriter) {
   CStatus st;
   st.error_code = static_cast<int>(ErrorCode::SUCCESS);
@@ -288,18 +411,146 @@ extern "C" CStatus FinishPayloadWriter(CPayloadWriter payloadWriter) {
       st.error_msg = ErrorMsg(ast.message());
       return st;
     }
-    auto table = arrow::Table::Make(p->schema, {array});
+    auto schema = p->schema;
+    if (p->bloom_filter_fpp > 0) {
+      auto values = std::static_pointer_cast<arrow::Int64Array>(array);
+      wrapper::BloomFilter filter(values->length(), p->bloom_filter_fpp);
+      for (int64_t i = 0; i < values->length(); i++) {
+        if (values->IsValid(i)) filter.Add(values->Value(i));
+      }
+      schema = schema->WithMetadata(arrow::key_value_metadata({wrapper::BLOOM_FILTER_KEY}, {filter.Serialize()}));
+    }
+    auto table = arrow::Table::Make(schema, {array});
     p->output = std::make_shared<wrapper::PayloadOutputStream>();
-    ast = parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), p->output, 1024 * 1024 * 1024);
+    // schema metadata only reaches the footer along with the stored arrow schema
+    auto arrow_properties = p->bloom_filter_fpp > 0 ? parquet::ArrowWriterProperties::Builder().store_schema()->build()
+                                                    : parquet::default_arrow_writer_properties();
+    ast = parquet::arrow::WriteTable(*table,
+                                     arrow::default_memory_pool(),
+                                     p->output,
+                                     p->row_group_size,
+                                     PayloadWriterProperties(p),
+                                     arrow_properties);
     if (!ast.ok()) {
       st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
       st.error_msg = ErrorMsg(ast.message());
       return st;
     }
+    try {
+      auto &output = p->output->Buffer();
+      p->metadata = parquet::ReadMetaData(std::make_shared<wrapper::PayloadInputStream>(output.data(), output.size()));
+    } catch (std::exception &e) {
+      st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+      st.error_msg = ErrorMsg(e.what());
+      return st;
+    }
   }
   return st;
 }
 
+template<typename ST, typename T>
+static void MergeMinMax(const parquet::Statistics &statistics, T &min, T &max) {
+  auto &typed = static_cast<const ST &>(statistics);
+  min = std::min<T>(min, typed.min());
+  max = std::max<T>(max, typed.max());
+}
+
+// merge the column chunk statistics of all row groups, only the footer is touched
+static void PayloadStatistics(const parquet::FileMetaData &metadata, ColumnType column_type, CPayloadStatistics *out) {
+  out->num_rows = metadata.num_rows();
+  out->null_count = 0;
+  out->min_int = std::numeric_limits<int64_t>::max();
+  out->max_int = std::numeric_limits<int64_t>::min();
+  out->min_double = std::numeric_limits<double>::infinity();
+  out->max_double = -std::numeric_limits<double>::infinity();
+  out->has_min_max = false;
+  out->has_bloom_filter = false;
+  auto kv = metadata.key_value_metadata();
+  if (kv != nullptr && kv->FindKey(wrapper::BLOOM_FILTER_KEY) >= 0) out->has_bloom_filter = true;
+
+  switch (column_type) {
+    case ColumnType::BOOL :
+    case ColumnType::INT8 :
+    case ColumnType::INT16 :
+    case ColumnType::INT32 :
+    case ColumnType::INT64 :
+    case ColumnType::FLOAT :
+    case ColumnType::DOUBLE : {
+      out->has_min_max = true;
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  bool has_values = false;
+  for (int i = 0; i < metadata.num_row_groups(); i++) {
+    auto chunk = metadata.RowGroup(i)->ColumnChunk(0);
+    if (chunk->num_values() == 0) continue;
+    auto statistics = chunk->is_stats_set() ? chunk->statistics() : nullptr;
+    if (statistics == nullptr) {
+      out->null_count = -1;
+      out->has_min_max = false;
+      break;
+    }
+    if (!statistics->HasNullCount()) {
+      out->null_count = -1;
+    } else if (out->null_count >= 0) {
+      out->null_count += statistics->null_count();
+    }
+    if (!out->has_min_max) continue;
+    if (!statistics->HasMinMax()) {
+      // a row group of nulls only has no min max and doesn't widen the range
+      if (statistics->HasNullCount() && statistics->null_count() == chunk->num_values()) continue;
+      out->has_min_max = false;
+      continue;
+    }
+    has_values = true;
+    switch (column_type) {
+      case ColumnType::BOOL : {
+        MergeMinMax<parquet::BoolStatistics>(*statistics, out->min_int, out->max_int);
+        break;
+      }
+      case ColumnType::INT8 :
+      case ColumnType::INT16 :
+      case ColumnType::INT32 : {
+        MergeMinMax<parquet::Int32Statistics>(*statistics, out->min_int, out->max_int);
+        break;
+      }
+      case ColumnType::INT64 : {
+        MergeMinMax<parquet::Int64Statistics>(*statistics, out->min_int, out->max_int);
+        break;
+      }
+      case ColumnType::FLOAT : {
+        MergeMinMax<parquet::FloatStatistics>(*statistics, out->min_double, out->max_double);
+        break;
+      }
+      case ColumnType::DOUBLE : {
+        MergeMinMax<parquet::DoubleStatistics>(*statistics, out->min_double, out->max_double);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+  if (!has_values) out->has_min_max = false;
+}
+
+extern "C" CStatus GetPayloadStatisticsFromWriter(CPayloadWriter payloadWriter, CPayloadStatistics *statistics) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadWriter *>(payloadWriter);
+  if (p->metadata == nullptr) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("payload has not finished");
+    return st;
+  }
+  PayloadStatistics(*p->metadata, p->columnType, statistics);
+  return st;
+}
+
 CBuffer GetPayloadBufferFromWriter(CPayloadWriter payloadWriter) {
   CBuffer buf;
 
@@ -330,24 +581,6 @@ extern "C" CStatus ReleasePayloadWriter(CPayloadWriter handler) {
 }
 
 extern "C" CPayloadReader NewPayloadReader(int columnType, uint8_t *buffer, int64_t buf_size) {
-  auto p = new wrapper::PayloadReader;
-  p->bValues = nullptr;
-  p->input = std::make_shared<wrapper::PayloadInputStream>(buffer, buf_size);
-  auto st = parquet::arrow::OpenFile(p->input, arrow::default_memory_pool(), &p->reader);
-  if (!st.ok()) {
-    delete p;
-    return nullptr;
-  }
-  st = p->reader->ReadTable(&p->table);
-  if (!st.ok()) {
-    delete p;
-    return nullptr;
-  }
-  p->column = p->table->column(0);
-  assert(p->column != nullptr);
-  assert(p->column->chunks().size() == 1);
-  p->array = p->column->chunk(0);
-
   switch (columnType) {
     case ColumnType::BOOL :
     case ColumnType::INT8 :
@@ -362,18 +595,53 @@ extern "C" CPayloadReader NewPayloadReader(int columnType, uint8_t *buffer, int6
       break;
     }
     default: {
-      delete p;
       return nullptr;
     }
   }
+
+  auto p = new wrapper::PayloadReader;
+  p->column_type = static_cast<ColumnType>(columnType);
+  p->bValues = nullptr;
+  p->input = std::make_shared<wrapper::PayloadInputStream>(buffer, buf_size);
+  // only the footer is parsed here, column data is decoded on demand
+  auto st = parquet::arrow::OpenFile(p->input, arrow::default_memory_pool(), &p->reader);
+  if (!st.ok()) {
+    delete p;
+    return nullptr;
+  }
+  p->metadata = p->reader->parquet_reader()->metadata();
+  if (p->metadata->num_columns() != 1) {
+    delete p;
+    return nullptr;
+  }
   return reinterpret_cast<CPayloadReader>(p);
 }
 
+static arrow::Status LoadPayloadArray(wrapper::PayloadReader *p) {
+  if (p->array != nullptr) return arrow::Status::OK();
+  ARROW_RETURN_NOT_OK(p->reader->ReadTable(&p->table));
+  p->column = p->table->column(0);
+  if (p->column->num_chunks() == 1) {
+    p->array = p->column->chunk(0);
+  } else if (p->column->num_chunks() == 0) {
+    ARROW_ASSIGN_OR_RAISE(p->array, arrow::MakeArrayOfNull(p->column->type(), 0));
+  } else {
+    ARROW_ASSIGN_OR_RAISE(p->array, arrow::Concatenate(p->column->chunks(), arrow::default_memory_pool()));
+  }
+  return arrow::Status::OK();
+}
+
 extern "C" CStatus GetBoolFromPayload(CPayloadReader payloadReader, bool **values, int *length) {
   CStatus st;
   st.error_code = static_cast<int>(ErrorCode::SUCCESS);
   st.error_msg = nullptr;
   auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  auto ast = LoadPayloadArray(p);
+  if (!ast.ok()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(ast.message());
+    return st;
+  }
   if (p->bValues == nullptr) {
     auto array = std::dynamic_pointer_cast<arrow::BooleanArray>(p->array);
     if (array == nullptr) {
@@ -398,6 +666,12 @@ CStatus GetValuesFromPayload(CPayloadReader payloadReader, DT **values, int *len
   st.error_code = static_cast<int>(ErrorCode::SUCCESS);
   st.error_msg = nullptr;
   auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  auto ast = LoadPayloadArray(p);
+  if (!ast.ok()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(ast.message());
+    return st;
+  }
   auto array = std::dynamic_pointer_cast<AT>(p->array);
   if (array == nullptr) {
     st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
@@ -432,6 +706,12 @@ extern "C" CStatus GetOneStringFromPayload(CPayloadReader payloadReader, int idx
   st.error_code = static_cast<int>(ErrorCode::SUCCESS);
   st.error_msg = nullptr;
   auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  auto ast = LoadPayloadArray(p);
+  if (!ast.ok()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(ast.message());
+    return st;
+  }
   auto array = std::dynamic_pointer_cast<arrow::StringArray>(p->array);
   if (array == nullptr) {
     st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
@@ -456,6 +736,12 @@ extern "C" CStatus GetBinaryVectorFromPayload(CPayloadReader payloadReader,
   st.error_code = static_cast<int>(ErrorCode::SUCCESS);
   st.error_msg = nullptr;
   auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  auto ast = LoadPayloadArray(p);
+  if (!ast.ok()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(ast.message());
+    return st;
+  }
   auto array = std::dynamic_pointer_cast<arrow::FixedSizeBinaryArray>(p->array);
   if (array == nullptr) {
     st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
@@ -475,6 +761,12 @@ extern "C" CStatus GetFloatVectorFromPayload(CPayloadReader payloadReader,
   st.error_code = static_cast<int>(ErrorCode::SUCCESS);
   st.error_msg = nullptr;
   auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  auto ast = LoadPayloadArray(p);
+  if (!ast.ok()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(ast.message());
+    return st;
+  }
   auto array = std::dynamic_pointer_cast<arrow::FixedSizeBinaryArray>(p->array);
   if (array == nullptr) {
     st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
@@ -489,8 +781,251 @@ extern "C" CStatus GetFloatVectorFromPayload(CPayloadReader payloadReader,
 
 extern "C" int GetPayloadLengthFromReader(CPayloadReader payloadReader) {
   auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
-  if (p->array == nullptr) return 0;
-  return p->array->length();
+  return static_cast<int>(p->metadata->num_rows());
+}
+
+extern "C" int GetPayloadRowGroupCountFromReader(CPayloadReader payloadReader) {
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  return p->metadata->num_row_groups();
+}
+
+extern "C" int GetPayloadRowGroupLengthFromReader(CPayloadReader payloadReader, int rowGroup) {
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  if (rowGroup < 0 || rowGroup >= p->metadata->num_row_groups()) return -1;
+  return static_cast<int>(p->metadata->RowGroup(rowGroup)->num_rows());
+}
+
+extern "C" int GetPayloadRowWidthFromReader(CPayloadReader payloadReader) {
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  switch (p->column_type) {
+    case ColumnType::BOOL : return sizeof(bool);
+    case ColumnType::INT8 : return sizeof(int8_t);
+    case ColumnType::INT16 : return sizeof(int16_t);
+    case ColumnType::INT32 : return sizeof(int32_t);
+    case ColumnType::INT64 : return sizeof(int64_t);
+    case ColumnType::FLOAT : return sizeof(float);
+    case ColumnType::DOUBLE : return sizeof(double);
+    case ColumnType::VECTOR_BINARY :
+    case ColumnType::VECTOR_FLOAT : return p->metadata->schema()->Column(0)->type_length();
+    default: return 0;
+  }
+}
+
+constexpr int64_t ROW_GROUP_BATCH_SIZE = 64 * 1024;
+
+// decode one column chunk into dst, narrowing the physical type to DT when they differ
+template<typename PT, typename DT>
+static void DecodeColumnChunk(parquet::ColumnReader *column, int64_t num_rows, DT *dst) {
+  using T = typename PT::c_type;
+  auto reader = static_cast<parquet::TypedColumnReader<PT> *>(column);
+  auto batch_size = std::min(num_rows, ROW_GROUP_BATCH_SIZE);
+  std::vector<int16_t> def_levels(batch_size);
+  std::vector<T> values;
+  if constexpr (!std::is_same_v<T, DT>) values.resize(batch_size);
+
+  int64_t rows = 0;
+  while (rows < num_rows) {
+    auto batch = std::min(num_rows - rows, batch_size);
+    T *out;
+    if constexpr (std::is_same_v<T, DT>) {
+      out = dst + rows;
+    } else {
+      out = values.data();
+    }
+    int64_t values_read = 0;
+    auto levels_read = reader->ReadBatch(batch, def_levels.data(), nullptr, out, &values_read);
+    if (levels_read == 0) throw parquet::ParquetException("row group is truncated");
+    if (values_read != levels_read) throw parquet::ParquetException("null values can't be decoded into a buffer");
+    if constexpr (!std::is_same_v<T, DT>) {
+      for (int64_t i = 0; i < values_read; i++) {
+        dst[rows + i] = static_cast<DT>(values[i]);
+      }
+    }
+    rows += values_read;
+  }
+}
+
+static void DecodeFixedLenColumnChunk(parquet::ColumnReader *column, int64_t num_rows, int width, uint8_t *dst) {
+  auto reader = static_cast<parquet::FixedLenByteArrayReader *>(column);
+  auto batch_size = std::min(num_rows, ROW_GROUP_BATCH_SIZE);
+  std::vector<int16_t> def_levels(batch_size);
+  std::vector<parquet::FixedLenByteArray> values(batch_size);
+
+  int64_t rows = 0;
+  while (rows < num_rows) {
+    auto batch = std::min(num_rows - rows, batch_size);
+    int64_t values_read = 0;
+    auto levels_read = reader->ReadBatch(batch, def_levels.data(), nullptr, values.data(), &values_read);
+    if (levels_read == 0) throw parquet::ParquetException("row group is truncated");
+    if (values_read != levels_read) throw parquet::ParquetException("null values can't be decoded into a buffer");
+    for (int64_t i = 0; i < values_read; i++) {
+      std::memcpy(dst + (rows + i) * width, values[i].ptr, width);
+    }
+    rows += values_read;
+  }
+}
+
+static void DecodeRowGroup(parquet::ParquetFileReader *file_reader,
+                           ColumnType column_type,
+                           int row_group,
+                           int width,
+                           uint8_t *dst) {
+  auto group = file_reader->RowGroup(row_group);
+  auto num_rows = group->metadata()->num_rows();
+  auto column = group->Column(0);
+  switch (column_type) {
+    case ColumnType::BOOL :
+      DecodeColumnChunk<parquet::BooleanType>(column.get(), num_rows, reinterpret_cast<bool *>(dst));
+      break;
+    case ColumnType::INT8 :
+      DecodeColumnChunk<parquet::Int32Type>(column.get(), num_rows, reinterpret_cast<int8_t *>(dst));
+      break;
+    case ColumnType::INT16 :
+      DecodeColumnChunk<parquet::Int32Type>(column.get(), num_rows, reinterpret_cast<int16_t *>(dst));
+      break;
+    case ColumnType::INT32 :
+      DecodeColumnChunk<parquet::Int32Type>(column.get(), num_rows, reinterpret_cast<int32_t *>(dst));
+      break;
+    case ColumnType::INT64 :
+      DecodeColumnChunk<parquet::Int64Type>(column.get(), num_rows, reinterpret_cast<int64_t *>(dst));
+      break;
+    case ColumnType::FLOAT :
+      DecodeColumnChunk<parquet::FloatType>(column.get(), num_rows, reinterpret_cast<float *>(dst));
+      break;
+    case ColumnType::DOUBLE :
+      DecodeColumnChunk<parquet::DoubleType>(column.get(), num_rows, reinterpret_cast<double *>(dst));
+      break;
+    case ColumnType::VECTOR_BINARY :
+    case ColumnType::VECTOR_FLOAT :
+      DecodeFixedLenColumnChunk(column.get(), num_rows, width, dst);
+      break;
+    default:
+      throw parquet::ParquetException("incorrect data type");
+  }
+}
+
+static parquet::Type::type PhysicalType(ColumnType column_type) {
+  switch (column_type) {
+    case ColumnType::BOOL : return parquet::Type::BOOLEAN;
+    case ColumnType::INT8 :
+    case ColumnType::INT16 :
+    case ColumnType::INT32 : return parquet::Type::INT32;
+    case ColumnType::INT64 : return parquet::Type::INT64;
+    case ColumnType::FLOAT : return parquet::Type::FLOAT;
+    case ColumnType::DOUBLE : return parquet::Type::DOUBLE;
+    case ColumnType::VECTOR_BINARY :
+    case ColumnType::VECTOR_FLOAT : return parquet::Type::FIXED_LEN_BYTE_ARRAY;
+    default: return parquet::Type::UNDEFINED;
+  }
+}
+
+extern "C" CStatus GetRowGroupsFromPayload(CPayloadReader payloadReader,
+                                           int firstRowGroup,
+                                           int numRowGroups,
+                                           void *buffer,
+                                           int64_t bufSize,
+                                           int numThreads) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  if (firstRowGroup < 0 || numRowGroups < 0 || firstRowGroup + numRowGroups > p->metadata->num_row_groups()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("row group out of range");
+    return st;
+  }
+  auto physical_type = PhysicalType(p->column_type);
+  if (physical_type == parquet::Type::UNDEFINED || p->metadata->schema()->Column(0)->physical_type() != physical_type) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("incorrect data type");
+    return st;
+  }
+
+  // row groups land back to back in the buffer, in file order
+  int width = GetPayloadRowWidthFromReader(payloadReader);
+  std::vector<int64_t> offsets(numRowGroups + 1, 0);
+  for (int i = 0; i < numRowGroups; i++) {
+    offsets[i + 1] = offsets[i] + p->metadata->RowGroup(firstRowGroup + i)->num_rows() * width;
+  }
+  if (offsets[numRowGroups] > bufSize) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg("buffer is too small");
+    return st;
+  }
+  if (numRowGroups == 0) return st;
+
+  // each worker owns a file reader over the shared input and footer, and takes the next row group in turn
+  std::atomic<int> next(0);
+  std::mutex error_mutex;
+  std::string error;
+  auto worker = [&]() {
+    try {
+      auto file_reader = parquet::ParquetFileReader::Open(p->input, parquet::default_reader_properties(), p->metadata);
+      for (auto i = next++; i < numRowGroups; i = next++) {
+        DecodeRowGroup(file_reader.get(), p->column_type, firstRowGroup + i, width,
+                       reinterpret_cast<uint8_t *>(buffer) + offsets[i]);
+      }
+    } catch (std::exception &e) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error.empty()) error = e.what();
+      next = numRowGroups;
+    }
+  };
+
+  auto num_workers = std::max(1, std::min(numThreads, numRowGroups));
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_workers; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  if (!error.empty()) {
+    st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+    st.error_msg = ErrorMsg(error);
+  }
+  return st;
+}
+
+extern "C" CStatus GetPayloadStatisticsFromReader(CPayloadReader payloadReader, CPayloadStatistics *statistics) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  PayloadStatistics(*p->metadata, p->column_type, statistics);
+  return st;
+}
+
+extern "C" CStatus PayloadMayContainPrimaryKeys(CPayloadReader payloadReader,
+                                                int64_t *keys,
+                                                int length,
+                                                bool *mayContain) {
+  CStatus st;
+  st.error_code = static_cast<int>(ErrorCode::SUCCESS);
+  st.error_msg = nullptr;
+  auto p = reinterpret_cast<wrapper::PayloadReader *>(payloadReader);
+  if (p->bloom_filter == nullptr) {
+    auto kv = p->metadata->key_value_metadata();
+    auto index = kv == nullptr ? -1 : kv->FindKey(wrapper::BLOOM_FILTER_KEY);
+    if (index < 0) {
+      // without a filter every key may be in the payload
+      std::fill(mayContain, mayContain + length, true);
+      return st;
+    }
+    auto filter = std::make_unique<wrapper::BloomFilter>();
+    if (!filter->Deserialize(kv->value(index))) {
+      st.error_code = static_cast<int>(ErrorCode::UNEXPECTED_ERROR);
+      st.error_msg = ErrorMsg("corrupted bloom filter");
+      return st;
+    }
+    p->bloom_filter = std::move(filter);
+  }
+  for (int i = 0; i < length; i++) {
+    mayContain[i] = p->bloom_filter->MayContain(keys[i]);
+  }
+  return st;
 }
 
 extern "C" CStatus ReleasePayloadReader(CPayloadReader payloadReader) {
@@ -30,6 +30,20 @@ typedef struct CStatus {
   const char *error_msg;
 } CStatus;
 
+// column statistics of a payload, read from the parquet footer
+typedef struct CPayloadStatistics {
+  int64_t num_rows;
+  int64_t null_count; // -1 if unknown
+  bool has_min_max; // numeric and bool columns with at least one value
+  // bool and integers widened to int64
+  int64_t min_int;
+  int64_t max_int;
+  // float and double widened to double
+  double min_double;
+  double max_double;
+  bool has_bloom_filter;
+} CPayloadStatistics;
+
 CPayloadWriter NewPayloadWriter(int columnType);
 CStatus AddBooleanToPayload(CPayloadWriter payloadWriter, bool *values, int length);
 CStatus AddInt8ToPayload(CPayloadWriter payloadWriter, int8_t *values, int length);
@@ -42,7 +56,15 @@ CStatus AddOneStringToPayload(CPayloadWriter payloadWriter, char *cstr, int str_
 CStatus AddBinaryVectorToPayload(CPayloadWriter payloadWriter, uint8_t *values, int dimension, int length);
 CStatus AddFloatVectorToPayload(CPayloadWriter payloadWriter, float *values, int dimension, int length);
 
+// writer properties, only take effect when set before FinishPayloadWriter
+CStatus SetPayloadWriterRowGroupSize(CPayloadWriter payloadWriter, int64_t rows);
+CStatus SetPayloadWriterCompression(CPayloadWriter payloadWriter, int compressionType);
+CStatus SetPayloadWriterDictionary(CPayloadWriter payloadWriter, bool enable);
+// keep a bloom filter of the int64 primary keys in the footer, fpp is the target false positive rate
+CStatus SetPayloadWriterBloomFilter(CPayloadWriter payloadWriter, double fpp);
+
 CStatus FinishPayloadWriter(CPayloadWriter payloadWriter);
+CStatus GetPayloadStatisticsFromWriter(CPayloadWriter payloadWriter, CPayloadStatistics *statistics);
 CBuffer GetPayloadBufferFromWriter(CPayloadWriter payloadWriter);
 int GetPayloadLengthFromWriter(CPayloadWriter payloadWriter);
 CStatus ReleasePayloadWriter(CPayloadWriter handler);
@@ -63,6 +85,23 @@ CStatus GetBinaryVectorFromPayload(CPayloadReader payloadReader, uint8_t **value
 CStatus GetFloatVectorFromPayload(CPayloadReader payloadReader, float **values, int *dimension, int *length);
 
 int GetPayloadLengthFromReader(CPayloadReader payloadReader);
+
+// row group access, decodes straight into the caller's buffer without materializing the whole payload
+int GetPayloadRowGroupCountFromReader(CPayloadReader payloadReader);
+int GetPayloadRowGroupLengthFromReader(CPayloadReader payloadReader, int rowGroup);
+// bytes one row takes in the buffer, 0 for variable length types
+int GetPayloadRowWidthFromReader(CPayloadReader payloadReader);
+CStatus GetRowGroupsFromPayload(CPayloadReader payloadReader,
+                                int firstRowGroup,
+                                int numRowGroups,
+                                void *buffer,
+                                int64_t bufSize,
+                                int numThreads);
+
+// footer only, no page is decoded
+CStatus GetPayloadStatisticsFromReader(CPayloadReader payloadReader, CPayloadStatistics *statistics);
+// false if a key is surely not in the payload, true for every key if the payload has no bloom filter
+CStatus PayloadMayContainPrimaryKeys(CPayloadReader payloadReader, int64_t *keys, int length, bool *mayContain);
 CStatus ReleasePayloadReader(CPayloadReader payloadReader);
 
 #ifdef __cplusplus
@@ -9,13 +9,16 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include "PayloadStream.h"
 
 namespace wrapper {
 
-PayloadOutputStream::PayloadOutputStream() {
-  buffer_.reserve(1024 * 1024);
-  closed_ = false;
+constexpr int64_t MIN_CHUNK_SIZE = 64 * 1024;
+constexpr int64_t MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+PayloadOutputStream::PayloadOutputStream() :
+    chunk_capacity_(0), last_chunk_size_(0), size_(0), closed_(false) {
 }
 
 PayloadOutputStream::~PayloadOutputStream() noexcept {
@@ -28,7 +31,7 @@ arrow::Status PayloadOutputStream::Close() {
 }
 
 arrow::Result<int64_t> PayloadOutputStream::Tell() const {
-  return arrow::Result<int64_t>(buffer_.size());
+  return arrow::Result<int64_t>(size_);
 }
 
 bool PayloadOutputStream::closed() const {
@@ -36,10 +39,21 @@ bool PayloadOutputStream::closed() const {
 }
 
 arrow::Status PayloadOutputStream::Write(const void *data, int64_t nbytes) {
-  if (nbytes <= 0) return arrow::Status::OK();
-  auto size = buffer_.size();
-  buffer_.resize(size + nbytes);
-  std::memcpy(buffer_.data() + size, data, nbytes);
+  auto src = reinterpret_cast<const uint8_t *>(data);
+  while (nbytes > 0) {
+    if (chunks_.empty() || last_chunk_size_ == chunk_capacity_) {
+      // chunks double up to MAX_CHUNK_SIZE, small payloads stay small
+      chunk_capacity_ = chunks_.empty() ? MIN_CHUNK_SIZE : std::min(chunk_capacity_ * 2, MAX_CHUNK_SIZE);
+      chunks_.emplace_back(new uint8_t[chunk_capacity_]);
+      last_chunk_size_ = 0;
+    }
+    auto n = std::min(nbytes, chunk_capacity_ - last_chunk_size_);
+    std::memcpy(chunks_.back().get() + last_chunk_size_, src, n);
+    last_chunk_size_ += n;
+    size_ += n;
+    src += n;
+    nbytes -= n;
+  }
   return arrow::Status::OK();
 }
 
@@ -47,7 +61,19 @@ arrow::Status PayloadOutputStream::Flush() {
   return arrow::Status::OK();
 }
 
-const std::vector<uint8_t> &PayloadOutputStream::Buffer() const {
+const std::vector<uint8_t> &PayloadOutputStream::Buffer() {
+  if (!chunks_.empty()) {
+    buffer_.reserve(size_);
+    auto capacity = MIN_CHUNK_SIZE;
+    for (size_t i = 0; i < chunks_.size(); i++) {
+      auto n = (i + 1 == chunks_.size()) ? last_chunk_size_ : capacity;
+      buffer_.insert(buffer_.end(), chunks_[i].get(), chunks_[i].get() + n);
+      capacity = std::min(capacity * 2, MAX_CHUNK_SIZE);
+    }
+    chunks_.clear();
+    chunk_capacity_ = 0;
+    last_chunk_size_ = 0;
+  }
   return buffer_;
 }
 
@@ -98,5 +124,25 @@ arrow::Result<int64_t> PayloadInputStream::GetSize() {
   return arrow::Result<int64_t>(size_);
 }
 
+bool PayloadInputStream::supports_zero_copy() const {
+  return true;
+}
+
+arrow::Result<int64_t> PayloadInputStream::ReadAt(int64_t position, int64_t nbytes, void *out) {
+  if (position < 0 || position > size_) return arrow::Status::IOError("invalid position");
+  auto remain = size_ - position;
+  if (nbytes > remain) nbytes = remain;
+  std::memcpy(out, data_ + position, nbytes);
+  return arrow::Result<int64_t>(nbytes);
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> PayloadInputStream::ReadAt(int64_t position, int64_t nbytes) {
+  if (position < 0 || position > size_) return arrow::Status::IOError("invalid position");
+  auto remain = size_ - position;
+  if (nbytes > remain) nbytes = remain;
+  auto buf = std::make_shared<arrow::Buffer>(data_ + position, nbytes);
+  return arrow::Result<std::shared_ptr<arrow::Buffer>>(buf);
+}
+
 }
 
@@ -15,6 +15,8 @@
 #include <arrow/io/interfaces.h>
 #include <parquet/arrow/writer.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include "BloomFilter.h"
 #include "ColumnType.h"
 
 namespace wrapper {
@@ -23,6 +25,9 @@ class PayloadOutputStream;
 class PayloadInputStream;
 
 constexpr int EMPTY_DIMENSION = -1;
+constexpr int64_t DEFAULT_ROW_GROUP_SIZE = 1024 * 1024 * 1024;
+// footer key of the primary key bloom filter
+constexpr const char *BLOOM_FILTER_KEY = "milvus.pk_bloom_filter";
 
 struct PayloadWriter {
   ColumnType columnType;
@@ -31,16 +36,24 @@ struct PayloadWriter {
   std::shared_ptr<arrow::Schema> schema;
   std::shared_ptr<PayloadOutputStream> output;
   int rows;
+  int64_t row_group_size;
+  CompressionType compression;
+  bool dictionary; // scalar columns only, vectors are always plain encoded
+  double bloom_filter_fpp; // int64 columns only, 0 for no bloom filter
+  std::shared_ptr<parquet::FileMetaData> metadata; // footer of the finished payload
 };
 
 struct PayloadReader {
   ColumnType column_type;
   std::shared_ptr<PayloadInputStream> input;
+  std::shared_ptr<parquet::FileMetaData> metadata;
   std::unique_ptr<parquet::arrow::FileReader> reader;
+  // decoded on the first whole-payload Get call, row group reads bypass it
   std::shared_ptr<arrow::Table> table;
   std::shared_ptr<arrow::ChunkedArray> column;
   std::shared_ptr<arrow::Array> array;
   bool *bValues;
+  std::unique_ptr<BloomFilter> bloom_filter; // loaded from the footer on first use
 };
 
 class PayloadOutputStream : public arrow::io::OutputStream {
@@ -55,9 +68,15 @@ class PayloadOutputStream : public arrow::io::OutputStream {
   arrow::Status Flush() override;
 
  public:
-  const std::vector<uint8_t> &Buffer() const;
+  // the written bytes as one contiguous buffer, chunks are merged into it on the first call after a write
+  const std::vector<uint8_t> &Buffer();
 
  private:
+  // writes append to fixed chunks so the stream never re-allocates and copies what it already holds
+  std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+  int64_t chunk_capacity_;
+  int64_t last_chunk_size_;
+  int64_t size_;
   std::vector<uint8_t> buffer_;
   bool closed_;
 };
@@ -74,13 +93,17 @@ class PayloadInputStream : public arrow::io::RandomAccessFile {
   arrow::Result<int64_t> Read(int64_t nbytes, void *out) override;
   arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override;
   arrow::Result<int64_t> GetSize() override;
+  bool supports_zero_copy() const override;
+
+  // positional reads don't touch tell_, so row groups can be decoded concurrently
+  arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void *out) override;
+  arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(int64_t position, int64_t nbytes) override;
 
  private:
   const uint8_t *data_;
   const int64_t size_;
   int64_t tell_;
   bool closed_;
-
 };
 
 }
@@ -0,0 +1,138 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "ParquetWrapper.h"
+#include "ColumnType.h"
+
+// write and read throughput of one payload per writer option, reported as MB/s of raw column data,
+// "ratio" is raw size / payload size
+// Args: column type, compression type, dictionary
+
+constexpr int ROWS = 100000;
+constexpr int DIM = 128;
+constexpr int64_t ROW_GROUP_SIZE = 16384;
+
+struct PayloadData {
+  std::vector<float> vectors;
+  std::vector<int64_t> scalars;
+};
+
+static const PayloadData &Data() {
+  static PayloadData data = [] {
+    PayloadData d;
+    std::default_random_engine e(42);
+    std::normal_distribution<float> dist;
+    d.vectors.resize(ROWS * DIM);
+    for (auto &v : d.vectors) v = dist(e);
+    // few distinct values, as in a partition or category field
+    d.scalars.resize(ROWS);
+    for (auto &v : d.scalars) v = e() % 1000;
+    return d;
+  }();
+  return data;
+}
+
+static int64_t RawSize(int column_type) {
+  return column_type == ColumnType::VECTOR_FLOAT ? ROWS * DIM * sizeof(float) : ROWS * sizeof(int64_t);
+}
+
+static std::string Check(CStatus st) {
+  if (st.error_code == ErrorCode::SUCCESS) return "";
+  std::string msg = st.error_msg == nullptr ? "unexpected error" : st.error_msg;
+  free((void *) st.error_msg);
+  return msg;
+}
+
+// returns the payload in out, or an error message
+static std::string WritePayload(int column_type, int compression, bool dictionary, std::vector<uint8_t> &out) {
+  auto writer = NewPayloadWriter(column_type);
+  auto &data = Data();
+  auto msg = Check(SetPayloadWriterRowGroupSize(writer, ROW_GROUP_SIZE));
+  if (msg.empty()) msg = Check(SetPayloadWriterCompression(writer, compression));
+  if (msg.empty()) msg = Check(SetPayloadWriterDictionary(writer, dictionary));
+  if (msg.empty()) {
+    if (column_type == ColumnType::VECTOR_FLOAT) {
+      msg = Check(AddFloatVectorToPayload(writer, const_cast<float *>(data.vectors.data()), DIM, ROWS));
+    } else {
+      msg = Check(AddInt64ToPayload(writer, const_cast<int64_t *>(data.scalars.data()), ROWS));
+    }
+  }
+  if (msg.empty()) msg = Check(FinishPayloadWriter(writer));
+  if (msg.empty()) {
+    auto buf = GetPayloadBufferFromWriter(writer);
+    out.assign(buf.data, buf.data + buf.length);
+  }
+  ReleasePayloadWriter(writer);
+  return msg;
+}
+
+static void
+BN_Payload_Write(benchmark::State &state) {
+  auto column_type = static_cast<int>(state.range(0));
+  auto compression = static_cast<int>(state.range(1));
+  auto dictionary = state.range(2) != 0;
+  std::vector<uint8_t> payload;
+  for (auto _ : state) {
+    auto msg = WritePayload(column_type, compression, dictionary, payload);
+    if (!msg.empty()) {
+      state.SkipWithError(msg.c_str());
+      return;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * RawSize(column_type));
+  state.counters["ratio"] = static_cast<double>(RawSize(column_type)) / payload.size();
+}
+
+static void
+BN_Payload_Read(benchmark::State &state) {
+  auto column_type = static_cast<int>(state.range(0));
+  auto compression = static_cast<int>(state.range(1));
+  auto dictionary = state.range(2) != 0;
+  std::vector<uint8_t> payload;
+  auto msg = WritePayload(column_type, compression, dictionary, payload);
+  if (!msg.empty()) {
+    state.SkipWithError(msg.c_str());
+    return;
+  }
+  std::vector<uint8_t> column(RawSize(column_type));
+  for (auto _ : state) {
+    auto reader = NewPayloadReader(column_type, payload.data(), payload.size());
+    auto num_row_groups = GetPayloadRowGroupCountFromReader(reader);
+    msg = Check(GetRowGroupsFromPayload(reader, 0, num_row_groups, column.data(), column.size(), 1));
+    ReleasePayloadReader(reader);
+    if (!msg.empty()) {
+      state.SkipWithError(msg.c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(column.data());
+  }
+  state.SetBytesProcessed(state.iterations() * RawSize(column_type));
+  state.counters["ratio"] = static_cast<double>(RawSize(column_type)) / payload.size();
+}
+
+static void
+PayloadOptions(benchmark::internal::Benchmark *b) {
+  for (auto compression : {CompressionType::UNCOMPRESSED, CompressionType::LZ4, CompressionType::ZSTD}) {
+    // dictionary doesn't apply to vectors
+    b->Args({ColumnType::VECTOR_FLOAT, compression, 0});
+    for (auto dictionary : {0, 1}) {
+      b->Args({ColumnType::INT64, compression, dictionary});
+    }
+  }
+}
+
+BENCHMARK(BN_Payload_Write)->Apply(PayloadOptions)->Unit(benchmark::kMillisecond);
+BENCHMARK(BN_Payload_Read)->Apply(PayloadOptions)->Unit(benchmark::kMillisecond);
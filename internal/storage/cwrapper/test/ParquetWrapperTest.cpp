@@ -314,3 +314,295 @@ TEST(wrapper, int8_2) {
   ASSERT_EQ(bool_array->Value(2), -100);
   ASSERT_EQ(bool_array->Value(3), 100);
 }
+
+static std::shared_ptr<wrapper::PayloadOutputStream> WriteRowGroups(const std::shared_ptr<arrow::Array> &array,
+                                                                     int64_t row_group_size) {
+  auto schema = arrow::schema({arrow::field("val", array->type())});
+  auto table = arrow::Table::Make(schema, {array});
+  auto os = std::make_shared<wrapper::PayloadOutputStream>();
+  auto st = parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), os, row_group_size);
+  if (!st.ok()) return nullptr;
+  return os;
+}
+
+TEST(wrapper, row_groups_float_vector) {
+  const int dim = 4;
+  const int rows = 1000;
+  std::vector<float> data(rows * dim);
+  for (int i = 0; i < rows * dim; i++) {
+    data[i] = i * 0.5f;
+  }
+  arrow::FixedSizeBinaryBuilder builder(arrow::fixed_size_binary(dim * sizeof(float)));
+  ASSERT_TRUE(builder.AppendValues(reinterpret_cast<const uint8_t *>(data.data()), rows).ok());
+  std::shared_ptr<arrow::Array> array;
+  ASSERT_TRUE(builder.Finish(&array).ok());
+  auto os = WriteRowGroups(array, 100);
+  ASSERT_NE(os, nullptr);
+
+  auto reader = NewPayloadReader(ColumnType::VECTOR_FLOAT, (uint8_t *) os->Buffer().data(), os->Buffer().size());
+  ASSERT_NE(reader, nullptr);
+  ASSERT_EQ(GetPayloadLengthFromReader(reader), rows);
+  ASSERT_EQ(GetPayloadRowGroupCountFromReader(reader), 10);
+  ASSERT_EQ(GetPayloadRowGroupLengthFromReader(reader, 3), 100);
+  ASSERT_EQ(GetPayloadRowGroupLengthFromReader(reader, 10), -1);
+  ASSERT_EQ(GetPayloadRowWidthFromReader(reader), dim * sizeof(float));
+
+  std::vector<float> out(rows * dim, 0);
+  auto st = GetRowGroupsFromPayload(reader, 0, 10, out.data(), out.size() * sizeof(float), 4);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(out, data);
+
+  std::vector<float> part(200 * dim, 0);
+  st = GetRowGroupsFromPayload(reader, 3, 2, part.data(), part.size() * sizeof(float), 1);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  for (int i = 0; i < 200 * dim; i++) {
+    ASSERT_EQ(part[i], data[300 * dim + i]);
+  }
+
+  st = GetRowGroupsFromPayload(reader, 3, 2, part.data(), part.size() * sizeof(float) - 1, 1);
+  ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+  free((void *) st.error_msg);
+  st = GetRowGroupsFromPayload(reader, 9, 2, part.data(), part.size() * sizeof(float), 1);
+  ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+  free((void *) st.error_msg);
+
+  // the whole-payload path concatenates the row groups
+  float *values;
+  int length;
+  int d;
+  st = GetFloatVectorFromPayload(reader, &values, &d, &length);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(d, dim);
+  ASSERT_EQ(length, rows);
+  for (int i = 0; i < rows * dim; i++) {
+    ASSERT_EQ(values[i], data[i]);
+  }
+
+  st = ReleasePayloadReader(reader);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+}
+
+TEST(wrapper, row_groups_int8) {
+  const int rows = 1000;
+  std::vector<int8_t> data(rows);
+  for (int i = 0; i < rows; i++) {
+    data[i] = static_cast<int8_t>(i % 256 - 128);
+  }
+  arrow::Int8Builder builder;
+  ASSERT_TRUE(builder.AppendValues(data).ok());
+  std::shared_ptr<arrow::Array> array;
+  ASSERT_TRUE(builder.Finish(&array).ok());
+  auto os = WriteRowGroups(array, 300);
+  ASSERT_NE(os, nullptr);
+
+  auto reader = NewPayloadReader(ColumnType::INT8, (uint8_t *) os->Buffer().data(), os->Buffer().size());
+  ASSERT_NE(reader, nullptr);
+  ASSERT_EQ(GetPayloadRowGroupCountFromReader(reader), 4);
+  ASSERT_EQ(GetPayloadRowGroupLengthFromReader(reader, 3), 100);
+  ASSERT_EQ(GetPayloadRowWidthFromReader(reader), 1);
+
+  std::vector<int8_t> out(rows, 0);
+  auto st = GetRowGroupsFromPayload(reader, 0, 4, out.data(), out.size(), 3);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(out, data);
+
+  st = ReleasePayloadReader(reader);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+
+  // the column type has to match the payload
+  reader = NewPayloadReader(ColumnType::INT64, (uint8_t *) os->Buffer().data(), os->Buffer().size());
+  ASSERT_NE(reader, nullptr);
+  std::vector<int64_t> wrong(rows, 0);
+  st = GetRowGroupsFromPayload(reader, 0, 4, wrong.data(), wrong.size() * sizeof(int64_t), 1);
+  ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+  free((void *) st.error_msg);
+  st = ReleasePayloadReader(reader);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+}
+
+TEST(wrapper, outstream_chunks) {
+  wrapper::PayloadOutputStream os;
+  std::vector<uint8_t> data(1024 * 1024 + 7);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i * 31);
+  }
+  size_t written = 0;
+  for (size_t n = 1; written < data.size(); n = n * 3 + 1) {
+    auto len = std::min(n, data.size() - written);
+    ASSERT_TRUE(os.Write(data.data() + written, len).ok());
+    written += len;
+    if (n == 1) {
+      ASSERT_EQ(os.Buffer().size(), 1);
+    }
+  }
+  ASSERT_EQ(*os.Tell(), data.size());
+  ASSERT_EQ(os.Buffer(), data);
+}
+
+TEST(wrapper, writer_properties) {
+  const int dim = 8;
+  const int rows = 1000;
+  std::vector<float> data(rows * dim);
+  for (int i = 0; i < rows * dim; i++) {
+    data[i] = i % 17;
+  }
+
+  for (auto compression : {CompressionType::UNCOMPRESSED, CompressionType::LZ4, CompressionType::ZSTD}) {
+    auto payload = NewPayloadWriter(ColumnType::VECTOR_FLOAT);
+    auto st = SetPayloadWriterRowGroupSize(payload, 256);
+    ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+    st = SetPayloadWriterRowGroupSize(payload, 0);
+    ASSERT_EQ(st.error_code, ErrorCode::ILLEGAL_ARGUMENT);
+    free((void *) st.error_msg);
+    st = SetPayloadWriterCompression(payload, compression);
+    if (st.error_code != ErrorCode::SUCCESS) {
+      // codec not built into this arrow
+      free((void *) st.error_msg);
+      ReleasePayloadWriter(payload);
+      continue;
+    }
+    st = AddFloatVectorToPayload(payload, data.data(), dim, rows);
+    ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+    st = FinishPayloadWriter(payload);
+    ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+    st = SetPayloadWriterCompression(payload, CompressionType::UNCOMPRESSED);
+    ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+    free((void *) st.error_msg);
+    auto cb = GetPayloadBufferFromWriter(payload);
+
+    auto reader = NewPayloadReader(ColumnType::VECTOR_FLOAT, (uint8_t *) cb.data, cb.length);
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(GetPayloadRowGroupCountFromReader(reader), 4);
+    std::vector<float> out(rows * dim);
+    st = GetRowGroupsFromPayload(reader, 0, 4, out.data(), out.size() * sizeof(float), 2);
+    ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+    ASSERT_EQ(out, data);
+
+    auto is = std::make_shared<wrapper::PayloadInputStream>((uint8_t *) cb.data, cb.length);
+    auto metadata = parquet::ParquetFileReader::Open(is)->metadata();
+    auto column = metadata->RowGroup(0)->ColumnChunk(0);
+    ASSERT_FALSE(column->has_dictionary_page());
+    ASSERT_FALSE(column->is_stats_set());
+    ASSERT_EQ(column->compression(), compression == CompressionType::UNCOMPRESSED ? parquet::Compression::UNCOMPRESSED
+                                     : compression == CompressionType::LZ4 ? parquet::Compression::LZ4
+                                     : parquet::Compression::ZSTD);
+
+    ReleasePayloadReader(reader);
+    ReleasePayloadWriter(payload);
+  }
+
+  auto payload = NewPayloadWriter(ColumnType::INT64);
+  auto st = SetPayloadWriterCompression(payload, 100);
+  ASSERT_EQ(st.error_code, ErrorCode::ILLEGAL_ARGUMENT);
+  free((void *) st.error_msg);
+  st = SetPayloadWriterDictionary(payload, false);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  int64_t values[] = {1, 1, 1, 2};
+  st = AddInt64ToPayload(payload, values, 4);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  auto cb = GetPayloadBufferFromWriter(payload);
+  auto is = std::make_shared<wrapper::PayloadInputStream>((uint8_t *) cb.data, cb.length);
+  auto metadata = parquet::ParquetFileReader::Open(is)->metadata();
+  ASSERT_FALSE(metadata->RowGroup(0)->ColumnChunk(0)->has_dictionary_page());
+  ReleasePayloadWriter(payload);
+}
+
+TEST(wrapper, statistics) {
+  auto payload = NewPayloadWriter(ColumnType::INT64);
+  std::vector<int64_t> keys(1000);
+  for (int i = 0; i < 1000; i++) {
+    keys[i] = i * 7 - 300;
+  }
+  auto st = SetPayloadWriterRowGroupSize(payload, 300);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = SetPayloadWriterBloomFilter(payload, 0.01);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = AddInt64ToPayload(payload, keys.data(), keys.size());
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  CPayloadStatistics stats;
+  st = GetPayloadStatisticsFromWriter(payload, &stats);
+  ASSERT_NE(st.error_code, ErrorCode::SUCCESS);
+  free((void *) st.error_msg);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+
+  st = GetPayloadStatisticsFromWriter(payload, &stats);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(stats.num_rows, 1000);
+  ASSERT_EQ(stats.null_count, 0);
+  ASSERT_TRUE(stats.has_min_max);
+  ASSERT_EQ(stats.min_int, -300);
+  ASSERT_EQ(stats.max_int, 999 * 7 - 300);
+  ASSERT_TRUE(stats.has_bloom_filter);
+
+  auto cb = GetPayloadBufferFromWriter(payload);
+  auto reader = NewPayloadReader(ColumnType::INT64, (uint8_t *) cb.data, cb.length);
+  ASSERT_NE(reader, nullptr);
+  CPayloadStatistics read_stats;
+  st = GetPayloadStatisticsFromReader(reader, &read_stats);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(read_stats.num_rows, stats.num_rows);
+  ASSERT_EQ(read_stats.min_int, stats.min_int);
+  ASSERT_EQ(read_stats.max_int, stats.max_int);
+
+  std::vector<int64_t> probes(2000);
+  for (int i = 0; i < 2000; i++) {
+    probes[i] = i - 300;
+  }
+  std::unique_ptr<bool[]> may_contain(new bool[probes.size()]);
+  st = PayloadMayContainPrimaryKeys(reader, probes.data(), probes.size(), may_contain.get());
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  int false_positives = 0;
+  for (int i = 0; i < 2000; i++) {
+    if ((probes[i] + 300) % 7 == 0 && probes[i] <= stats.max_int) {
+      ASSERT_TRUE(may_contain[i]);
+    } else if (may_contain[i]) {
+      false_positives++;
+    }
+  }
+  ASSERT_LT(false_positives, 100);
+
+  ReleasePayloadReader(reader);
+  ReleasePayloadWriter(payload);
+
+  payload = NewPayloadWriter(ColumnType::FLOAT);
+  st = SetPayloadWriterBloomFilter(payload, 0.01);
+  ASSERT_EQ(st.error_code, ErrorCode::ILLEGAL_ARGUMENT);
+  free((void *) st.error_msg);
+  float values[] = {1.5, -2.5, 3};
+  st = AddFloatToPayload(payload, values, 3);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  cb = GetPayloadBufferFromWriter(payload);
+  reader = NewPayloadReader(ColumnType::FLOAT, (uint8_t *) cb.data, cb.length);
+  st = GetPayloadStatisticsFromReader(reader, &stats);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_TRUE(stats.has_min_max);
+  ASSERT_FALSE(stats.has_bloom_filter);
+  ASSERT_EQ(stats.min_double, -2.5);
+  ASSERT_EQ(stats.max_double, 3);
+  int64_t key = 42;
+  bool found = false;
+  st = PayloadMayContainPrimaryKeys(reader, &key, 1, &found);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_TRUE(found);
+  ReleasePayloadReader(reader);
+  ReleasePayloadWriter(payload);
+
+  payload = NewPayloadWriter(ColumnType::STRING);
+  st = AddOneStringToPayload(payload, (char *) "a", 1);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = AddOneStringToPayload(payload, nullptr, -1);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = FinishPayloadWriter(payload);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  st = GetPayloadStatisticsFromWriter(payload, &stats);
+  ASSERT_EQ(st.error_code, ErrorCode::SUCCESS);
+  ASSERT_EQ(stats.num_rows, 2);
+  ASSERT_EQ(stats.null_count, 1);
+  ASSERT_FALSE(stats.has_min_max);
+  ReleasePayloadWriter(payload);
+}
@@ -14,7 +14,7 @@ package storage
 /*
 #cgo CFLAGS: -I${SRCDIR}/cwrapper
 
-#cgo LDFLAGS: -L${SRCDIR}/cwrapper/output -lwrapper -lparquet -larrow -lthrift -lutf8proc -lstdc++ -lm
+#cgo LDFLAGS: -L${SRCDIR}/cwrapper/output -lwrapper -lparquet -larrow -lthrift -lutf8proc -llz4 -lzstd -lstdc++ -lm
 #include <stdlib.h>
 #include "ParquetWrapper.h"
 */
@@ -378,6 +378,82 @@ func (w *PayloadWriter) AddFloatVectorToPayload(floatVec []float32, dim int) err
 	return nil
 }
 
+// PayloadCompression is the codec of the payload pages, it matches CompressionType in cwrapper/ColumnType.h
+type PayloadCompression int
+
+const (
+	PayloadUncompressed PayloadCompression = 0
+	PayloadLZ4          PayloadCompression = 1
+	PayloadZSTD         PayloadCompression = 2
+)
+
+func payloadStatusError(st C.CStatus) error {
+	errCode := commonpb.ErrorCode(st.error_code)
+	if errCode != commonpb.ErrorCode_Success {
+		msg := C.GoString(st.error_msg)
+		defer C.free(unsafe.Pointer(st.error_msg))
+		return errors.New(msg)
+	}
+	return nil
+}
+
+// SetRowGroupSize sets the max rows of one row group, must be called before FinishPayloadWriter
+func (w *PayloadWriter) SetRowGroupSize(rows int64) error {
+	return payloadStatusError(C.SetPayloadWriterRowGroupSize(w.payloadWriterPtr, C.int64_t(rows)))
+}
+
+// SetCompression sets the page codec, must be called before FinishPayloadWriter
+func (w *PayloadWriter) SetCompression(compression PayloadCompression) error {
+	return payloadStatusError(C.SetPayloadWriterCompression(w.payloadWriterPtr, C.int(compression)))
+}
+
+// SetDictionary toggles dictionary encoding of scalar columns, vectors are always plain encoded
+func (w *PayloadWriter) SetDictionary(enable bool) error {
+	return payloadStatusError(C.SetPayloadWriterDictionary(w.payloadWriterPtr, C.bool(enable)))
+}
+
+// SetBloomFilter keeps a bloom filter of the int64 primary keys in the payload footer,
+// fpp is the target false positive rate. Must be called before FinishPayloadWriter
+func (w *PayloadWriter) SetBloomFilter(fpp float64) error {
+	return payloadStatusError(C.SetPayloadWriterBloomFilter(w.payloadWriterPtr, C.double(fpp)))
+}
+
+// PayloadStatistics are the column statistics kept in the payload footer
+type PayloadStatistics struct {
+	NumRows   int64
+	NullCount int64 // -1 if unknown
+	// HasMinMax is set for numeric and bool columns with at least one value,
+	// bool and integers use MinInt/MaxInt, float and double use MinDouble/MaxDouble
+	HasMinMax      bool
+	MinInt         int64
+	MaxInt         int64
+	MinDouble      float64
+	MaxDouble      float64
+	HasBloomFilter bool
+}
+
+func newPayloadStatistics(cStats *C.CPayloadStatistics) *PayloadStatistics {
+	return &PayloadStatistics{
+		NumRows:        int64(cStats.num_rows),
+		NullCount:      int64(cStats.null_count),
+		HasMinMax:      bool(cStats.has_min_max),
+		MinInt:         int64(cStats.min_int),
+		MaxInt:         int64(cStats.max_int),
+		MinDouble:      float64(cStats.min_double),
+		MaxDouble:      float64(cStats.max_double),
+		HasBloomFilter: bool(cStats.has_bloom_filter),
+	}
+}
+
+// GetStatistics returns the statistics of the finished payload
+func (w *PayloadWriter) GetStatistics() (*PayloadStatistics, error) {
+	var cStats C.CPayloadStatistics
+	if err := payloadStatusError(C.GetPayloadStatisticsFromWriter(w.payloadWriterPtr, &cStats)); err != nil {
+		return nil, err
+	}
+	return newPayloadStatistics(&cStats), nil
+}
+
 func (w *PayloadWriter) FinishPayloadWriter() error {
 	st := C.FinishPayloadWriter(w.payloadWriterPtr)
 	errCode := commonpb.ErrorCode(st.error_code)
@@ -712,6 +788,69 @@ func (r *PayloadReader) GetPayloadLengthFromReader() (int, error) {
 	return int(length), nil
 }
 
+// GetRowGroupCount returns the number of row groups in the payload, they can be read one by one with ReadRowGroups
+func (r *PayloadReader) GetRowGroupCount() int {
+	return int(C.GetPayloadRowGroupCountFromReader(r.payloadReaderPtr))
+}
+
+// GetRowGroupLength returns the number of rows in a row group
+func (r *PayloadReader) GetRowGroupLength(rowGroup int) (int, error) {
+	length := C.GetPayloadRowGroupLengthFromReader(r.payloadReaderPtr, C.int(rowGroup))
+	if length < 0 {
+		return 0, errors.New("row group out of range")
+	}
+	return int(length), nil
+}
+
+// GetRowWidth returns the bytes one row takes when decoded by ReadRowGroups
+func (r *PayloadReader) GetRowWidth() (int, error) {
+	width := C.GetPayloadRowWidthFromReader(r.payloadReaderPtr)
+	if width <= 0 {
+		return 0, errors.New("incorrect data type")
+	}
+	return int(width), nil
+}
+
+// ReadRowGroups decodes numRowGroups row groups starting at firstRowGroup into buf, back to back,
+// using up to numThreads threads. Unlike the Get*FromPayload methods, the whole payload is never materialized.
+func (r *PayloadReader) ReadRowGroups(firstRowGroup int, numRowGroups int, buf []byte, numThreads int) error {
+	var ptr unsafe.Pointer
+	if len(buf) > 0 {
+		ptr = unsafe.Pointer(&buf[0])
+	}
+	st := C.GetRowGroupsFromPayload(r.payloadReaderPtr, C.int(firstRowGroup), C.int(numRowGroups), ptr, C.int64_t(len(buf)), C.int(numThreads))
+	errCode := commonpb.ErrorCode(st.error_code)
+	if errCode != commonpb.ErrorCode_Success {
+		msg := C.GoString(st.error_msg)
+		defer C.free(unsafe.Pointer(st.error_msg))
+		return errors.New(msg)
+	}
+	return nil
+}
+
+// GetStatistics reads the column statistics from the payload footer without decoding any data
+func (r *PayloadReader) GetStatistics() (*PayloadStatistics, error) {
+	var cStats C.CPayloadStatistics
+	if err := payloadStatusError(C.GetPayloadStatisticsFromReader(r.payloadReaderPtr, &cStats)); err != nil {
+		return nil, err
+	}
+	return newPayloadStatistics(&cStats), nil
+}
+
+// MayContainPrimaryKeys checks keys against the bloom filter in the footer, false means the key is surely absent.
+// All keys may be present if the payload has no bloom filter
+func (r *PayloadReader) MayContainPrimaryKeys(keys []int64) ([]bool, error) {
+	result := make([]bool, len(keys))
+	if len(keys) == 0 {
+		return result, nil
+	}
+	st := C.PayloadMayContainPrimaryKeys(r.payloadReaderPtr, (*C.int64_t)(unsafe.Pointer(&keys[0])), C.int(len(keys)), (*C.bool)(unsafe.Pointer(&result[0])))
+	if err := payloadStatusError(st); err != nil {
+		return nil, err
+	}
+	return result, nil
+}
+
 func (r *PayloadReader) Close() error {
 	return r.ReleasePayloadReader()
 }